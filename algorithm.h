@@ -1,47 +1,30 @@
 #ifndef _TINY_ALGORITHM_H_
 #define _TINY_ALGORITHM_H_
 
+#include <cstring>
+#include <type_traits>
 #include <utility>
+#include "iterator.h"
+#include "functional.h"
+#include "simd.h"
+#include "heap.h"
 
 namespace tinySTL {
-
-    template <class RandomAccessIterator>
-    void swap(RandomAccessIterator first, RandomAccessIterator second) {
-        typename iterator_traits<RandomAccessIterator>::value_type temp = *first;
-        *first = *second;
-        *second = temp;
+    template <class T>
+    typename std::remove_reference<T>::type&& move(T&& t) noexcept {
+        return static_cast<typename std::remove_reference<T>::type&&>(t);
     }
 
-    template <class RandomAccessIterator>
-    RandomAccessIterator partition(RandomAccessIterator first, RandomAccessIterator last) {
-        RandomAccessIterator mid = first + (last - first) / 2;
-        swap(first, mid);
-        RandomAccessIterator i = first + 1;
-        RandomAccessIterator j = last - 1;
-        while (i <= j) {
-            while (i <= j && *i < *first) {
-                ++i;
-            }
-            while (i <= j && *j > *first) {
-                --j;
-            }
-            if (i < j) {
-                swap(i, j);
-                ++i;
-                --j;
-            }
-        }
-        swap(first, j);
-        return j;
+    template <class T>
+    void swap(T& a, T& b) {
+        T tmp = tinySTL::move(a);
+        a = tinySTL::move(b);
+        b = tinySTL::move(tmp);
     }
 
-    template <class RandomAccessIterator>
-    void sort(RandomAccessIterator first, RandomAccessIterator last) {
-        if (first != last) {
-            RandomAccessIterator mid = partition(first, last);
-            sort(first, mid);
-            sort(mid + 1, last);
-        }
+    template <class ForwardIterator1, class ForwardIterator2>
+    inline void iter_swap(ForwardIterator1 a, ForwardIterator2 b) {
+        tinySTL::swap(*a, *b);
     }
 
     template <class InputIterator, class OutputIterator>
@@ -54,6 +37,33 @@ namespace tinySTL {
         return result;
     }
 
+    template <class T>
+    inline T* __copy_t(const T* first, const T* last, T* result, std::true_type) {
+        const ptrdiff_t n = last - first;
+        if (n > 0) {
+            memmove(result, first, sizeof(T) * n);
+        }
+        return result + n;
+    }
+
+    template <class T>
+    inline T* __copy_t(const T* first, const T* last, T* result, std::false_type) {
+        for (ptrdiff_t n = last - first; n > 0; --n, ++result, ++first) {
+            *result = *first;
+        }
+        return result;
+    }
+
+    template <class T>
+    inline T* copy(const T* first, const T* last, T* result) {
+        return tinySTL::__copy_t(first, last, result, std::is_trivially_copyable<T>());
+    }
+
+    template <class T>
+    inline T* copy(T* first, T* last, T* result) {
+        return tinySTL::__copy_t(static_cast<const T*>(first), static_cast<const T*>(last), result, std::is_trivially_copyable<T>());
+    }
+
     template <class BidirectionalIterator1, class BidirectionalIterator2>
     BidirectionalIterator2 copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result) {
         while (first != last) {
@@ -65,13 +75,1841 @@ namespace tinySTL {
     }
 
     template <class T>
-    typename std::remove_reference<T>::type&& move(T&& t) noexcept {
-        return static_cast<typename std::remove_reference<T>::type&&>(t);
+    inline T* __copy_backward_t(const T* first, const T* last, T* result, std::true_type) {
+        const ptrdiff_t n = last - first;
+        if (n > 0) {
+            memmove(result - n, first, sizeof(T) * n);
+        }
+        return result - n;
     }
 
     template <class T>
-    const T& max(const T& a, const T& b) {
-        return a < b ? b : a;
+    inline T* __copy_backward_t(const T* first, const T* last, T* result, std::false_type) {
+        for (ptrdiff_t n = last - first; n > 0; --n) {
+            *--result = *--last;
+        }
+        return result;
+    }
+
+    template <class T>
+    inline T* copy_backward(const T* first, const T* last, T* result) {
+        return tinySTL::__copy_backward_t(first, last, result, std::is_trivially_copyable<T>());
+    }
+
+    template <class T>
+    inline T* copy_backward(T* first, T* last, T* result) {
+        return tinySTL::__copy_backward_t(static_cast<const T*>(first), static_cast<const T*>(last), result, std::is_trivially_copyable<T>());
+    }
+
+    template <class InputIterator, class OutputIterator>
+    OutputIterator move(InputIterator first, InputIterator last, OutputIterator result) {
+        while (first != last) {
+            *result = tinySTL::move(*first);
+            ++result;
+            ++first;
+        }
+        return result;
+    }
+
+    template <class T>
+    inline T* __move_t(T* first, T* last, T* result, std::true_type) {
+        return tinySTL::__copy_t(static_cast<const T*>(first), static_cast<const T*>(last), result, std::true_type());
+    }
+
+    template <class T>
+    inline T* __move_t(T* first, T* last, T* result, std::false_type) {
+        for (ptrdiff_t n = last - first; n > 0; --n, ++result, ++first) {
+            *result = tinySTL::move(*first);
+        }
+        return result;
+    }
+
+    template <class T>
+    inline T* move(T* first, T* last, T* result) {
+        return tinySTL::__move_t(first, last, result, std::is_trivially_copyable<T>());
+    }
+
+    template <class BidirectionalIterator1, class BidirectionalIterator2>
+    BidirectionalIterator2 move_backward(BidirectionalIterator1 first, BidirectionalIterator1 last, BidirectionalIterator2 result) {
+        while (first != last) {
+            --last;
+            --result;
+            *result = tinySTL::move(*last);
+        }
+        return result;
+    }
+
+    template <class T>
+    inline T* __move_backward_t(T* first, T* last, T* result, std::true_type) {
+        return tinySTL::__copy_backward_t(static_cast<const T*>(first), static_cast<const T*>(last), result, std::true_type());
+    }
+
+    template <class T>
+    inline T* __move_backward_t(T* first, T* last, T* result, std::false_type) {
+        for (ptrdiff_t n = last - first; n > 0; --n) {
+            *--result = tinySTL::move(*--last);
+        }
+        return result;
+    }
+
+    template <class T>
+    inline T* move_backward(T* first, T* last, T* result) {
+        return tinySTL::__move_backward_t(first, last, result, std::is_trivially_copyable<T>());
+    }
+
+    template <class ForwardIterator, class T>
+    void fill(ForwardIterator first, ForwardIterator last, const T& value) {
+        for (; first != last; ++first) {
+            *first = value;
+        }
+    }
+
+    // Scalars can be filled with memset when they are one byte wide, or when
+    // the fill value is all zero bits.
+    template <class T>
+    struct __fill_memset_eligible : std::integral_constant<bool,
+        std::is_scalar<T>::value && !std::is_volatile<T>::value> {};
+
+    template <class T, class U>
+    void __fill_t(T* first, T* last, const U& value, std::true_type) {
+        const T x = value;
+        const size_t n = size_t(last - first);
+        if (n == 0) {
+            return;
+        }
+        unsigned char bytes[sizeof(T)];
+        memcpy(bytes, &x, sizeof(T));
+        if (sizeof(T) == 1) {
+            memset(first, bytes[0], n);
+            return;
+        }
+        bool zero = true;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            zero = zero && bytes[i] == 0;
+        }
+        if (zero) {
+            memset(first, 0, n * sizeof(T));
+            return;
+        }
+        for (; first != last; ++first) {
+            *first = x;
+        }
+    }
+
+    template <class T, class U>
+    inline void __fill_t(T* first, T* last, const U& value, std::false_type) {
+        for (; first != last; ++first) {
+            *first = value;
+        }
+    }
+
+    template <class T, class U>
+    inline void fill(T* first, T* last, const U& value) {
+        tinySTL::__fill_t(first, last, value, __fill_memset_eligible<T>());
+    }
+
+    template <class OutputIterator, class Size, class T>
+    OutputIterator fill_n(OutputIterator first, Size n, const T& value) {
+        for (; n > 0; --n, ++first) {
+            *first = value;
+        }
+        return first;
+    }
+
+    template <class T, class Size, class U>
+    inline T* fill_n(T* first, Size n, const U& value) {
+        if (n <= 0) {
+            return first;
+        }
+        tinySTL::fill(first, first + n, value);
+        return first + n;
+    }
+
+    template <class InputIterator, class Function>
+    Function for_each(InputIterator first, InputIterator last, Function f) {
+        for (; first != last; ++first) {
+            f(*first);
+        }
+        return f;
+    }
+
+    template <class InputIterator, class T>
+    InputIterator find(InputIterator first, InputIterator last, const T& value) {
+        while (first != last && !(*first == value)) {
+            ++first;
+        }
+        return first;
+    }
+
+    template <class T>
+    inline const T* __find_t(const T* first, const T* last, const T& value, std::true_type) {
+        return tinySTL::__simd_find(first, last, value);
+    }
+
+    template <class T>
+    inline const T* __find_t(const T* first, const T* last, const T& value, std::false_type) {
+        while (first != last && !(*first == value)) {
+            ++first;
+        }
+        return first;
+    }
+
+    template <class T>
+    inline const T* find(const T* first, const T* last, const T& value) {
+        return tinySTL::__find_t(first, last, value, __simd_eligible<T>());
+    }
+
+    template <class T>
+    inline T* find(T* first, T* last, const T& value) {
+        return const_cast<T*>(tinySTL::__find_t((const T*)first, (const T*)last, value, __simd_eligible<T>()));
+    }
+
+    template <class InputIterator, class T>
+    typename iterator_traits<InputIterator>::difference_type
+    count(InputIterator first, InputIterator last, const T& value) {
+        typename iterator_traits<InputIterator>::difference_type n = 0;
+        for (; first != last; ++first) {
+            if (*first == value) {
+                ++n;
+            }
+        }
+        return n;
+    }
+
+    template <class T>
+    inline ptrdiff_t __count_t(const T* first, const T* last, const T& value, std::true_type) {
+        return ptrdiff_t(tinySTL::__simd_count(first, last, value));
+    }
+
+    template <class T>
+    inline ptrdiff_t __count_t(const T* first, const T* last, const T& value, std::false_type) {
+        ptrdiff_t n = 0;
+        for (; first != last; ++first) {
+            if (*first == value) {
+                ++n;
+            }
+        }
+        return n;
+    }
+
+    template <class T>
+    inline ptrdiff_t count(const T* first, const T* last, const T& value) {
+        return tinySTL::__count_t(first, last, value, __simd_eligible<T>());
+    }
+
+    template <class T>
+    inline ptrdiff_t count(T* first, T* last, const T& value) {
+        return tinySTL::__count_t((const T*)first, (const T*)last, value, __simd_eligible<T>());
+    }
+
+    template <class ForwardIterator, class Compare>
+    ForwardIterator min_element(ForwardIterator first, ForwardIterator last, Compare comp) {
+        if (first == last) {
+            return last;
+        }
+        ForwardIterator result = first;
+        while (++first != last) {
+            if (comp(*first, *result)) {
+                result = first;
+            }
+        }
+        return result;
+    }
+
+    template <class ForwardIterator, class Compare>
+    ForwardIterator max_element(ForwardIterator first, ForwardIterator last, Compare comp) {
+        if (first == last) {
+            return last;
+        }
+        ForwardIterator result = first;
+        while (++first != last) {
+            if (comp(*result, *first)) {
+                result = first;
+            }
+        }
+        return result;
+    }
+
+    template <class ForwardIterator>
+    inline ForwardIterator min_element(ForwardIterator first, ForwardIterator last) {
+        typedef typename iterator_traits<ForwardIterator>::value_type T;
+        return tinySTL::min_element(first, last, less<T>());
+    }
+
+    template <class ForwardIterator>
+    inline ForwardIterator max_element(ForwardIterator first, ForwardIterator last) {
+        typedef typename iterator_traits<ForwardIterator>::value_type T;
+        return tinySTL::max_element(first, last, less<T>());
+    }
+
+    template <class T>
+    inline const T* __min_element_t(const T* first, const T* last, std::true_type) {
+        return tinySTL::__simd_min_element(first, last);
+    }
+
+    template <class T>
+    inline const T* __min_element_t(const T* first, const T* last, std::false_type) {
+        return tinySTL::min_element(first, last, less<T>());
+    }
+
+    template <class T>
+    inline const T* __max_element_t(const T* first, const T* last, std::true_type) {
+        return tinySTL::__simd_max_element(first, last);
+    }
+
+    template <class T>
+    inline const T* __max_element_t(const T* first, const T* last, std::false_type) {
+        return tinySTL::max_element(first, last, less<T>());
+    }
+
+    template <class T>
+    inline const T* min_element(const T* first, const T* last) {
+        return tinySTL::__min_element_t(first, last, __simd_integral_eligible<T>());
+    }
+
+    template <class T>
+    inline T* min_element(T* first, T* last) {
+        return const_cast<T*>(tinySTL::__min_element_t((const T*)first, (const T*)last, __simd_integral_eligible<T>()));
+    }
+
+    template <class T>
+    inline const T* max_element(const T* first, const T* last) {
+        return tinySTL::__max_element_t(first, last, __simd_integral_eligible<T>());
+    }
+
+    template <class T>
+    inline T* max_element(T* first, T* last) {
+        return const_cast<T*>(tinySTL::__max_element_t((const T*)first, (const T*)last, __simd_integral_eligible<T>()));
+    }
+
+    template <class InputIterator1, class InputIterator2, class BinaryPredicate>
+    std::pair<InputIterator1, InputIterator2>
+    mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred) {
+        while (first1 != last1 && pred(*first1, *first2)) {
+            ++first1;
+            ++first2;
+        }
+        return std::pair<InputIterator1, InputIterator2>(first1, first2);
+    }
+
+    template <class InputIterator1, class InputIterator2>
+    std::pair<InputIterator1, InputIterator2>
+    mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
+        while (first1 != last1 && *first1 == *first2) {
+            ++first1;
+            ++first2;
+        }
+        return std::pair<InputIterator1, InputIterator2>(first1, first2);
+    }
+
+    template <class T>
+    inline size_t __mismatch_t(const T* first1, const T* last1, const T* first2, std::true_type) {
+        return tinySTL::__simd_mismatch(first1, size_t(last1 - first1), first2);
+    }
+
+    template <class T>
+    inline size_t __mismatch_t(const T* first1, const T* last1, const T* first2, std::false_type) {
+        const T* p = first1;
+        while (p != last1 && *p == *first2) {
+            ++p;
+            ++first2;
+        }
+        return size_t(p - first1);
+    }
+
+    template <class T>
+    inline std::pair<const T*, const T*> mismatch(const T* first1, const T* last1, const T* first2) {
+        const size_t i = tinySTL::__mismatch_t(first1, last1, first2, __simd_eligible<T>());
+        return std::pair<const T*, const T*>(first1 + i, first2 + i);
+    }
+
+    template <class T>
+    inline std::pair<T*, T*> mismatch(T* first1, T* last1, T* first2) {
+        const size_t i = tinySTL::__mismatch_t((const T*)first1, (const T*)last1, (const T*)first2, __simd_eligible<T>());
+        return std::pair<T*, T*>(first1 + i, first2 + i);
+    }
+
+    template <class InputIterator1, class InputIterator2, class BinaryPredicate>
+    inline bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred) {
+        return tinySTL::mismatch(first1, last1, first2, pred).first == last1;
+    }
+
+    template <class InputIterator1, class InputIterator2>
+    inline bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {
+        return tinySTL::mismatch(first1, last1, first2).first == last1;
+    }
+
+    template <class InputIterator, class T>
+    T accumulate(InputIterator first, InputIterator last, T init) {
+        for (; first != last; ++first) {
+            init = init + *first;
+        }
+        return init;
+    }
+
+    template <class T>
+    inline T __accumulate_t(const T* first, const T* last, T init, std::true_type) {
+        return tinySTL::__simd_accumulate(first, last, init);
+    }
+
+    template <class T>
+    inline T __accumulate_t(const T* first, const T* last, T init, std::false_type) {
+        for (; first != last; ++first) {
+            init = init + *first;
+        }
+        return init;
+    }
+
+    template <class T>
+    inline T accumulate(const T* first, const T* last, T init) {
+        return tinySTL::__accumulate_t(first, last, init, __simd_integral_eligible<T>());
+    }
+
+    template <class T>
+    inline T accumulate(T* first, T* last, T init) {
+        return tinySTL::__accumulate_t((const T*)first, (const T*)last, init, __simd_integral_eligible<T>());
+    }
+
+    template <class InputIterator, class T, class BinaryOperation>
+    T reduce(InputIterator first, InputIterator last, T init, BinaryOperation op) {
+        for (; first != last; ++first) {
+            init = op(tinySTL::move(init), *first);
+        }
+        return init;
+    }
+
+    template <class InputIterator, class T>
+    inline T reduce(InputIterator first, InputIterator last, T init) {
+        return tinySTL::reduce(first, last, tinySTL::move(init), plus<T>());
+    }
+
+    template <class InputIterator>
+    inline typename iterator_traits<InputIterator>::value_type reduce(InputIterator first, InputIterator last) {
+        typedef typename iterator_traits<InputIterator>::value_type T;
+        return tinySTL::reduce(first, last, T(), plus<T>());
+    }
+
+    template <class InputIterator, class OutputIterator, class UnaryOperation>
+    OutputIterator transform(InputIterator first, InputIterator last, OutputIterator result, UnaryOperation op) {
+        for (; first != last; ++first, ++result) {
+            *result = op(*first);
+        }
+        return result;
+    }
+
+    template <class InputIterator1, class InputIterator2, class OutputIterator, class BinaryOperation>
+    OutputIterator transform(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2,
+                             OutputIterator result, BinaryOperation op) {
+        for (; first1 != last1; ++first1, ++first2, ++result) {
+            *result = op(*first1, *first2);
+        }
+        return result;
+    }
+
+    template <class InputIterator, class Predicate>
+    typename iterator_traits<InputIterator>::difference_type
+    count_if(InputIterator first, InputIterator last, Predicate pred) {
+        typename iterator_traits<InputIterator>::difference_type n = 0;
+        for (; first != last; ++first) {
+            if (pred(*first)) {
+                ++n;
+            }
+        }
+        return n;
+    }
+
+    template <class InputIterator, class OutputIterator, class BinaryOperation, class T>
+    OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                  BinaryOperation op, T init) {
+        for (; first != last; ++first, ++result) {
+            init = op(tinySTL::move(init), *first);
+            *result = init;
+        }
+        return result;
+    }
+
+    template <class InputIterator, class OutputIterator, class BinaryOperation>
+    OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result, BinaryOperation op) {
+        if (first == last) {
+            return result;
+        }
+        typename iterator_traits<InputIterator>::value_type sum = *first;
+        *result = sum;
+        return tinySTL::inclusive_scan(++first, last, ++result, op, tinySTL::move(sum));
+    }
+
+    template <class InputIterator, class OutputIterator>
+    inline OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result) {
+        typedef typename iterator_traits<InputIterator>::value_type T;
+        return tinySTL::inclusive_scan(first, last, result, plus<T>());
+    }
+
+    template <class InputIterator, class OutputIterator, class T, class BinaryOperation>
+    OutputIterator exclusive_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                  T init, BinaryOperation op) {
+        for (; first != last; ++first, ++result) {
+            T next = op(init, *first);
+            *result = tinySTL::move(init);
+            init = tinySTL::move(next);
+        }
+        return result;
+    }
+
+    template <class InputIterator, class OutputIterator, class T>
+    inline OutputIterator exclusive_scan(InputIterator first, InputIterator last, OutputIterator result, T init) {
+        return tinySTL::exclusive_scan(first, last, result, tinySTL::move(init), plus<T>());
+    }
+
+    template <class T>
+    const T& max(const T& a, const T& b) {
+        return a < b ? b : a;
+    }
+
+    template <class T>
+    const T& min(const T& a, const T& b) {
+        return b < a ? b : a;
+    }
+
+    template <class BidirectionalIterator>
+    void reverse(BidirectionalIterator first, BidirectionalIterator last) {
+        while (first != last && first != --last) {
+            tinySTL::iter_swap(first, last);
+            ++first;
+        }
+    }
+
+    // Swaps [first, middle) and [middle, last) by trading elements block by
+    // block; returns the new position of *first.
+    template <class ForwardIterator>
+    ForwardIterator rotate(ForwardIterator first, ForwardIterator middle, ForwardIterator last) {
+        if (first == middle) {
+            return last;
+        }
+        if (middle == last) {
+            return first;
+        }
+        ForwardIterator next = middle;
+        do {
+            tinySTL::iter_swap(first++, next++);
+            if (first == middle) {
+                middle = next;
+            }
+        } while (next != last);
+        const ForwardIterator result = first;
+        next = middle;
+        while (next != last) {
+            tinySTL::iter_swap(first++, next++);
+            if (first == middle) {
+                middle = next;
+            }
+            else if (next == last) {
+                next = middle;
+            }
+        }
+        return result;
+    }
+
+    template <class ForwardIterator, class BinaryPredicate>
+    ForwardIterator unique(ForwardIterator first, ForwardIterator last, BinaryPredicate pred) {
+        if (first == last) {
+            return last;
+        }
+        ForwardIterator result = first;
+        while (++first != last) {
+            if (!pred(*result, *first) && ++result != first) {
+                *result = tinySTL::move(*first);
+            }
+        }
+        return ++result;
+    }
+
+    template <class ForwardIterator>
+    inline ForwardIterator unique(ForwardIterator first, ForwardIterator last) {
+        typedef typename iterator_traits<ForwardIterator>::value_type T;
+        return tinySTL::unique(first, last, equal_to<T>());
+    }
+
+    // Compares an element with a probe of a possibly different type using operator<.
+    struct __less_value {
+        template <class T1, class T2>
+        bool operator()(const T1& x, const T2& y) const { return x < y; }
+    };
+
+    template <class ForwardIterator, class T, class Compare>
+    ForwardIterator __lower_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp,
+                                  forward_iterator_tag) {
+        typedef typename iterator_traits<ForwardIterator>::difference_type Distance;
+        Distance len = tinySTL::distance(first, last);
+        while (len > 0) {
+            const Distance half = len / 2;
+            ForwardIterator middle = first;
+            tinySTL::advance(middle, half);
+            if (comp(*middle, value)) {
+                first = ++middle;
+                len -= half + 1;
+            }
+            else {
+                len = half;
+            }
+        }
+        return first;
+    }
+
+    // The search window halves every step whatever the comparison says, so the
+    // loop has a fixed trip count and the comparison only selects the next base,
+    // which compiles to a conditional move instead of a mispredicted branch.
+    template <class RandomAccessIterator, class T, class Compare>
+    RandomAccessIterator __lower_bound(RandomAccessIterator first, RandomAccessIterator last, const T& value,
+                                       Compare comp, random_access_iterator_tag) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        Distance len = last - first;
+        if (len == 0) {
+            return first;
+        }
+        while (len > 1) {
+            const Distance half = len / 2;
+            first += comp(*(first + half), value) ? half : 0;
+            len -= half;
+        }
+        return first + Distance(comp(*first, value));
+    }
+
+    template <class ForwardIterator, class T, class Compare>
+    ForwardIterator __upper_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp,
+                                  forward_iterator_tag) {
+        typedef typename iterator_traits<ForwardIterator>::difference_type Distance;
+        Distance len = tinySTL::distance(first, last);
+        while (len > 0) {
+            const Distance half = len / 2;
+            ForwardIterator middle = first;
+            tinySTL::advance(middle, half);
+            if (!comp(value, *middle)) {
+                first = ++middle;
+                len -= half + 1;
+            }
+            else {
+                len = half;
+            }
+        }
+        return first;
+    }
+
+    template <class RandomAccessIterator, class T, class Compare>
+    RandomAccessIterator __upper_bound(RandomAccessIterator first, RandomAccessIterator last, const T& value,
+                                       Compare comp, random_access_iterator_tag) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        Distance len = last - first;
+        if (len == 0) {
+            return first;
+        }
+        while (len > 1) {
+            const Distance half = len / 2;
+            first += comp(value, *(first + half)) ? 0 : half;
+            len -= half;
+        }
+        return first + Distance(!comp(value, *first));
+    }
+
+    template <class ForwardIterator, class T, class Compare>
+    inline ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp) {
+        return tinySTL::__lower_bound(first, last, value, comp, tinySTL::iterator_category(first));
+    }
+
+    template <class ForwardIterator, class T>
+    inline ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last, const T& value) {
+        return tinySTL::__lower_bound(first, last, value, __less_value(), tinySTL::iterator_category(first));
+    }
+
+    template <class ForwardIterator, class T, class Compare>
+    inline ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare comp) {
+        return tinySTL::__upper_bound(first, last, value, comp, tinySTL::iterator_category(first));
+    }
+
+    template <class ForwardIterator, class T>
+    inline ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last, const T& value) {
+        return tinySTL::__upper_bound(first, last, value, __less_value(), tinySTL::iterator_category(first));
+    }
+
+    template <class ForwardIterator, class T, class Compare>
+    inline std::pair<ForwardIterator, ForwardIterator>
+    equal_range(ForwardIterator first, ForwardIterator last, const T& value, Compare comp) {
+        ForwardIterator lower = tinySTL::lower_bound(first, last, value, comp);
+        return std::pair<ForwardIterator, ForwardIterator>(lower, tinySTL::upper_bound(lower, last, value, comp));
+    }
+
+    template <class ForwardIterator, class T>
+    inline std::pair<ForwardIterator, ForwardIterator>
+    equal_range(ForwardIterator first, ForwardIterator last, const T& value) {
+        return tinySTL::equal_range(first, last, value, __less_value());
+    }
+
+    template <class ForwardIterator, class T, class Compare>
+    inline bool binary_search(ForwardIterator first, ForwardIterator last, const T& value, Compare comp) {
+        first = tinySTL::lower_bound(first, last, value, comp);
+        return first != last && !comp(value, *first);
+    }
+
+    template <class ForwardIterator, class T>
+    inline bool binary_search(ForwardIterator first, ForwardIterator last, const T& value) {
+        return tinySTL::binary_search(first, last, value, __less_value());
+    }
+
+    enum {
+        __sort_insertion_threshold = 24,
+        __sort_ninther_threshold = 128,
+        __sort_partial_insertion_limit = 8,
+        __sort_block_size = 64,
+        __sort_cacheline_size = 64
+    };
+
+    template <class RandomAccessIterator, class Compare>
+    void __insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        if (first == last) {
+            return;
+        }
+        for (RandomAccessIterator cur = first + 1; cur != last; ++cur) {
+            RandomAccessIterator sift = cur;
+            RandomAccessIterator sift_1 = cur - 1;
+            if (comp(*sift, *sift_1)) {
+                T tmp = tinySTL::move(*sift);
+                do {
+                    *sift-- = tinySTL::move(*sift_1);
+                } while (sift != first && comp(tmp, *--sift_1));
+                *sift = tinySTL::move(tmp);
+            }
+        }
+    }
+
+    // Requires *(first - 1) to compare no greater than any element of [first, last).
+    template <class RandomAccessIterator, class Compare>
+    void __unguarded_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        if (first == last) {
+            return;
+        }
+        for (RandomAccessIterator cur = first + 1; cur != last; ++cur) {
+            RandomAccessIterator sift = cur;
+            RandomAccessIterator sift_1 = cur - 1;
+            if (comp(*sift, *sift_1)) {
+                T tmp = tinySTL::move(*sift);
+                do {
+                    *sift-- = tinySTL::move(*sift_1);
+                } while (comp(tmp, *--sift_1));
+                *sift = tinySTL::move(tmp);
+            }
+        }
+    }
+
+    // Insertion sort that gives up once it has moved more than a few elements;
+    // returns true if [first, last) ended up sorted.
+    template <class RandomAccessIterator, class Compare>
+    bool __partial_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        if (first == last) {
+            return true;
+        }
+        size_t moved = 0;
+        for (RandomAccessIterator cur = first + 1; cur != last; ++cur) {
+            RandomAccessIterator sift = cur;
+            RandomAccessIterator sift_1 = cur - 1;
+            if (comp(*sift, *sift_1)) {
+                T tmp = tinySTL::move(*sift);
+                do {
+                    *sift-- = tinySTL::move(*sift_1);
+                } while (sift != first && comp(tmp, *--sift_1));
+                *sift = tinySTL::move(tmp);
+                moved += cur - sift;
+            }
+            if (moved > __sort_partial_insertion_limit) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    inline void __sort2(RandomAccessIterator a, RandomAccessIterator b, Compare comp) {
+        if (comp(*b, *a)) {
+            tinySTL::iter_swap(a, b);
+        }
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    inline void __sort3(RandomAccessIterator a, RandomAccessIterator b, RandomAccessIterator c, Compare comp) {
+        tinySTL::__sort2(a, b, comp);
+        tinySTL::__sort2(b, c, comp);
+        tinySTL::__sort2(a, b, comp);
+    }
+
+    // Partitions [first, last) around *first; elements equal to the pivot go right.
+    // Returns the pivot position and whether the range was already partitioned.
+    template <class RandomAccessIterator, class Compare>
+    std::pair<RandomAccessIterator, bool>
+    __partition_right(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        const RandomAccessIterator begin = first;
+        T pivot = tinySTL::move(*begin);
+        while (comp(*++first, pivot));
+        if (first - 1 == begin) {
+            while (first < last && !comp(*--last, pivot));
+        }
+        else {
+            while (!comp(*--last, pivot));
+        }
+        const bool already_partitioned = first >= last;
+        while (first < last) {
+            tinySTL::iter_swap(first, last);
+            while (comp(*++first, pivot));
+            while (!comp(*--last, pivot));
+        }
+        RandomAccessIterator pivot_pos = first - 1;
+        *begin = tinySTL::move(*pivot_pos);
+        *pivot_pos = tinySTL::move(pivot);
+        return std::pair<RandomAccessIterator, bool>(pivot_pos, already_partitioned);
+    }
+
+    template <class RandomAccessIterator>
+    inline void __swap_offsets(RandomAccessIterator first, RandomAccessIterator last,
+                               const unsigned char* offsets_l, const unsigned char* offsets_r,
+                               size_t num, bool use_swaps) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        if (use_swaps) {
+            for (size_t i = 0; i < num; ++i) {
+                tinySTL::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+            }
+        }
+        else if (num > 0) {
+            RandomAccessIterator l = first + offsets_l[0];
+            RandomAccessIterator r = last - offsets_r[0];
+            T tmp = tinySTL::move(*l);
+            *l = tinySTL::move(*r);
+            for (size_t i = 1; i < num; ++i) {
+                l = first + offsets_l[i];
+                *r = tinySTL::move(*l);
+                r = last - offsets_r[i];
+                *l = tinySTL::move(*r);
+            }
+            *r = tinySTL::move(tmp);
+        }
+    }
+
+    // Same contract as __partition_right, but classifies a block of elements at a
+    // time into offset buffers so the comparisons carry no data-dependent branch.
+    template <class RandomAccessIterator, class Compare>
+    std::pair<RandomAccessIterator, bool>
+    __partition_right_branchless(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        const RandomAccessIterator begin = first;
+        T pivot = tinySTL::move(*begin);
+        while (comp(*++first, pivot));
+        if (first - 1 == begin) {
+            while (first < last && !comp(*--last, pivot));
+        }
+        else {
+            while (!comp(*--last, pivot));
+        }
+        const bool already_partitioned = first >= last;
+        if (!already_partitioned) {
+            tinySTL::iter_swap(first, last);
+            ++first;
+
+            alignas(__sort_cacheline_size) unsigned char offsets_l[__sort_block_size];
+            alignas(__sort_cacheline_size) unsigned char offsets_r[__sort_block_size];
+            RandomAccessIterator offsets_l_base = first;
+            RandomAccessIterator offsets_r_base = last;
+            size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+            while (first < last) {
+                const size_t num_unknown = last - first;
+                const size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+                const size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+                const size_t left_count = tinySTL::min(left_split, size_t(__sort_block_size));
+                for (size_t i = 0; i < left_count; ++i) {
+                    offsets_l[num_l] = static_cast<unsigned char>(i);
+                    num_l += !comp(*first, pivot);
+                    ++first;
+                }
+                const size_t right_count = tinySTL::min(right_split, size_t(__sort_block_size));
+                for (size_t i = 0; i < right_count; ++i) {
+                    offsets_r[num_r] = static_cast<unsigned char>(i + 1);
+                    num_r += comp(*--last, pivot);
+                }
+
+                const size_t num = tinySTL::min(num_l, num_r);
+                tinySTL::__swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r,
+                               num, num_l == num_r);
+                num_l -= num;
+                num_r -= num;
+                start_l += num;
+                start_r += num;
+                if (num_l == 0) {
+                    start_l = 0;
+                    offsets_l_base = first;
+                }
+                if (num_r == 0) {
+                    start_r = 0;
+                    offsets_r_base = last;
+                }
+            }
+
+            if (num_l) {
+                const unsigned char* offs = offsets_l + start_l;
+                while (num_l--) {
+                    tinySTL::iter_swap(offsets_l_base + offs[num_l], --last);
+                }
+                first = last;
+            }
+            if (num_r) {
+                const unsigned char* offs = offsets_r + start_r;
+                while (num_r--) {
+                    tinySTL::iter_swap(offsets_r_base - offs[num_r], first);
+                    ++first;
+                }
+                last = first;
+            }
+        }
+        RandomAccessIterator pivot_pos = first - 1;
+        *begin = tinySTL::move(*pivot_pos);
+        *pivot_pos = tinySTL::move(pivot);
+        return std::pair<RandomAccessIterator, bool>(pivot_pos, already_partitioned);
+    }
+
+    // Partitions around *first with elements equal to the pivot going left.
+    // Used when the pivot equals the element before the range, i.e. many duplicates.
+    template <class RandomAccessIterator, class Compare>
+    RandomAccessIterator __partition_left(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        const RandomAccessIterator begin = first;
+        const RandomAccessIterator end = last;
+        T pivot = tinySTL::move(*begin);
+        while (comp(pivot, *--last));
+        if (last + 1 == end) {
+            while (first < last && !comp(pivot, *++first));
+        }
+        else {
+            while (!comp(pivot, *++first));
+        }
+        while (first < last) {
+            tinySTL::iter_swap(first, last);
+            while (comp(pivot, *--last));
+            while (!comp(pivot, *++first));
+        }
+        *begin = tinySTL::move(*last);
+        *last = tinySTL::move(pivot);
+        return last;
+    }
+
+    template <bool Branchless, class RandomAccessIterator, class Compare>
+    void __pdq_sort_loop(RandomAccessIterator first, RandomAccessIterator last, Compare comp,
+                         int bad_allowed, bool leftmost) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        while (true) {
+            const Distance size = last - first;
+            if (size < __sort_insertion_threshold) {
+                if (leftmost) {
+                    tinySTL::__insertion_sort(first, last, comp);
+                }
+                else {
+                    tinySTL::__unguarded_insertion_sort(first, last, comp);
+                }
+                return;
+            }
+
+            const Distance s2 = size / 2;
+            if (size > __sort_ninther_threshold) {
+                tinySTL::__sort3(first, first + s2, last - 1, comp);
+                tinySTL::__sort3(first + 1, first + (s2 - 1), last - 2, comp);
+                tinySTL::__sort3(first + 2, first + (s2 + 1), last - 3, comp);
+                tinySTL::__sort3(first + (s2 - 1), first + s2, first + (s2 + 1), comp);
+                tinySTL::iter_swap(first, first + s2);
+            }
+            else {
+                tinySTL::__sort3(first + s2, first, last - 1, comp);
+            }
+
+            if (!leftmost && !comp(*(first - 1), *first)) {
+                first = tinySTL::__partition_left(first, last, comp) + 1;
+                continue;
+            }
+
+            std::pair<RandomAccessIterator, bool> part = Branchless
+                ? tinySTL::__partition_right_branchless(first, last, comp)
+                : tinySTL::__partition_right(first, last, comp);
+            const RandomAccessIterator pivot_pos = part.first;
+            const Distance l_size = pivot_pos - first;
+            const Distance r_size = last - (pivot_pos + 1);
+
+            if (l_size < size / 8 || r_size < size / 8) {
+                if (--bad_allowed == 0) {
+                    tinySTL::make_heap(first, last, comp);
+                    tinySTL::sort_heap(first, last, comp);
+                    return;
+                }
+                if (l_size >= __sort_insertion_threshold) {
+                    tinySTL::iter_swap(first, first + l_size / 4);
+                    tinySTL::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                    if (l_size > __sort_ninther_threshold) {
+                        tinySTL::iter_swap(first + 1, first + (l_size / 4 + 1));
+                        tinySTL::iter_swap(first + 2, first + (l_size / 4 + 2));
+                        tinySTL::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                        tinySTL::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                    }
+                }
+                if (r_size >= __sort_insertion_threshold) {
+                    tinySTL::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                    tinySTL::iter_swap(last - 1, last - r_size / 4);
+                    if (r_size > __sort_ninther_threshold) {
+                        tinySTL::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                        tinySTL::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                        tinySTL::iter_swap(last - 2, last - (1 + r_size / 4));
+                        tinySTL::iter_swap(last - 3, last - (2 + r_size / 4));
+                    }
+                }
+            }
+            else if (part.second
+                     && tinySTL::__partial_insertion_sort(first, pivot_pos, comp)
+                     && tinySTL::__partial_insertion_sort(pivot_pos + 1, last, comp)) {
+                return;
+            }
+
+            // Recurse into the smaller side so stack depth stays O(log n).
+            if (l_size < r_size) {
+                tinySTL::__pdq_sort_loop<Branchless>(first, pivot_pos, comp, bad_allowed, leftmost);
+                first = pivot_pos + 1;
+                leftmost = false;
+            }
+            else {
+                tinySTL::__pdq_sort_loop<Branchless>(pivot_pos + 1, last, comp, bad_allowed, false);
+                last = pivot_pos;
+            }
+        }
+    }
+
+    template <class T, class Compare>
+    struct __sort_is_branchless : std::integral_constant<bool, std::is_arithmetic<T>::value &&
+        (std::is_same<Compare, less<T> >::value || std::is_same<Compare, greater<T> >::value)> {};
+
+    template <class Size>
+    inline int __sort_log2(Size n) {
+        int log = 0;
+        while (n >>= 1) {
+            ++log;
+        }
+        return log;
+    }
+
+    // Returns true if [first, last) is one ascending or strictly descending run,
+    // in which case it has been left sorted.
+    template <class RandomAccessIterator, class Compare>
+    bool __sort_single_run(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        RandomAccessIterator next = first + 1;
+        if (comp(*next, *first)) {
+            while (++next != last && comp(*next, *(next - 1)));
+            if (next != last) {
+                return false;
+            }
+            tinySTL::reverse(first, last);
+            return true;
+        }
+        while (++next != last && !comp(*next, *(next - 1)));
+        return next == last;
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        if (last - first < 2) {
+            return;
+        }
+        if (last - first >= __sort_insertion_threshold && tinySTL::__sort_single_run(first, last, comp)) {
+            return;
+        }
+        tinySTL::__pdq_sort_loop<__sort_is_branchless<T, Compare>::value>(first, last, comp,
+                                                                 tinySTL::__sort_log2(last - first), true);
+    }
+
+    template <class RandomAccessIterator>
+    void sort(RandomAccessIterator first, RandomAccessIterator last) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        tinySTL::sort(first, last, less<T>());
+    }
+
+    // Deterministic selection: the pivot is the median of the medians of
+    // groups of five, which leaves at least 3/10 of the range on each side of
+    // it, so the work is linear whatever the input. Elements equal to the
+    // pivot are gathered next to it so runs of duplicates end the search.
+    template <class RandomAccessIterator, class Compare>
+    void __median_of_medians_select(RandomAccessIterator first, RandomAccessIterator nth,
+                                    RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        while (last - first >= __sort_insertion_threshold) {
+            Distance groups = 0;
+            for (RandomAccessIterator g = first; last - g >= 5; g += 5) {
+                tinySTL::__insertion_sort(g, g + 5, comp);
+                tinySTL::iter_swap(first + groups, g + 2);
+                ++groups;
+            }
+            const RandomAccessIterator median = first + groups / 2;
+            tinySTL::__median_of_medians_select(first, median, first + groups, comp);
+            tinySTL::iter_swap(first, median);
+
+            const RandomAccessIterator pivot_pos = tinySTL::__partition_right(first, last, comp).first;
+            if (nth < pivot_pos) {
+                last = pivot_pos;
+                continue;
+            }
+            RandomAccessIterator equal_end = pivot_pos + 1;
+            for (RandomAccessIterator it = equal_end; it != last; ++it) {
+                if (!comp(*pivot_pos, *it)) {
+                    tinySTL::iter_swap(it, equal_end++);
+                }
+            }
+            if (nth < equal_end) {
+                return;
+            }
+            first = equal_end;
+        }
+        tinySTL::__insertion_sort(first, last, comp);
+    }
+
+    // Quickselect with the same pivot choice and partitioning as sort. Once
+    // too many partitions come out lopsided it hands over to median of
+    // medians, so the worst case stays O(n).
+    template <bool Branchless, class RandomAccessIterator, class Compare>
+    void __introselect(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last,
+                       Compare comp, int bad_allowed) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        bool leftmost = true;
+        while (last - first >= __sort_insertion_threshold) {
+            const Distance size = last - first;
+            const Distance s2 = size / 2;
+            if (size > __sort_ninther_threshold) {
+                tinySTL::__sort3(first, first + s2, last - 1, comp);
+                tinySTL::__sort3(first + 1, first + (s2 - 1), last - 2, comp);
+                tinySTL::__sort3(first + 2, first + (s2 + 1), last - 3, comp);
+                tinySTL::__sort3(first + (s2 - 1), first + s2, first + (s2 + 1), comp);
+                tinySTL::iter_swap(first, first + s2);
+            }
+            else {
+                tinySTL::__sort3(first + s2, first, last - 1, comp);
+            }
+
+            // The pivot equals the element before the range: everything up to
+            // the returned position equals it too.
+            if (!leftmost && !comp(*(first - 1), *first)) {
+                const RandomAccessIterator equal_last = tinySTL::__partition_left(first, last, comp);
+                if (nth <= equal_last) {
+                    return;
+                }
+                first = equal_last + 1;
+                continue;
+            }
+
+            const RandomAccessIterator pivot_pos = Branchless
+                ? tinySTL::__partition_right_branchless(first, last, comp).first
+                : tinySTL::__partition_right(first, last, comp).first;
+            if (pivot_pos == nth) {
+                return;
+            }
+            if ((pivot_pos - first < size / 8 || last - pivot_pos <= size / 8) && --bad_allowed == 0) {
+                tinySTL::__median_of_medians_select(first, nth, last, comp);
+                return;
+            }
+            if (nth < pivot_pos) {
+                last = pivot_pos;
+            }
+            else {
+                first = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+        tinySTL::__insertion_sort(first, last, comp);
+    }
+
+    // Rearranges [first, last) so that *nth is the element that would be
+    // there if the range were sorted, with no element after it ordering
+    // before any element ahead of it.
+    template <class RandomAccessIterator, class Compare>
+    void nth_element(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        if (nth == last || last - first < 2) {
+            return;
+        }
+        tinySTL::__introselect<__sort_is_branchless<T, Compare>::value>(first, nth, last, comp,
+                                                                        tinySTL::__sort_log2(last - first));
+    }
+
+    template <class RandomAccessIterator>
+    inline void nth_element(RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        tinySTL::nth_element(first, nth, last, less<T>());
+    }
+
+    // Largest prefix sorted with a heap; beyond it, selecting first and sorting
+    // only the prefix does fewer comparisons than sifting every candidate.
+    enum { __partial_sort_heap_limit = 1024 };
+
+    // Sorts the middle - first smallest elements into [first, middle); the
+    // order of the rest is unspecified.
+    template <class RandomAccessIterator, class Compare>
+    void partial_sort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last,
+                      Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type      T;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        const Distance k = middle - first;
+        if (k == 0) {
+            return;
+        }
+        if (k > __partial_sort_heap_limit && k < last - first) {
+            tinySTL::nth_element(first, middle - 1, last, comp);
+            tinySTL::sort(first, middle - 1, comp);
+            return;
+        }
+        // A max-heap of the best k so far; each later element either loses to
+        // its top, which costs one comparison, or replaces it.
+        tinySTL::make_heap(first, middle, comp);
+        for (RandomAccessIterator it = middle; it < last; ++it) {
+            if (comp(*it, *first)) {
+                T value = tinySTL::move(*it);
+                *it = tinySTL::move(*first);
+                tinySTL::__sift_down<2>(first, Distance(0), k, tinySTL::move(value), comp);
+            }
+        }
+        tinySTL::sort_heap(first, middle, comp);
+    }
+
+    template <class RandomAccessIterator>
+    inline void partial_sort(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        tinySTL::partial_sort(first, middle, last, less<T>());
+    }
+
+    // Copies the smallest min(last - first, result_last - result_first)
+    // elements of a single pass over the input, in order, to the result.
+    template <class InputIterator, class RandomAccessIterator, class Compare>
+    RandomAccessIterator partial_sort_copy(InputIterator first, InputIterator last,
+                                           RandomAccessIterator result_first, RandomAccessIterator result_last,
+                                           Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type      T;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        RandomAccessIterator result_end = result_first;
+        for (; first != last && result_end != result_last; ++first, ++result_end) {
+            *result_end = *first;
+        }
+        const Distance k = result_end - result_first;
+        if (k == 0) {
+            return result_end;
+        }
+        tinySTL::make_heap(result_first, result_end, comp);
+        for (; first != last; ++first) {
+            if (comp(*first, *result_first)) {
+                tinySTL::__sift_down<2>(result_first, Distance(0), k, T(*first), comp);
+            }
+        }
+        tinySTL::sort_heap(result_first, result_end, comp);
+        return result_end;
+    }
+
+    template <class InputIterator, class RandomAccessIterator>
+    inline RandomAccessIterator partial_sort_copy(InputIterator first, InputIterator last,
+                                                  RandomAccessIterator result_first,
+                                                  RandomAccessIterator result_last) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        return tinySTL::partial_sort_copy(first, last, result_first, result_last, less<T>());
+    }
+
+    enum {
+        __timsort_min_merge = 32,
+        __timsort_min_gallop = 7,
+        __timsort_max_runs = 85
+    };
+
+    // Reverses a strictly descending prefix of [first, last) in place, which
+    // keeps equal elements in order, and returns the length of the ascending
+    // run now at first.
+    template <class RandomAccessIterator, class Compare>
+    typename iterator_traits<RandomAccessIterator>::difference_type
+    __timsort_count_run(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        RandomAccessIterator run_last = first + 1;
+        if (run_last == last) {
+            return 1;
+        }
+        if (comp(*run_last++, *first)) {
+            while (run_last != last && comp(*run_last, *(run_last - 1))) {
+                ++run_last;
+            }
+            tinySTL::reverse(first, run_last);
+        }
+        else {
+            while (run_last != last && !comp(*run_last, *(run_last - 1))) {
+                ++run_last;
+            }
+        }
+        return run_last - first;
+    }
+
+    // Extends the sorted prefix [first, start) over [start, last). Each
+    // element goes after its equals, found by binary search.
+    template <class RandomAccessIterator, class Compare>
+    void __binary_insertion_sort(RandomAccessIterator first, RandomAccessIterator start, RandomAccessIterator last,
+                                 Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        for (; start != last; ++start) {
+            T value = tinySTL::move(*start);
+            RandomAccessIterator pos = start;
+            try {
+                pos = tinySTL::upper_bound(first, start, value, comp);
+            }
+            catch (...) {
+                *start = tinySTL::move(value);
+                throw;
+            }
+            tinySTL::move_backward(pos, start, start + 1);
+            *pos = tinySTL::move(value);
+        }
+    }
+
+    // Position of the first element of the sorted range [base, base + len)
+    // not less than key, searched from base + hint outwards in steps of
+    // 1, 3, 7, ... and then by bisection, so it costs O(log d) for an answer
+    // d away from the hint.
+    template <class Iterator, class T, class Distance, class Compare>
+    Distance __gallop_left(const T& key, Iterator base, Distance len, Distance hint, Compare comp) {
+        Distance last_ofs = 0;
+        Distance ofs = 1;
+        if (comp(*(base + hint), key)) {
+            const Distance max_ofs = len - hint;
+            while (ofs < max_ofs && comp(*(base + (hint + ofs)), key)) {
+                last_ofs = ofs;
+                ofs = (ofs << 1) + 1;
+                if (ofs <= 0) {
+                    ofs = max_ofs;
+                }
+            }
+            if (ofs > max_ofs) {
+                ofs = max_ofs;
+            }
+            last_ofs += hint;
+            ofs += hint;
+        }
+        else {
+            const Distance max_ofs = hint + 1;
+            while (ofs < max_ofs && !comp(*(base + (hint - ofs)), key)) {
+                last_ofs = ofs;
+                ofs = (ofs << 1) + 1;
+                if (ofs <= 0) {
+                    ofs = max_ofs;
+                }
+            }
+            if (ofs > max_ofs) {
+                ofs = max_ofs;
+            }
+            const Distance tmp = last_ofs;
+            last_ofs = hint - ofs;
+            ofs = hint - tmp;
+        }
+        ++last_ofs;
+        while (last_ofs < ofs) {
+            const Distance m = last_ofs + (ofs - last_ofs) / 2;
+            if (comp(*(base + m), key)) {
+                last_ofs = m + 1;
+            }
+            else {
+                ofs = m;
+            }
+        }
+        return ofs;
+    }
+
+    // Like __gallop_left, but returns the position after the last element
+    // not greater than key.
+    template <class Iterator, class T, class Distance, class Compare>
+    Distance __gallop_right(const T& key, Iterator base, Distance len, Distance hint, Compare comp) {
+        Distance last_ofs = 0;
+        Distance ofs = 1;
+        if (comp(key, *(base + hint))) {
+            const Distance max_ofs = hint + 1;
+            while (ofs < max_ofs && comp(key, *(base + (hint - ofs)))) {
+                last_ofs = ofs;
+                ofs = (ofs << 1) + 1;
+                if (ofs <= 0) {
+                    ofs = max_ofs;
+                }
+            }
+            if (ofs > max_ofs) {
+                ofs = max_ofs;
+            }
+            const Distance tmp = last_ofs;
+            last_ofs = hint - ofs;
+            ofs = hint - tmp;
+        }
+        else {
+            const Distance max_ofs = len - hint;
+            while (ofs < max_ofs && !comp(key, *(base + (hint + ofs)))) {
+                last_ofs = ofs;
+                ofs = (ofs << 1) + 1;
+                if (ofs <= 0) {
+                    ofs = max_ofs;
+                }
+            }
+            if (ofs > max_ofs) {
+                ofs = max_ofs;
+            }
+            last_ofs += hint;
+            ofs += hint;
+        }
+        ++last_ofs;
+        while (last_ofs < ofs) {
+            const Distance m = last_ofs + (ofs - last_ofs) / 2;
+            if (comp(key, *(base + m))) {
+                ofs = m;
+            }
+            else {
+                last_ofs = m + 1;
+            }
+        }
+        return ofs;
+    }
+
+    // Stable merge of [first, middle) and [middle, last) with no extra memory:
+    // split the longer side in half, find where its midpoint falls in the
+    // other, rotate the pieces into place and recurse. O(n log n) moves.
+    template <class BidirectionalIterator, class Distance, class Compare>
+    void __merge_without_buffer(BidirectionalIterator first, BidirectionalIterator middle,
+                                BidirectionalIterator last, Distance len1, Distance len2, Compare comp) {
+        while (len1 != 0 && len2 != 0) {
+            if (len1 + len2 == 2) {
+                if (comp(*middle, *first)) {
+                    tinySTL::iter_swap(first, middle);
+                }
+                return;
+            }
+            BidirectionalIterator first_cut = first;
+            BidirectionalIterator second_cut = middle;
+            Distance len11 = 0;
+            Distance len22 = 0;
+            if (len1 > len2) {
+                len11 = len1 / 2;
+                tinySTL::advance(first_cut, len11);
+                second_cut = tinySTL::lower_bound(middle, last, *first_cut, comp);
+                len22 = tinySTL::distance(middle, second_cut);
+            }
+            else {
+                len22 = len2 / 2;
+                tinySTL::advance(second_cut, len22);
+                first_cut = tinySTL::upper_bound(first, middle, *second_cut, comp);
+                len11 = tinySTL::distance(first, first_cut);
+            }
+            const BidirectionalIterator new_middle = tinySTL::rotate(first_cut, middle, second_cut);
+            tinySTL::__merge_without_buffer(first, first_cut, new_middle, len11, len22, comp);
+            first = new_middle;
+            middle = second_cut;
+            len1 -= len11;
+            len2 -= len22;
+        }
+    }
+
+    // TimSort: the input is cut into natural runs, short runs are extended to
+    // min_run() with binary insertion, and runs are merged off a stack whose
+    // lengths grow at least like the Fibonacci numbers, so merges stay
+    // balanced. Merges copy the shorter run into a scratch buffer and switch
+    // to galloping when one run keeps winning, which makes merging runs that
+    // barely interleave close to free. If the buffer can't be allocated the
+    // merge falls back to rotations in place.
+    template <class RandomAccessIterator, class Compare>
+    class __timsort {
+    private:
+        typedef typename iterator_traits<RandomAccessIterator>::value_type      T;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+
+        struct run {
+            RandomAccessIterator base;
+            Distance len;
+        };
+
+        // Where a merge is; on an exception, the buffered elements still
+        // pending go back into the holes left in the range.
+        struct merge_lo_state {
+            T* cursor1;
+            RandomAccessIterator cursor2;
+            RandomAccessIterator dest;
+            Distance len1;
+            Distance len2;
+        };
+
+        struct merge_hi_state {
+            Distance cursor1;
+            Distance cursor2;
+            Distance dest;
+            Distance len1;
+            Distance len2;
+        };
+
+        Compare comp;
+        Distance total;
+        Distance min_gallop;
+        T* buffer;
+        Distance buffer_size;
+        bool buffer_failed;
+        run runs[__timsort_max_runs];
+        int stack_size;
+
+        // Makes room for n elements in the buffer, growing it geometrically up
+        // to half the input. Returns false once allocation has failed.
+        bool reserve(Distance n) {
+            if (n <= buffer_size) {
+                return true;
+            }
+            if (buffer_failed) {
+                return false;
+            }
+            Distance size = 2 * buffer_size > n ? 2 * buffer_size : n;
+            if (size > total / 2 && n <= total / 2) {
+                size = total / 2;
+            }
+            release();
+            while (true) {
+                try {
+                    buffer = allocator<T>::allocate(size_t(size));
+                    buffer_size = size;
+                    return true;
+                }
+                catch (const std::bad_alloc&) {
+                    if (size == n) {
+                        buffer_failed = true;
+                        return false;
+                    }
+                    size = n;
+                }
+            }
+        }
+
+        void release() {
+            if (buffer) {
+                allocator<T>::deallocate(buffer, size_t(buffer_size));
+                buffer = nullptr;
+                buffer_size = 0;
+            }
+        }
+
+        // Merges run 1 into run 2 from the left; len1 <= len2, and run 1's
+        // last element belongs after run 2's first.
+        void merge_lo(RandomAccessIterator base1, Distance len1, RandomAccessIterator base2, Distance len2) {
+            T* tmp = buffer;
+            for (Distance i = 0; i < len1; ++i) {
+                tinySTL::construct(tmp + i, tinySTL::move(*(base1 + i)));
+            }
+            const Distance buffered = len1;
+            merge_lo_state s = { tmp, base2, base1, len1, len2 };
+            try {
+                merge_lo_loop(s);
+            }
+            catch (...) {
+                tinySTL::move(s.cursor1, s.cursor1 + s.len1, s.dest);
+                tinySTL::destroy(tmp, tmp + buffered);
+                throw;
+            }
+            if (s.len1 == 1) {
+                *tinySTL::move(s.cursor2, s.cursor2 + s.len2, s.dest) = tinySTL::move(*s.cursor1);
+            }
+            else {
+                tinySTL::move(s.cursor1, s.cursor1 + s.len1, s.dest);
+            }
+            tinySTL::destroy(tmp, tmp + buffered);
+        }
+
+        // Returns with s.len1 == 1 and run 2's tail still to move, or with
+        // run 2 used up and run 1's tail in the buffer.
+        void merge_lo_loop(merge_lo_state& s) {
+            *s.dest++ = tinySTL::move(*s.cursor2++);
+            if (--s.len2 == 0 || s.len1 == 1) {
+                return;
+            }
+            while (true) {
+                Distance count1 = 0;
+                Distance count2 = 0;
+                do {
+                    if (comp(*s.cursor2, *s.cursor1)) {
+                        *s.dest++ = tinySTL::move(*s.cursor2++);
+                        ++count2;
+                        count1 = 0;
+                        if (--s.len2 == 0) {
+                            return;
+                        }
+                    }
+                    else {
+                        *s.dest++ = tinySTL::move(*s.cursor1++);
+                        ++count1;
+                        count2 = 0;
+                        if (--s.len1 == 1) {
+                            return;
+                        }
+                    }
+                } while ((count1 | count2) < min_gallop);
+
+                do {
+                    count1 = tinySTL::__gallop_right(*s.cursor2, s.cursor1, s.len1, Distance(0), comp);
+                    if (count1 != 0) {
+                        s.dest = tinySTL::move(s.cursor1, s.cursor1 + count1, s.dest);
+                        s.cursor1 += count1;
+                        s.len1 -= count1;
+                        if (s.len1 <= 1) {
+                            return;
+                        }
+                    }
+                    *s.dest++ = tinySTL::move(*s.cursor2++);
+                    if (--s.len2 == 0) {
+                        return;
+                    }
+                    count2 = tinySTL::__gallop_left(*s.cursor1, s.cursor2, s.len2, Distance(0), comp);
+                    if (count2 != 0) {
+                        s.dest = tinySTL::move(s.cursor2, s.cursor2 + count2, s.dest);
+                        s.cursor2 += count2;
+                        s.len2 -= count2;
+                        if (s.len2 == 0) {
+                            return;
+                        }
+                    }
+                    *s.dest++ = tinySTL::move(*s.cursor1++);
+                    if (--s.len1 == 1) {
+                        return;
+                    }
+                    --min_gallop;
+                } while (count1 >= __timsort_min_gallop || count2 >= __timsort_min_gallop);
+                if (min_gallop < 0) {
+                    min_gallop = 0;
+                }
+                min_gallop += 2;
+            }
+        }
+
+        // Mirror image of merge_lo for len1 > len2: run 2 is buffered and the
+        // merge fills the range from the right. Positions are offsets from base1.
+        void merge_hi(RandomAccessIterator base1, Distance len1, RandomAccessIterator base2, Distance len2) {
+            T* tmp = buffer;
+            for (Distance i = 0; i < len2; ++i) {
+                tinySTL::construct(tmp + i, tinySTL::move(*(base2 + i)));
+            }
+            const Distance buffered = len2;
+            merge_hi_state s = { len1 - 1, len2 - 1, len1 + len2 - 1, len1, len2 };
+            try {
+                merge_hi_loop(base1, tmp, s);
+            }
+            catch (...) {
+                tinySTL::move(tmp, tmp + s.len2, base1 + (s.dest - (s.len2 - 1)));
+                tinySTL::destroy(tmp, tmp + buffered);
+                throw;
+            }
+            if (s.len2 == 1) {
+                s.dest -= s.len1;
+                s.cursor1 -= s.len1;
+                tinySTL::move_backward(base1 + (s.cursor1 + 1), base1 + (s.cursor1 + 1 + s.len1),
+                                       base1 + (s.dest + 1 + s.len1));
+                *(base1 + s.dest) = tinySTL::move(*(tmp + s.cursor2));
+            }
+            else {
+                tinySTL::move(tmp, tmp + s.len2, base1 + (s.dest - (s.len2 - 1)));
+            }
+            tinySTL::destroy(tmp, tmp + buffered);
+        }
+
+        void merge_hi_loop(RandomAccessIterator a, T* tmp, merge_hi_state& s) {
+            *(a + s.dest--) = tinySTL::move(*(a + s.cursor1--));
+            if (--s.len1 == 0 || s.len2 == 1) {
+                return;
+            }
+            while (true) {
+                Distance count1 = 0;
+                Distance count2 = 0;
+                do {
+                    if (comp(*(tmp + s.cursor2), *(a + s.cursor1))) {
+                        *(a + s.dest--) = tinySTL::move(*(a + s.cursor1--));
+                        ++count1;
+                        count2 = 0;
+                        if (--s.len1 == 0) {
+                            return;
+                        }
+                    }
+                    else {
+                        *(a + s.dest--) = tinySTL::move(*(tmp + s.cursor2--));
+                        ++count2;
+                        count1 = 0;
+                        if (--s.len2 == 1) {
+                            return;
+                        }
+                    }
+                } while ((count1 | count2) < min_gallop);
+
+                do {
+                    count1 = s.len1 - tinySTL::__gallop_right(*(tmp + s.cursor2), a, s.len1, s.len1 - 1, comp);
+                    if (count1 != 0) {
+                        s.dest -= count1;
+                        s.cursor1 -= count1;
+                        s.len1 -= count1;
+                        tinySTL::move_backward(a + (s.cursor1 + 1), a + (s.cursor1 + 1 + count1),
+                                               a + (s.dest + 1 + count1));
+                        if (s.len1 == 0) {
+                            return;
+                        }
+                    }
+                    *(a + s.dest--) = tinySTL::move(*(tmp + s.cursor2--));
+                    if (--s.len2 == 1) {
+                        return;
+                    }
+                    count2 = s.len2 - tinySTL::__gallop_left(*(a + s.cursor1), tmp, s.len2, s.len2 - 1, comp);
+                    if (count2 != 0) {
+                        s.dest -= count2;
+                        s.cursor2 -= count2;
+                        s.len2 -= count2;
+                        tinySTL::move(tmp + (s.cursor2 + 1), tmp + (s.cursor2 + 1 + count2), a + (s.dest + 1));
+                        if (s.len2 <= 1) {
+                            return;
+                        }
+                    }
+                    *(a + s.dest--) = tinySTL::move(*(a + s.cursor1--));
+                    if (--s.len1 == 0) {
+                        return;
+                    }
+                    --min_gallop;
+                } while (count1 >= __timsort_min_gallop || count2 >= __timsort_min_gallop);
+                if (min_gallop < 0) {
+                    min_gallop = 0;
+                }
+                min_gallop += 2;
+            }
+        }
+
+        // Merges stack entries i and i + 1.
+        void merge_at(int i) {
+            RandomAccessIterator base1 = runs[i].base;
+            Distance len1 = runs[i].len;
+            const RandomAccessIterator base2 = runs[i + 1].base;
+            Distance len2 = runs[i + 1].len;
+            runs[i].len = len1 + len2;
+            if (i == stack_size - 3) {
+                runs[i + 1] = runs[i + 2];
+            }
+            --stack_size;
+
+            // Elements of run 1 before run 2's first, and of run 2 after run
+            // 1's last, are already in place.
+            const Distance k = tinySTL::__gallop_right(*base2, base1, len1, Distance(0), comp);
+            base1 += k;
+            len1 -= k;
+            if (len1 == 0) {
+                return;
+            }
+            len2 = tinySTL::__gallop_left(*(base1 + (len1 - 1)), base2, len2, len2 - 1, comp);
+            if (len2 == 0) {
+                return;
+            }
+            if (!reserve(len1 < len2 ? len1 : len2)) {
+                tinySTL::__merge_without_buffer(base1, base2, base2 + len2, len1, len2, comp);
+            }
+            else if (len1 <= len2) {
+                merge_lo(base1, len1, base2, len2);
+            }
+            else {
+                merge_hi(base1, len1, base2, len2);
+            }
+            if (min_gallop < 1) {
+                min_gallop = 1;
+            }
+        }
+
+        // Restores len[i - 2] > len[i - 1] + len[i] and len[i - 1] > len[i]
+        // down the stack, checking one entry deeper than the original
+        // formulation so the invariant really holds.
+        void merge_collapse() {
+            while (stack_size > 1) {
+                int n = stack_size - 2;
+                if ((n > 0 && runs[n - 1].len <= runs[n].len + runs[n + 1].len)
+                    || (n > 1 && runs[n - 2].len <= runs[n - 1].len + runs[n].len)) {
+                    if (runs[n - 1].len < runs[n + 1].len) {
+                        --n;
+                    }
+                }
+                else if (runs[n].len > runs[n + 1].len) {
+                    return;
+                }
+                merge_at(n);
+            }
+        }
+
+        void merge_force_collapse() {
+            while (stack_size > 1) {
+                int n = stack_size - 2;
+                if (n > 0 && runs[n - 1].len < runs[n + 1].len) {
+                    --n;
+                }
+                merge_at(n);
+            }
+        }
+
+        // A length in [16, 32] such that n / min_run is a power of two or just
+        // below one, so the final merges are balanced.
+        static Distance min_run(Distance n) {
+            Distance r = 0;
+            while (n >= __timsort_min_merge) {
+                r |= n & 1;
+                n >>= 1;
+            }
+            return n + r;
+        }
+
+    public:
+        __timsort(Compare c, Distance n) : comp(c), total(n), min_gallop(__timsort_min_gallop), buffer(nullptr),
+                                            buffer_size(0), buffer_failed(false), stack_size(0) {}
+
+        ~__timsort() { release(); }
+
+        __timsort(const __timsort&) = delete;
+        __timsort& operator=(const __timsort&) = delete;
+
+        void sort(RandomAccessIterator first, RandomAccessIterator last) {
+            const Distance min_len = min_run(last - first);
+            while (first != last) {
+                Distance len = tinySTL::__timsort_count_run(first, last, comp);
+                if (len < min_len) {
+                    const Distance forced = last - first < min_len ? last - first : min_len;
+                    tinySTL::__binary_insertion_sort(first, first + len, first + forced, comp);
+                    len = forced;
+                }
+                runs[stack_size].base = first;
+                runs[stack_size].len = len;
+                ++stack_size;
+                merge_collapse();
+                first += len;
+            }
+            merge_force_collapse();
+        }
+    };
+
+    // Sorts [first, last) keeping equal elements in their original order.
+    // Runs already in order are found and kept, so sorted or nearly sorted
+    // input takes close to linear time.
+    template <class RandomAccessIterator, class Compare>
+    void stable_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        const Distance n = last - first;
+        if (n < 2) {
+            return;
+        }
+        if (n < __timsort_min_merge) {
+            const Distance run = tinySTL::__timsort_count_run(first, last, comp);
+            tinySTL::__binary_insertion_sort(first, first + run, last, comp);
+            return;
+        }
+        __timsort<RandomAccessIterator, Compare> sorter(comp, n);
+        sorter.sort(first, last);
+    }
+
+    template <class RandomAccessIterator>
+    inline void stable_sort(RandomAccessIterator first, RandomAccessIterator last) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        tinySTL::stable_sort(first, last, less<T>());
     }
 }
 
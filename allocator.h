@@ -72,7 +72,7 @@ namespace tinySTL {
 
     template <class T>
     void allocator<T>::construct(pointer ptr, value_type&& value) {
-        tinySTL::construct(ptr, move(value));
+        tinySTL::construct(ptr, std::move(value));
     }
 
     template <class T>
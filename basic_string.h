@@ -0,0 +1,413 @@
+#ifndef _TINY_BASIC_STRING_H_
+#define _TINY_BASIC_STRING_H_
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include "allocator.h"
+#include "construct.h"
+#include "functional.h"
+#include "string_view.h"
+
+namespace tinySTL {
+    // A string three words in size, with the last byte of the object doing
+    // double duty. Short strings, up to 23 chars on a 64-bit target, are kept
+    // in place and that byte holds 23 - size(), which becomes the terminating
+    // zero exactly when the buffer is full. Longer strings are a pointer,
+    // size and capacity, with the capacity stored so that the same byte has
+    // its top bit set. Nothing points into the object itself, so it can be
+    // moved with memcpy (see __is_relocatable).
+    template <class CharT>
+    class basic_string {
+    public:
+        typedef CharT                       value_type;
+        typedef value_type*                 pointer;
+        typedef value_type*                 iterator;
+        typedef value_type&                 reference;
+        typedef size_t                      size_type;
+        typedef ptrdiff_t                   difference_type;
+        typedef const value_type*           const_pointer;
+        typedef const value_type&           const_reference;
+        typedef const value_type*           const_iterator;
+        typedef basic_string_view<CharT>    view_type;
+
+        static constexpr size_type npos = size_type(-1);
+
+    protected:
+        typedef allocator<CharT> data_allocator;
+
+        struct long_rep {
+            CharT* data;
+            size_type size;
+            size_type cap;
+        };
+
+        static const size_type small_capacity = sizeof(long_rep) / sizeof(CharT) - 1;
+        static const size_t flag_byte = sizeof(long_rep) - 1;
+
+        union {
+            long_rep l;
+            CharT s[small_capacity + 1];
+            unsigned char bytes[sizeof(long_rep)];
+        } rep;
+
+        // The capacity word with the flag in the byte that overlaps flag_byte.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        static size_type encode_cap(size_type cap) { return (cap << 8) | 0x80; }
+        static size_type decode_cap(size_type word) { return word >> 8; }
+#else
+        static size_type encode_cap(size_type cap) { return cap | (size_type(0x80) << (8 * (sizeof(size_type) - 1))); }
+        static size_type decode_cap(size_type word) { return word & ~(size_type(0x80) << (8 * (sizeof(size_type) - 1))); }
+#endif
+
+        bool is_long() const { return (rep.bytes[flag_byte] & 0x80) != 0; }
+
+        void set_small_size(size_type n) {
+            rep.s[small_capacity] = CharT();
+            rep.bytes[flag_byte] = static_cast<unsigned char>(small_capacity - n);
+            rep.s[n] = CharT();
+        }
+
+        void set_long(CharT* p, size_type n, size_type cap) {
+            rep.l.data = p;
+            rep.l.size = n;
+            rep.l.cap = encode_cap(cap);
+            p[n] = CharT();
+        }
+
+        void set_size(size_type n) {
+            if (is_long()) {
+                rep.l.size = n;
+                rep.l.data[n] = CharT();
+            }
+            else {
+                set_small_size(n);
+            }
+        }
+
+        void release() {
+            if (is_long()) {
+                data_allocator::deallocate(rep.l.data, decode_cap(rep.l.cap) + 1);
+            }
+        }
+
+        static void copy_chars(CharT* dst, const CharT* src, size_type n) {
+            if (n) {
+                std::memcpy(dst, src, n * sizeof(CharT));
+            }
+        }
+
+        static void move_chars(CharT* dst, const CharT* src, size_type n) {
+            if (n) {
+                std::memmove(dst, src, n * sizeof(CharT));
+            }
+        }
+
+        bool aliases(const CharT* p) const {
+            const CharT* first = data();
+            return !(p < first || first + capacity() < p);
+        }
+
+        // Doubling keeps appends amortized O(1).
+        size_type recommend(size_type n) const {
+            const size_type doubled = 2 * capacity();
+            return n < doubled ? doubled : n;
+        }
+
+        void initialize(const CharT* p, size_type n) {
+            if (n <= small_capacity) {
+                copy_chars(rep.s, p, n);
+                set_small_size(n);
+            }
+            else {
+                CharT* buf = data_allocator::allocate(n + 1);
+                copy_chars(buf, p, n);
+                set_long(buf, n, n);
+            }
+        }
+
+        // Moves the contents to a buffer of capacity cap, which must be at least size().
+        void reallocate(size_type cap) {
+            const size_type n = size();
+            CharT* buf = data_allocator::allocate(cap + 1);
+            copy_chars(buf, data(), n);
+            release();
+            set_long(buf, n, cap);
+        }
+
+    public:
+        basic_string() { set_small_size(0); }
+        basic_string(const CharT* s) { initialize(s, tinySTL::__char_length(s)); }
+        basic_string(const CharT* s, size_type n) { initialize(s, n); }
+        explicit basic_string(view_type x) { initialize(x.data(), x.size()); }
+        basic_string(size_type n, CharT c) { set_small_size(0); resize(n, c); }
+        basic_string(const basic_string& x) { initialize(x.data(), x.size()); }
+
+        basic_string(basic_string&& x) noexcept {
+            std::memcpy(static_cast<void*>(&rep), &x.rep, sizeof(rep));
+            x.set_small_size(0);
+        }
+
+        ~basic_string() { release(); }
+
+        basic_string& operator=(const basic_string& x) {
+            if (this != &x) {
+                assign(x.data(), x.size());
+            }
+            return *this;
+        }
+
+        basic_string& operator=(basic_string&& x) noexcept {
+            if (this != &x) {
+                release();
+                std::memcpy(static_cast<void*>(&rep), &x.rep, sizeof(rep));
+                x.set_small_size(0);
+            }
+            return *this;
+        }
+
+        basic_string& operator=(view_type x) { return assign(x.data(), x.size()); }
+        basic_string& operator=(const CharT* s) { return assign(s, tinySTL::__char_length(s)); }
+
+        operator view_type() const { return view_type(data(), size()); }
+
+        iterator begin() { return data(); }
+        const_iterator begin() const { return data(); }
+        iterator end() { return data() + size(); }
+        const_iterator end() const { return data() + size(); }
+        pointer data() { return is_long() ? rep.l.data : rep.s; }
+        const_pointer data() const { return is_long() ? rep.l.data : rep.s; }
+        const_pointer c_str() const { return data(); }
+        size_type size() const { return is_long() ? rep.l.size : small_capacity - rep.bytes[flag_byte]; }
+        size_type length() const { return size(); }
+        size_type capacity() const { return is_long() ? decode_cap(rep.l.cap) : small_capacity; }
+        bool empty() const { return size() == 0; }
+        reference operator[](size_type n) { return data()[n]; }
+        const_reference operator[](size_type n) const { return data()[n]; }
+        reference front() { return data()[0]; }
+        const_reference front() const { return data()[0]; }
+        reference back() { return data()[size() - 1]; }
+        const_reference back() const { return data()[size() - 1]; }
+
+        reference at(size_type n) {
+            if (n >= size()) {
+                throw std::out_of_range("basic_string::at");
+            }
+            return data()[n];
+        }
+
+        const_reference at(size_type n) const {
+            if (n >= size()) {
+                throw std::out_of_range("basic_string::at");
+            }
+            return data()[n];
+        }
+
+        basic_string& assign(const CharT* p, size_type n) {
+            if (n <= capacity()) {
+                move_chars(data(), p, n);
+                set_size(n);
+            }
+            else {
+                // p can't point into a buffer smaller than n.
+                CharT* buf = data_allocator::allocate(n + 1);
+                copy_chars(buf, p, n);
+                release();
+                set_long(buf, n, n);
+            }
+            return *this;
+        }
+
+        void reserve(size_type n) {
+            if (n > capacity()) {
+                reallocate(n);
+            }
+        }
+
+        // Gives up excess capacity, moving back into the object when it fits.
+        void shrink_to_fit() {
+            const size_type n = size();
+            if (!is_long() || decode_cap(rep.l.cap) == n) {
+                return;
+            }
+            if (n <= small_capacity) {
+                CharT* p = rep.l.data;
+                const size_type cap = decode_cap(rep.l.cap);
+                copy_chars(rep.s, p, n);
+                set_small_size(n);
+                data_allocator::deallocate(p, cap + 1);
+            }
+            else {
+                reallocate(n);
+            }
+        }
+
+        basic_string& append(const CharT* p, size_type n) {
+            const size_type old_size = size();
+            if (n <= capacity() - old_size) {
+                copy_chars(data() + old_size, p, n);
+                set_size(old_size + n);
+            }
+            else {
+                // Copy p before releasing the old buffer: it may point into it.
+                const size_type cap = recommend(old_size + n);
+                CharT* buf = data_allocator::allocate(cap + 1);
+                copy_chars(buf, data(), old_size);
+                copy_chars(buf + old_size, p, n);
+                release();
+                set_long(buf, old_size + n, cap);
+            }
+            return *this;
+        }
+
+        basic_string& append(view_type x) { return append(x.data(), x.size()); }
+        basic_string& append(const CharT* s) { return append(s, tinySTL::__char_length(s)); }
+
+        basic_string& append(size_type n, CharT c) {
+            const size_type old_size = size();
+            resize_default_init(old_size + n);
+            CharT* p = data() + old_size;
+            for (size_type i = 0; i < n; ++i) {
+                p[i] = c;
+            }
+            return *this;
+        }
+
+        basic_string& operator+=(view_type x) { return append(x.data(), x.size()); }
+        basic_string& operator+=(const CharT* s) { return append(s); }
+        basic_string& operator+=(CharT c) { push_back(c); return *this; }
+
+        void push_back(CharT c) {
+            const size_type n = size();
+            if (n == capacity()) {
+                reallocate(recommend(n + 1));
+            }
+            data()[n] = c;
+            set_size(n + 1);
+        }
+
+        void pop_back() { set_size(size() - 1); }
+
+        // Sets the size without writing the new characters, for callers that
+        // fill them in right after, as a read() into the buffer would.
+        void resize_default_init(size_type n) {
+            if (n > capacity()) {
+                reallocate(recommend(n));
+            }
+            set_size(n);
+        }
+
+        void resize(size_type n, CharT c) {
+            const size_type old_size = size();
+            resize_default_init(n);
+            CharT* p = data();
+            for (size_type i = old_size; i < n; ++i) {
+                p[i] = c;
+            }
+        }
+
+        void resize(size_type n) { resize(n, CharT()); }
+
+        void clear() { set_size(0); }
+
+        // Replaces the len characters at pos, or as many as there are, with [p, p + n).
+        basic_string& replace(size_type pos, size_type len, const CharT* p, size_type n) {
+            const size_type old_size = size();
+            if (pos > old_size) {
+                throw std::out_of_range("basic_string::replace");
+            }
+            if (len > old_size - pos) {
+                len = old_size - pos;
+            }
+            if (n && aliases(p)) {
+                const basic_string tmp(p, n);
+                return replace(pos, len, tmp.data(), n);
+            }
+            const size_type new_size = old_size - len + n;
+            if (new_size <= capacity()) {
+                CharT* d = data();
+                move_chars(d + pos + n, d + pos + len, old_size - pos - len);
+                copy_chars(d + pos, p, n);
+                set_size(new_size);
+            }
+            else {
+                const size_type cap = recommend(new_size);
+                CharT* buf = data_allocator::allocate(cap + 1);
+                const CharT* d = data();
+                copy_chars(buf, d, pos);
+                copy_chars(buf + pos, p, n);
+                copy_chars(buf + pos + n, d + pos + len, old_size - pos - len);
+                release();
+                set_long(buf, new_size, cap);
+            }
+            return *this;
+        }
+
+        basic_string& insert(size_type pos, view_type x) { return replace(pos, 0, x.data(), x.size()); }
+        basic_string& erase(size_type pos = 0, size_type n = npos) { return replace(pos, n, nullptr, 0); }
+
+        iterator erase(const_iterator position) {
+            const size_type pos = size_type(position - begin());
+            replace(pos, 1, nullptr, 0);
+            return begin() + pos;
+        }
+
+        basic_string substr(size_type pos = 0, size_type n = npos) const {
+            return basic_string(view_type(*this).substr(pos, n));
+        }
+
+        int compare(view_type x) const { return view_type(*this).compare(x); }
+        bool starts_with(view_type x) const { return view_type(*this).starts_with(x); }
+        bool ends_with(view_type x) const { return view_type(*this).ends_with(x); }
+        bool contains(view_type x) const { return view_type(*this).contains(x); }
+        bool contains(CharT c) const { return view_type(*this).contains(c); }
+        size_type find(CharT c, size_type pos = 0) const { return view_type(*this).find(c, pos); }
+        size_type find(view_type x, size_type pos = 0) const { return view_type(*this).find(x, pos); }
+        size_type rfind(CharT c, size_type pos = npos) const { return view_type(*this).rfind(c, pos); }
+
+        void swap(basic_string& x) {
+            union {
+                long_rep l;
+                unsigned char bytes[sizeof(long_rep)];
+            } tmp;
+            std::memcpy(&tmp, &rep, sizeof(rep));
+            std::memcpy(static_cast<void*>(&rep), &x.rep, sizeof(rep));
+            std::memcpy(static_cast<void*>(&x.rep), &tmp, sizeof(rep));
+        }
+
+        friend basic_string operator+(const basic_string& a, view_type b) {
+            basic_string r;
+            r.reserve(a.size() + b.size());
+            r.append(a.data(), a.size());
+            r.append(b.data(), b.size());
+            return r;
+        }
+
+        friend basic_string operator+(basic_string&& a, view_type b) {
+            a.append(b.data(), b.size());
+            return std::move(a);
+        }
+    };
+
+    template <class CharT>
+    constexpr typename basic_string<CharT>::size_type basic_string<CharT>::npos;
+
+    typedef basic_string<char> string;
+
+    template <class CharT>
+    struct __is_relocatable<basic_string<CharT>> : std::true_type {};
+
+    // Hashes the characters, so a string and a view of it hash alike.
+    template <class CharT>
+    struct hash<basic_string<CharT>> {
+        typedef basic_string<CharT>     argument_type;
+        typedef size_t                  result_type;
+
+        size_t operator()(const basic_string<CharT>& x) const {
+            return tinySTL::__hash_bytes(x.data(), x.size() * sizeof(CharT));
+        }
+    };
+}
+
+#endif // _TINY_BASIC_STRING_H_
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../btree_map.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    template <class F>
+    double ns_per_op(size_t ops, F f) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count() / double(ops);
+    }
+
+    // Random inserts, lookups of present and absent keys, then range scans
+    // of `span` consecutive entries starting at random keys. Scan cost is
+    // reported per entry visited.
+    template <class Map>
+    void run(const char* name, const std::vector<uint64_t>& keys, const std::vector<uint64_t>& probes, size_t span) {
+        Map m;
+        const double insert_ns = ns_per_op(keys.size(), [&]() {
+            for (size_t i = 0; i < keys.size(); ++i) {
+                m[keys[i]] = i;
+            }
+        });
+        const double lookup_ns = ns_per_op(probes.size(), [&]() {
+            uint64_t sum = 0;
+            for (size_t i = 0; i < probes.size(); ++i) {
+                auto it = m.find(probes[i]);
+                sum += it == m.end() ? 0 : it->second;
+            }
+            sink = sum;
+        });
+        size_t visited = 0;
+        const size_t scans = std::max<size_t>(1, probes.size() / span);
+        const double scan_total = ns_per_op(1, [&]() {
+            uint64_t sum = 0;
+            for (size_t i = 0; i < scans; ++i) {
+                auto it = m.lower_bound(probes[i]);
+                for (size_t j = 0; j < span && it != m.end(); ++j, ++it) {
+                    sum += it->second;
+                    ++visited;
+                }
+            }
+            sink = sum;
+        });
+        std::printf("%-10s %12zu %10.1f %10.1f %10.2f\n", name, keys.size(), insert_ns, lookup_ns,
+                    scan_total / double(visited ? visited : 1));
+    }
+}
+
+// Usage: btree_bench [max_n] [scan_length]
+int main(int argc, char** argv) {
+    const size_t max_n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 10000000;
+    const size_t span = argc > 2 ? std::strtoull(argv[2], 0, 10) : 100;
+    std::printf("%-10s %12s %10s %10s %10s\n", "map", "n", "insert_ns", "lookup_ns", "scan_ns");
+    std::mt19937_64 rng(42);
+    for (size_t n = 1000; n <= max_n; n *= 10) {
+        std::vector<uint64_t> keys(n);
+        for (size_t i = 0; i < n; ++i) {
+            keys[i] = rng();
+        }
+        const size_t probe_count = std::min<size_t>(n, 1000000);
+        std::vector<uint64_t> probes(probe_count);
+        for (size_t i = 0; i < probe_count; ++i) {
+            probes[i] = i % 2 ? keys[rng() % n] : rng();
+        }
+        run<tinySTL::btree_map<uint64_t, uint64_t> >("btree", keys, probes, span);
+        run<std::map<uint64_t, uint64_t> >("std::map", keys, probes, span);
+
+        std::vector<std::pair<uint64_t, uint64_t> > sorted(n);
+        for (size_t i = 0; i < n; ++i) {
+            sorted[i] = std::make_pair(keys[i], i);
+        }
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end(),
+                                 [](const std::pair<uint64_t, uint64_t>& a, const std::pair<uint64_t, uint64_t>& b) {
+                                     return a.first == b.first;
+                                 }), sorted.end());
+        const double bulk_ns = ns_per_op(sorted.size(), [&]() {
+            tinySTL::btree_map<uint64_t, uint64_t> m(tinySTL::sorted_unique, sorted.begin(), sorted.end());
+            sink = m.size();
+        });
+        std::printf("%-10s %12zu %10.1f %10s %10s\n", "bulk_load", n, bulk_ns, "-", "-");
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include "../concurrent_unordered_map.h"
+#include "../unordered_map.h"
+#include "../vector.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    uint64_t next_random(uint64_t& state) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // The single-mutex wrapper this replaces.
+    class locked_map {
+    private:
+        std::mutex lock;
+        tinySTL::unordered_map<uint64_t, uint64_t> m;
+
+    public:
+        bool find(uint64_t k, uint64_t& v) {
+            std::lock_guard<std::mutex> guard(lock);
+            tinySTL::unordered_map<uint64_t, uint64_t>::iterator it = m.find(k);
+            if (it == m.end()) {
+                return false;
+            }
+            v = it->second;
+            return true;
+        }
+
+        void insert_or_assign(uint64_t k, uint64_t v) {
+            std::lock_guard<std::mutex> guard(lock);
+            m[k] = v;
+        }
+
+        void erase(uint64_t k) {
+            std::lock_guard<std::mutex> guard(lock);
+            m.erase(k);
+        }
+    };
+
+    // Runs ops operations split over threads on keys below keys: write_pct
+    // percent are writes, half assignments and half erase-or-insert pairs
+    // that keep the size steady, and the rest lookups. Returns Mops/s.
+    template <class Map>
+    double run(Map& m, unsigned threads, size_t ops, uint64_t keys, unsigned write_pct) {
+        tinySTL::vector<std::thread> workers;
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.push_back(std::thread([&m, t, threads, ops, keys, write_pct]() {
+                uint64_t state = 0x9e3779b97f4a7c15ull * (t + 1);
+                uint64_t hits = 0;
+                for (size_t i = t; i < ops; i += threads) {
+                    const uint64_t r = next_random(state);
+                    const uint64_t k = r % keys;
+                    if ((r >> 40) % 100 >= write_pct) {
+                        uint64_t v;
+                        hits += m.find(k, v);
+                    }
+                    else if ((r >> 32) & 1) {
+                        m.insert_or_assign(k, i);
+                    }
+                    else {
+                        m.erase(k);
+                        m.insert_or_assign(k, i);
+                    }
+                }
+                sink = hits;
+            }));
+        }
+        for (size_t t = 0; t < workers.size(); ++t) {
+            workers[t].join();
+        }
+        const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return double(ops) / s / 1e6;
+    }
+}
+
+// Usage: concurrent_unordered_map_bench [keys] [ops]
+// Compares concurrent_unordered_map with a tinySTL::unordered_map behind one
+// mutex, in millions of operations per second, for 1, 2, 4, ... threads up
+// to the hardware thread count. The read-heavy mix is 95% lookups, the
+// write-heavy one 50%. Both maps start with every key present.
+int main(int argc, char** argv) {
+    const uint64_t keys = argc > 1 ? std::strtoull(argv[1], 0, 10) : 1000000;
+    const size_t ops = argc > 2 ? std::strtoull(argv[2], 0, 10) : 10000000;
+    const unsigned hw = tinySTL::hardware_concurrency();
+
+    const unsigned mixes[] = { 5, 50 };
+    std::printf("%-12s %8s %14s %14s %8s\n", "mix", "threads", "concurrent", "locked", "ratio");
+    for (unsigned mix = 0; mix < 2; ++mix) {
+        tinySTL::vector<unsigned> counts;
+        for (unsigned t = 1; t < hw; t *= 2) {
+            counts.push_back(t);
+        }
+        counts.push_back(hw);
+        for (size_t c = 0; c < counts.size(); ++c) {
+            tinySTL::concurrent_unordered_map<uint64_t, uint64_t> cm(keys);
+            locked_map lm;
+            for (uint64_t k = 0; k < keys; ++k) {
+                cm.insert_or_assign(k, k);
+                lm.insert_or_assign(k, k);
+            }
+            const double concurrent = run(cm, counts[c], ops, keys, mixes[mix]);
+            const double locked = run(lm, counts[c], ops, keys, mixes[mix]);
+            std::printf("%-12s %8u %14.2f %14.2f %8.2f\n", mixes[mix] == 5 ? "read-heavy" : "write-heavy",
+                        counts[c], concurrent, locked, concurrent / locked);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+#include "../k_way_merge.h"
+#include "../external_sort.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    double seconds_since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    size_t available_bytes() {
+        const long pages = sysconf(_SC_AVPHYS_PAGES);
+        const long page_size = sysconf(_SC_PAGESIZE);
+        return pages > 0 && page_size > 0 ? size_t(pages) * size_t(page_size) : size_t(1) << 30;
+    }
+
+    // The usual alternative to a loser tree: a binary heap of (head, run) pairs.
+    uint64_t heap_merge(const std::vector<std::vector<uint64_t>>& runs, std::vector<uint64_t>& out) {
+        typedef std::pair<uint64_t, size_t> entry;
+        std::priority_queue<entry, std::vector<entry>, std::greater<entry>> heap;
+        std::vector<size_t> pos(runs.size(), 0);
+        for (size_t i = 0; i < runs.size(); ++i) {
+            if (!runs[i].empty()) {
+                heap.push(entry(runs[i][0], i));
+            }
+        }
+        size_t n = 0;
+        while (!heap.empty()) {
+            const entry e = heap.top();
+            heap.pop();
+            out[n++] = e.first;
+            if (++pos[e.second] < runs[e.second].size()) {
+                heap.push(entry(runs[e.second][pos[e.second]], e.second));
+            }
+        }
+        return out[n - 1];
+    }
+
+    void merge_table(size_t n) {
+        std::printf("%8s %12s %14s %14s\n", "k", "n", "loser_tree_ms", "binary_heap_ms");
+        std::mt19937_64 rng(7);
+        for (size_t k = 2; k <= 1024; k *= 4) {
+            std::vector<std::vector<uint64_t>> runs(k);
+            for (size_t i = 0; i < n; ++i) {
+                runs[rng() % k].push_back(rng());
+            }
+            for (size_t i = 0; i < k; ++i) {
+                std::sort(runs[i].begin(), runs[i].end());
+            }
+            std::vector<uint64_t> out(n);
+            auto start = std::chrono::steady_clock::now();
+            tinySTL::k_way_merge(runs.begin(), runs.end(), out.data());
+            const double loser_ms = seconds_since(start) * 1000;
+            sink = out[n - 1];
+            start = std::chrono::steady_clock::now();
+            sink = heap_merge(runs, out);
+            const double heap_ms = seconds_since(start) * 1000;
+            std::printf("%8zu %12zu %14.3f %14.3f\n", k, n, loser_ms, heap_ms);
+        }
+    }
+
+    void write_random_file(const std::string& path, size_t records) {
+        FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) {
+            std::perror(path.c_str());
+            std::exit(1);
+        }
+        std::mt19937_64 rng(42);
+        std::vector<uint64_t> block(1 << 20);
+        for (size_t done = 0; done < records; ) {
+            const size_t n = std::min(block.size(), records - done);
+            for (size_t i = 0; i < n; ++i) {
+                block[i] = rng();
+            }
+            std::fwrite(block.data(), sizeof(uint64_t), n, f);
+            done += n;
+        }
+        std::fclose(f);
+    }
+
+    bool is_sorted_file(const std::string& path, size_t records) {
+        FILE* f = std::fopen(path.c_str(), "rb");
+        std::vector<uint64_t> block(1 << 20);
+        uint64_t prev = 0;
+        size_t seen = 0;
+        for (size_t n; f && (n = std::fread(block.data(), sizeof(uint64_t), block.size(), f)) > 0; seen += n) {
+            for (size_t i = 0; i < n; ++i) {
+                if (block[i] < prev) {
+                    std::fclose(f);
+                    return false;
+                }
+                prev = block[i];
+            }
+        }
+        if (f) {
+            std::fclose(f);
+        }
+        return seen == records;
+    }
+}
+
+// Usage: external_sort_bench [data_bytes] [memory_bytes] [temp_dir]
+// Defaults to sorting four times the available RAM with half of it as the
+// budget, in the current directory; pick a temp_dir on a local disk.
+int main(int argc, char** argv) {
+    const size_t available = available_bytes();
+    const size_t data_bytes = argc > 1 ? std::strtoull(argv[1], 0, 10) : 4 * available;
+    const size_t memory_bytes = argc > 2 ? std::strtoull(argv[2], 0, 10) : available / 2;
+    const std::string dir = argc > 3 ? argv[3] : ".";
+    const size_t records = data_bytes / sizeof(uint64_t);
+
+    merge_table(std::min<size_t>(records, 1 << 24));
+
+    const std::string input = dir + "/external_sort_bench.in";
+    const std::string output = dir + "/external_sort_bench.out";
+    auto start = std::chrono::steady_clock::now();
+    write_random_file(input, records);
+    const double write_s = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    tinySTL::external_sort<uint64_t>(input.c_str(), output.c_str(), memory_bytes, tinySTL::less<uint64_t>(),
+                                     dir.c_str());
+    const double sort_s = seconds_since(start);
+    const bool sorted = is_sorted_file(output, records);
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+
+    const double mb = double(records * sizeof(uint64_t)) / (1 << 20);
+    std::printf("\n%14s %14s %10s %10s %10s %8s\n", "data_mb", "budget_mb", "write_s", "sort_s", "sort_mb/s",
+                "sorted");
+    std::printf("%14.1f %14.1f %10.2f %10.2f %10.1f %8s\n", mb, double(memory_bytes) / (1 << 20), write_s,
+                sort_s, mb / sort_s, sorted ? "yes" : "NO");
+    return sorted ? 0 : 1;
+}
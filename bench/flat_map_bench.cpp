@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+#include "../flat_map.h"
+#include "../eytzinger.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    // Mean nanoseconds per lookup over all probes, best of three runs.
+    template <class Lookup>
+    double ns_per_lookup(const std::vector<uint32_t>& probes, Lookup lookup) {
+        double best = 1e300;
+        for (int r = 0; r < 3; ++r) {
+            uint64_t sum = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < probes.size(); ++i) {
+                sum += lookup(probes[i]);
+            }
+            auto stop = std::chrono::steady_clock::now();
+            sink = sum;
+            best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count() / probes.size());
+        }
+        return best;
+    }
+
+    template <class Build>
+    double build_ms(Build build) {
+        auto start = std::chrono::steady_clock::now();
+        build();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(stop - start).count();
+    }
+}
+
+// Usage: flat_map_bench [max_n]
+int main(int argc, char** argv) {
+    const size_t max_n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 10000000;
+    const size_t probe_count = 1000000;
+    std::printf("%12s %10s %10s %10s %10s %10s %10s\n", "n", "build_flat", "build_map",
+                "std_map_ns", "flat_ns", "eytz_ns", "std_lb_ns");
+    std::mt19937 rng(42);
+    for (size_t n = 1000; n <= max_n; n *= 10) {
+        std::vector<std::pair<uint32_t, uint32_t> > items(n);
+        for (size_t i = 0; i < n; ++i) {
+            items[i] = std::make_pair(uint32_t(rng()), uint32_t(i));
+        }
+        std::vector<uint32_t> probes(probe_count);
+        for (size_t i = 0; i < probe_count; ++i) {
+            probes[i] = i % 2 ? items[rng() % n].first : uint32_t(rng());
+        }
+
+        tinySTL::flat_map<uint32_t, uint32_t> flat;
+        std::map<uint32_t, uint32_t> tree;
+        const double flat_build = build_ms([&]() {
+            flat = tinySTL::flat_map<uint32_t, uint32_t>(items.begin(), items.end());
+        });
+        const double tree_build = build_ms([&]() { tree.insert(items.begin(), items.end()); });
+        tinySTL::eytzinger_map<uint32_t, uint32_t> eytz(flat);
+        std::vector<uint32_t> keys;
+        for (auto it = flat.begin(); it != flat.end(); ++it) {
+            keys.push_back(it->first);
+        }
+
+        const double tree_ns = ns_per_lookup(probes, [&](uint32_t k) -> uint64_t {
+            auto it = tree.find(k);
+            return it == tree.end() ? 0 : it->second;
+        });
+        const double flat_ns = ns_per_lookup(probes, [&](uint32_t k) -> uint64_t {
+            auto it = flat.find(k);
+            return it == flat.end() ? 0 : it->second;
+        });
+        const double eytz_ns = ns_per_lookup(probes, [&](uint32_t k) -> uint64_t {
+            auto it = eytz.find(k);
+            return it == eytz.end() ? 0 : it->second;
+        });
+        const double std_lb_ns = ns_per_lookup(probes, [&](uint32_t k) -> uint64_t {
+            return uint64_t(std::lower_bound(keys.begin(), keys.end(), k) - keys.begin());
+        });
+        std::printf("%12zu %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n", n, flat_build, tree_build,
+                    tree_ns, flat_ns, eytz_ns, std_lb_ns);
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "../delta_vector.h"
+#include "../packed_vector.h"
+#include "../vector.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    uint64_t next_random(uint64_t& state) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    template <class F>
+    double time_ns(size_t ops, F f) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count() / double(ops);
+    }
+
+    // The uncompressed scan, as GB/s of the 8-byte values it hands out.
+    double gbps(double ns_per_value) { return 8.0 / ns_per_value; }
+
+    // plain_ns is 0 where the plain vector has no equivalent to time.
+    void report(const char* name, double ns, double plain_ns) {
+        if (plain_ns > 0) {
+            std::printf("%-34s %12.3f %12.2f %12.3f\n", name, ns, gbps(ns), plain_ns);
+        }
+        else {
+            std::printf("%-34s %12.3f %12.2f %12s\n", name, ns, gbps(ns), "-");
+        }
+    }
+
+    void report_size(const char* name, size_t bytes, size_t plain_bytes) {
+        std::printf("%-34s %12.2f MB %9.2fx smaller\n", name, double(bytes) / 1e6, double(plain_bytes) / double(bytes));
+    }
+
+    template <class V>
+    uint64_t random_reads(const V& v, size_t n, size_t reads) {
+        uint64_t state = 7, sum = 0;
+        for (size_t i = 0; i < reads; ++i) {
+            sum += v[size_t(next_random(state) % n)];
+        }
+        return sum;
+    }
+}
+
+// Usage: packed_vector_bench [n]
+// Builds n (50M by default) random 20-bit ids as a packed_vector and n
+// sorted offsets with gaps below 64 as a delta_vector, then reports their
+// size against a vector<uint64_t> of the same values and times, in ns per
+// value, a full scan and n / 10 random reads of each. GB/s is the rate at
+// which a scan produces 8-byte values.
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 50000000;
+    const size_t reads = n / 10 ? n / 10 : 1;
+
+    tinySTL::vector<uint64_t> ids, offsets;
+    ids.reserve(n);
+    offsets.reserve(n);
+    uint64_t state = 42, offset = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const uint64_t r = next_random(state);
+        ids.push_back(r & 0xfffff);
+        offset += (r >> 32) & 63;
+        offsets.push_back(offset);
+    }
+    const size_t plain_bytes = n * sizeof(uint64_t);
+
+    const tinySTL::packed_vector packed(ids);
+    const tinySTL::delta_vector delta(offsets);
+    report_size("packed_vector (20-bit ids)", packed.bytes(), plain_bytes);
+    report_size("delta_vector (sorted, gaps < 64)", delta.bytes(), plain_bytes);
+    std::printf("\n%-34s %12s %12s %12s\n", "benchmark", "ns/value", "GB/s", "vector_ns");
+
+    const double ids_plain = time_ns(n, [&]() {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += ids[i];
+        }
+        sink = sum;
+    });
+    report("packed_vector scan (for_each)", time_ns(n, [&]() {
+        uint64_t sum = 0;
+        packed.for_each([&sum](uint64_t x) { sum += x; });
+        sink = sum;
+    }), ids_plain);
+    report("packed_vector scan (iterator)", time_ns(n, [&]() {
+        uint64_t sum = 0;
+        for (tinySTL::packed_vector::const_iterator it = packed.begin(); it != packed.end(); ++it) {
+            sum += *it;
+        }
+        sink = sum;
+    }), ids_plain);
+    tinySTL::vector<uint64_t> out(n, uint64_t(0));
+    report("packed_vector decode", time_ns(n, [&]() {
+        packed.decode(out.begin());
+        sink = out[n - 1];
+    }), 0);
+    report("packed_vector random read", time_ns(reads, [&]() { sink = random_reads(packed, n, reads); }),
+           time_ns(reads, [&]() { sink = random_reads(ids, n, reads); }));
+
+    const double offsets_plain = time_ns(n, [&]() {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += offsets[i];
+        }
+        sink = sum;
+    });
+    report("delta_vector scan (for_each)", time_ns(n, [&]() {
+        uint64_t sum = 0;
+        delta.for_each([&sum](uint64_t x) { sum += x; });
+        sink = sum;
+    }), offsets_plain);
+    report("delta_vector scan (iterator)", time_ns(n, [&]() {
+        uint64_t sum = 0;
+        for (tinySTL::delta_vector::const_iterator it = delta.begin(); it != delta.end(); ++it) {
+            sum += *it;
+        }
+        sink = sum;
+    }), offsets_plain);
+    report("delta_vector decode", time_ns(n, [&]() {
+        delta.decode(out.begin());
+        sink = out[n - 1];
+    }), 0);
+    report("delta_vector random read", time_ns(reads, [&]() { sink = random_reads(delta, n, reads); }),
+           time_ns(reads, [&]() { sink = random_reads(offsets, n, reads); }));
+    report("delta_vector lower_bound", time_ns(reads, [&]() {
+        uint64_t s = 11, sum = 0;
+        for (size_t i = 0; i < reads; ++i) {
+            sum += delta.lower_bound(next_random(s) % (offset + 1));
+        }
+        sink = sum;
+    }), time_ns(reads, [&]() {
+        uint64_t s = 11, sum = 0;
+        for (size_t i = 0; i < reads; ++i) {
+            sum += size_t(tinySTL::lower_bound(offsets.begin(), offsets.end(), next_random(s) % (offset + 1)) - offsets.begin());
+        }
+        sink = sum;
+    }));
+    return 0;
+}
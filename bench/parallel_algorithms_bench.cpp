@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "../vector.h"
+#include "../deque.h"
+#include "../parallel.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    template <class F>
+    double time_ms(F f) {
+        double best = 1e300;
+        for (int r = 0; r < 3; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            f();
+            auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(stop - start).count());
+        }
+        return best;
+    }
+
+    template <class Container, class Run>
+    void scale(const char* range, const char* op, size_t n, unsigned max_threads, Run run) {
+        double base = 0;
+        for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+            const tinySTL::execution::parallel_policy policy(threads);
+            const double ms = time_ms([&]() { run(policy); });
+            if (threads == 1) {
+                base = ms;
+            }
+            std::printf("%-8s %-16s %12zu %8u %10.2f %8.2f %10.2f\n", range, op, n, threads, ms,
+                        base / ms, base / ms / threads);
+            if (threads < max_threads && threads * 2 > max_threads) {
+                threads = max_threads / 2;
+            }
+        }
+    }
+
+    template <class Container>
+    void run(const char* range, size_t n, unsigned max_threads) {
+        Container in;
+        Container out;
+        for (size_t i = 0; i < n; ++i) {
+            in.push_back(uint64_t(i * 2654435761u % 1000));
+            out.push_back(0);
+        }
+        typedef tinySTL::execution::parallel_policy policy_type;
+
+        scale<Container>(range, "for_each", n, max_threads, [&](const policy_type& p) {
+            tinySTL::for_each(p, out.begin(), out.end(), [](uint64_t& x) { x = x * 3 + 1; });
+        });
+        scale<Container>(range, "transform", n, max_threads, [&](const policy_type& p) {
+            tinySTL::transform(p, in.begin(), in.end(), out.begin(), [](uint64_t x) { return x * x + 7; });
+        });
+        scale<Container>(range, "reduce", n, max_threads, [&](const policy_type& p) {
+            sink = tinySTL::reduce(p, in.begin(), in.end(), uint64_t(0));
+        });
+        scale<Container>(range, "inclusive_scan", n, max_threads, [&](const policy_type& p) {
+            tinySTL::inclusive_scan(p, in.begin(), in.end(), out.begin());
+        });
+        scale<Container>(range, "exclusive_scan", n, max_threads, [&](const policy_type& p) {
+            tinySTL::exclusive_scan(p, in.begin(), in.end(), out.begin(), uint64_t(0));
+        });
+        scale<Container>(range, "count_if", n, max_threads, [&](const policy_type& p) {
+            sink = uint64_t(tinySTL::count_if(p, in.begin(), in.end(), [](uint64_t x) { return x % 3 == 0; }));
+        });
+        scale<Container>(range, "fill", n, max_threads, [&](const policy_type& p) {
+            tinySTL::fill(p, out.begin(), out.end(), uint64_t(42));
+        });
+    }
+}
+
+// Usage: parallel_algorithms_bench [n] [max_threads]
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 50000000;
+    const unsigned max_threads = argc > 2 ? unsigned(std::atoi(argv[2])) : tinySTL::hardware_concurrency();
+    std::printf("%-8s %-16s %12s %8s %10s %8s %10s\n", "range", "op", "n", "threads", "ms", "speedup", "efficiency");
+    run<tinySTL::vector<uint64_t>>("vector", n, max_threads);
+    run<tinySTL::deque<uint64_t>>("deque", n, max_threads);
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include "../vector.h"
+#include "../deque.h"
+#include "../parallel.h"
+
+namespace {
+    template <class Container>
+    void fill_random(Container& c, size_t n) {
+        std::mt19937_64 rng(12345);
+        for (size_t i = 0; i < n; ++i) {
+            c.push_back(uint64_t(rng()));
+        }
+    }
+
+    template <class Iterator>
+    bool sorted(Iterator first, Iterator last) {
+        for (Iterator next = first; first != last && ++next != last; ++first) {
+            if (*next < *first) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class Container>
+    void run(const char* name, const Container& input, unsigned max_threads) {
+        double base = 0;
+        for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+            Container work(input);
+            auto start = std::chrono::steady_clock::now();
+            tinySTL::parallel_sort(work.begin(), work.end(), tinySTL::less<uint64_t>(), threads);
+            auto stop = std::chrono::steady_clock::now();
+            const double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+            if (threads == 1) {
+                base = ms;
+            }
+            if (!sorted(work.begin(), work.end())) {
+                std::fprintf(stderr, "%s: unsorted output with %u threads\n", name, threads);
+                std::exit(1);
+            }
+            std::printf("%-8s %12zu %8u %12.1f %8.2f %10.2f\n", name, size_t(input.size()), threads, ms,
+                        base / ms, base / ms / threads);
+            if (threads < max_threads && threads * 2 > max_threads) {
+                threads = max_threads / 2;
+            }
+        }
+    }
+}
+
+// Usage: parallel_sort_bench [n] [max_threads]
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 50000000;
+    const unsigned max_threads = argc > 2 ? unsigned(std::atoi(argv[2])) : tinySTL::hardware_concurrency();
+    std::printf("%-8s %12s %8s %12s %8s %10s\n", "range", "n", "threads", "ms", "speedup", "efficiency");
+
+    tinySTL::vector<uint64_t> v;
+    fill_random(v, n);
+    run("vector", v, max_threads);
+
+    tinySTL::deque<uint64_t> d;
+    fill_random(d, n);
+    run("deque", d, max_threads);
+    return 0;
+}
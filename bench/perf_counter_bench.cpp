@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+#include "../algorithm.h"
+#include "../deque.h"
+#include "../list.h"
+#include "../perf_counter.h"
+#include "../vector.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    struct options {
+        size_t n;
+        size_t repeat;
+        std::string filter;
+        std::string json_path;
+    };
+
+    struct result {
+        std::string name;
+        std::string impl;
+        size_t ops;
+        tinySTL::perf_sample sample;
+    };
+
+    std::vector<result> results;
+
+    // Runs setup outside the counters and body inside them, repeat times,
+    // and reports the totals per operation; body does ops operations.
+    template <class State, class Setup, class Body>
+    void profile(const options& opt, tinySTL::perf_counters& counters, const char* name, const char* impl,
+                 size_t ops, Setup setup, Body body) {
+        if (!opt.filter.empty() && std::strstr(name, opt.filter.c_str()) == nullptr) {
+            return;
+        }
+        tinySTL::perf_sample total;
+        for (size_t r = 0; r < opt.repeat; ++r) {
+            State s;
+            setup(s);
+            tinySTL::perf_probe probe(counters, total);
+            body(s);
+        }
+        const uint64_t n = uint64_t(ops) * total.regions;
+        std::printf("%-20s %-8s %9.2f", name, impl, total.ns_per_op(n));
+        for (int i = 0; i < tinySTL::perf_event_count; ++i) {
+            const tinySTL::perf_event e = tinySTL::perf_event(i);
+            if (total.valid(e)) {
+                std::printf(" %10.3f", total.per_op(e, n));
+            }
+            else {
+                std::printf(" %10s", "-");
+            }
+        }
+        if (total.ipc() > 0) {
+            std::printf(" %6.2f\n", total.ipc());
+        }
+        else {
+            std::printf(" %6s\n", "-");
+        }
+        std::fflush(stdout);
+        result res = { name, impl, ops, total };
+        results.push_back(res);
+    }
+
+    template <class Vector>
+    void vector_push_back(const options& opt, tinySTL::perf_counters& counters, const char* impl,
+                          const std::vector<uint64_t>& src) {
+        profile<Vector>(opt, counters, "vector/push_back", impl, src.size(), [](Vector&) {}, [&](Vector& v) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                v.push_back(src[i]);
+            }
+        });
+    }
+
+    template <class List>
+    void list_push_back(const options& opt, tinySTL::perf_counters& counters, const char* impl,
+                        const std::vector<uint64_t>& src) {
+        profile<List>(opt, counters, "list/push_back", impl, src.size(), [](List&) {}, [&](List& l) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                l.push_back(src[i]);
+            }
+        });
+    }
+
+    template <class List>
+    void list_sort(const options& opt, tinySTL::perf_counters& counters, const char* impl,
+                   const std::vector<uint64_t>& src) {
+        profile<List>(opt, counters, "list/sort", impl, src.size(), [&](List& l) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                l.push_back(src[i]);
+            }
+        }, [](List& l) { l.sort(); });
+    }
+
+    // After a sort successive nodes are scattered, so each step is a
+    // dependent load that usually misses.
+    template <class List>
+    void list_traversal(const options& opt, tinySTL::perf_counters& counters, const char* impl,
+                        const std::vector<uint64_t>& src) {
+        profile<List>(opt, counters, "list/traversal", impl, src.size(), [&](List& l) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                l.push_back(src[i]);
+            }
+            l.sort();
+        }, [](List& l) {
+            uint64_t sum = 0;
+            for (auto it = l.begin(); it != l.end(); ++it) {
+                sum += *it;
+            }
+            sink = sum;
+        });
+    }
+
+    template <class Deque>
+    void deque_push_back(const options& opt, tinySTL::perf_counters& counters, const char* impl,
+                         const std::vector<uint64_t>& src) {
+        profile<Deque>(opt, counters, "deque/push_back", impl, src.size(), [](Deque&) {}, [&](Deque& d) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                d.push_back(src[i]);
+            }
+        });
+    }
+
+    // operator[] goes through the iterator's operator+=, which splits the
+    // offset into a node and a position within it.
+    template <class Deque>
+    void deque_random_access(const options& opt, tinySTL::perf_counters& counters, const char* impl,
+                             const std::vector<uint64_t>& src, const std::vector<uint32_t>& index) {
+        profile<Deque>(opt, counters, "deque/random_access", impl, index.size(), [&](Deque& d) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                d.push_back(src[i]);
+            }
+        }, [&](Deque& d) {
+            uint64_t sum = 0;
+            for (size_t i = 0; i < index.size(); ++i) {
+                sum += d[index[i]];
+            }
+            sink = sum;
+        });
+    }
+
+    template <class Deque>
+    void deque_iterate(const options& opt, tinySTL::perf_counters& counters, const char* impl,
+                       const std::vector<uint64_t>& src) {
+        profile<Deque>(opt, counters, "deque/iterate", impl, src.size(), [&](Deque& d) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                d.push_back(src[i]);
+            }
+        }, [](Deque& d) {
+            uint64_t sum = 0;
+            for (auto it = d.begin(); it != d.end(); ++it) {
+                sum += *it;
+            }
+            sink = sum;
+        });
+    }
+
+    template <bool Tiny>
+    void sort_random(const options& opt, tinySTL::perf_counters& counters, const char* impl,
+                     const std::vector<uint64_t>& src) {
+        typedef std::vector<uint64_t> State;
+        profile<State>(opt, counters, "sort", impl, src.size(), [&](State& s) { s = src; }, [](State& s) {
+            if (Tiny) {
+                tinySTL::sort(s.data(), s.data() + s.size());
+            }
+            else {
+                std::sort(s.data(), s.data() + s.size());
+            }
+        });
+    }
+
+    template <bool Tiny>
+    void stable_sort_random(const options& opt, tinySTL::perf_counters& counters, const char* impl,
+                            const std::vector<uint64_t>& src) {
+        typedef std::vector<uint64_t> State;
+        profile<State>(opt, counters, "stable_sort", impl, src.size(), [&](State& s) { s = src; }, [](State& s) {
+            if (Tiny) {
+                tinySTL::stable_sort(s.data(), s.data() + s.size());
+            }
+            else {
+                std::stable_sort(s.data(), s.data() + s.size());
+            }
+        });
+    }
+
+    template <bool Tiny>
+    void nth_element_random(const options& opt, tinySTL::perf_counters& counters, const char* impl,
+                            const std::vector<uint64_t>& src) {
+        typedef std::vector<uint64_t> State;
+        profile<State>(opt, counters, "nth_element", impl, src.size(), [&](State& s) { s = src; }, [](State& s) {
+            uint64_t* mid = s.data() + s.size() / 2;
+            if (Tiny) {
+                tinySTL::nth_element(s.data(), mid, s.data() + s.size());
+            }
+            else {
+                std::nth_element(s.data(), mid, s.data() + s.size());
+            }
+        });
+    }
+
+    void write_json(const options& opt) {
+        FILE* f = opt.json_path == "-" ? stdout : std::fopen(opt.json_path.c_str(), "w");
+        if (!f) {
+            std::perror(opt.json_path.c_str());
+            std::exit(1);
+        }
+        std::fprintf(f, "{\n  \"suite\": \"perf_counter_bench\",\n  \"schema_version\": 1,\n  \"n\": %zu,\n", opt.n);
+        std::fprintf(f, "  \"unit\": \"per_op\",\n  \"results\": [\n");
+        for (size_t i = 0; i < results.size(); ++i) {
+            const result& r = results[i];
+            const uint64_t n = uint64_t(r.ops) * r.sample.regions;
+            std::fprintf(f, "    {\"name\": \"%s\", \"impl\": \"%s\", \"ops\": %zu, \"regions\": %llu, \"ns\": %.4f",
+                         r.name.c_str(), r.impl.c_str(), r.ops, static_cast<unsigned long long>(r.sample.regions),
+                         r.sample.ns_per_op(n));
+            for (int j = 0; j < tinySTL::perf_event_count; ++j) {
+                const tinySTL::perf_event e = tinySTL::perf_event(j);
+                if (r.sample.valid(e)) {
+                    std::fprintf(f, ", \"%s\": %.4f", tinySTL::perf_event_name(e), r.sample.per_op(e, n));
+                }
+                else {
+                    std::fprintf(f, ", \"%s\": null", tinySTL::perf_event_name(e));
+                }
+            }
+            std::fprintf(f, "}%s\n", i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(f, "  ]\n}\n");
+        if (f != stdout) {
+            std::fclose(f);
+        }
+    }
+
+    void usage() {
+        std::fprintf(stderr, "usage: perf_counter_bench [--n N] [--repeat R] [--filter SUBSTR] [--json PATH|-]\n");
+        std::exit(2);
+    }
+}
+
+// Usage: perf_counter_bench [--n N] [--repeat R] [--filter SUBSTR] [--json PATH]
+// Profiles tinySTL containers and algorithms against std:: with hardware
+// counters and prints each counter per element operation, n = 10^6 by
+// default. Counters the system won't provide print as "-"; the wall-clock
+// column is always there.
+int main(int argc, char** argv) {
+    options opt = { 1000000, 5, "", "" };
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+        }
+        const char* value = argv[++i];
+        if (arg == "--n") {
+            opt.n = std::max<size_t>(1, std::strtoull(value, 0, 10));
+        }
+        else if (arg == "--repeat") {
+            opt.repeat = std::max<size_t>(1, std::strtoull(value, 0, 10));
+        }
+        else if (arg == "--filter") {
+            opt.filter = value;
+        }
+        else if (arg == "--json") {
+            opt.json_path = value;
+        }
+        else {
+            usage();
+        }
+    }
+
+    tinySTL::perf_counters counters;
+    if (counters.error() != 0) {
+        std::fprintf(stderr, "perf_counter_bench: %s counters: %s\n",
+                     counters.available() ? "some" : "no", counters.error_message());
+    }
+
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> src(opt.n);
+    std::vector<uint32_t> index(opt.n);
+    for (size_t i = 0; i < opt.n; ++i) {
+        src[i] = rng();
+        index[i] = uint32_t(rng() % opt.n);
+    }
+
+    std::printf("%-20s %-8s %9s", "benchmark", "impl", "ns");
+    for (int i = 0; i < tinySTL::perf_event_count; ++i) {
+        std::printf(" %10s", tinySTL::perf_event_name(tinySTL::perf_event(i)));
+    }
+    std::printf(" %6s\n", "IPC");
+
+    vector_push_back<tinySTL::vector<uint64_t>>(opt, counters, "tinySTL", src);
+    vector_push_back<std::vector<uint64_t>>(opt, counters, "std", src);
+    list_push_back<tinySTL::list<uint64_t>>(opt, counters, "tinySTL", src);
+    list_push_back<std::list<uint64_t>>(opt, counters, "std", src);
+    list_sort<tinySTL::list<uint64_t>>(opt, counters, "tinySTL", src);
+    list_sort<std::list<uint64_t>>(opt, counters, "std", src);
+    list_traversal<tinySTL::list<uint64_t>>(opt, counters, "tinySTL", src);
+    list_traversal<std::list<uint64_t>>(opt, counters, "std", src);
+    deque_push_back<tinySTL::deque<uint64_t>>(opt, counters, "tinySTL", src);
+    deque_push_back<std::deque<uint64_t>>(opt, counters, "std", src);
+    deque_random_access<tinySTL::deque<uint64_t>>(opt, counters, "tinySTL", src, index);
+    deque_random_access<std::deque<uint64_t>>(opt, counters, "std", src, index);
+    deque_iterate<tinySTL::deque<uint64_t>>(opt, counters, "tinySTL", src);
+    deque_iterate<std::deque<uint64_t>>(opt, counters, "std", src);
+    sort_random<true>(opt, counters, "tinySTL", src);
+    sort_random<false>(opt, counters, "std", src);
+    stable_sort_random<true>(opt, counters, "tinySTL", src);
+    stable_sort_random<false>(opt, counters, "std", src);
+    nth_element_random<true>(opt, counters, "tinySTL", src);
+    nth_element_random<false>(opt, counters, "std", src);
+
+    if (!opt.json_path.empty()) {
+        write_json(opt);
+    }
+    return 0;
+}
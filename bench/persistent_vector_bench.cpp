@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include "../persistent_vector.h"
+#include "../vector.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    template <class F>
+    double time_ns(size_t ops, F f) {
+        double best = 1e300;
+        for (int r = 0; r < 3; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            f();
+            auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count() / double(ops));
+        }
+        return best;
+    }
+
+    // vector_ns is 0 where tinySTL::vector has nothing comparable.
+    void report(const char* name, double persistent_ns, double vector_ns) {
+        if (vector_ns > 0) {
+            std::printf("%-28s %14.2f %12.2f\n", name, persistent_ns, vector_ns);
+        }
+        else {
+            std::printf("%-28s %14.2f %12s\n", name, persistent_ns, "-");
+        }
+    }
+}
+
+// Usage: persistent_vector_bench [n]
+// Times persistent_vector against tinySTL::vector in ns per operation on n
+// uint64_t elements (1M by default): taking a snapshot (a copy), appending
+// with and without a transient, single-element updates that keep the old
+// version, random reads and a full scan.
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 1000000;
+    std::mt19937_64 rng(42);
+    tinySTL::vector<size_t> idx;
+    for (size_t i = 0; i < n; ++i) {
+        idx.push_back(size_t(rng() % n));
+    }
+
+    tinySTL::vector<uint64_t> v;
+    tinySTL::transient_vector<uint64_t> t;
+    for (size_t i = 0; i < n; ++i) {
+        v.push_back(i);
+        t.push_back(i);
+    }
+    const tinySTL::persistent_vector<uint64_t> p = t.persistent();
+
+    std::printf("%-28s %14s %12s\n", "benchmark", "persistent_ns", "vector_ns");
+    report("snapshot (whole copy)", time_ns(1, [&]() {
+        tinySTL::persistent_vector<uint64_t> copy(p);
+        sink = copy.size();
+    }), time_ns(1, [&]() {
+        tinySTL::vector<uint64_t> copy(v);
+        sink = copy.size();
+    }));
+    report("push_back, persistent", time_ns(n, [&]() {
+        tinySTL::persistent_vector<uint64_t> q;
+        for (size_t i = 0; i < n; ++i) {
+            q = q.push_back(i);
+        }
+        sink = q.size();
+    }), time_ns(n, [&]() {
+        tinySTL::vector<uint64_t> w;
+        for (size_t i = 0; i < n; ++i) {
+            w.push_back(i);
+        }
+        sink = w.size();
+    }));
+    report("push_back, transient", time_ns(n, [&]() {
+        tinySTL::transient_vector<uint64_t> b;
+        for (size_t i = 0; i < n; ++i) {
+            b.push_back(i);
+        }
+        sink = b.persistent().size();
+    }), 0);
+    report("set, keeping the old version", time_ns(n, [&]() {
+        tinySTL::persistent_vector<uint64_t> q = p;
+        for (size_t i = 0; i < n; ++i) {
+            q = q.set(idx[i], i);
+        }
+        sink = q[0];
+    }), time_ns(n, [&]() {
+        tinySTL::vector<uint64_t> w = v;
+        for (size_t i = 0; i < n; ++i) {
+            w[idx[i]] = i;
+        }
+        sink = w[0];
+    }));
+    report("set, transient", time_ns(n, [&]() {
+        tinySTL::transient_vector<uint64_t> b = p.transient();
+        for (size_t i = 0; i < n; ++i) {
+            b.set(idx[i], i);
+        }
+        sink = b[0];
+    }), 0);
+    report("random read", time_ns(n, [&]() {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += p[idx[i]];
+        }
+        sink = sum;
+    }), time_ns(n, [&]() {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += v[idx[i]];
+        }
+        sink = sum;
+    }));
+    report("scan", time_ns(n, [&]() {
+        uint64_t sum = 0;
+        for (auto it = p.begin(); it != p.end(); ++it) {
+            sum += *it;
+        }
+        sink = sum;
+    }), time_ns(n, [&]() {
+        uint64_t sum = 0;
+        for (auto it = v.begin(); it != v.end(); ++it) {
+            sum += *it;
+        }
+        sink = sum;
+    }));
+    return 0;
+}
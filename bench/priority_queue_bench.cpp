@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <random>
+#include <vector>
+#include "../queue.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    template <class F>
+    double time_ms(F f) {
+        double best = 1e300;
+        for (int r = 0; r < 3; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            f();
+            auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(stop - start).count());
+        }
+        return best;
+    }
+
+    // n pushes followed by n pops.
+    template <class Queue>
+    double push_pop(const std::vector<uint64_t>& keys) {
+        return time_ms([&]() {
+            Queue q;
+            for (size_t i = 0; i < keys.size(); ++i) {
+                q.push(keys[i]);
+            }
+            uint64_t sum = 0;
+            while (!q.empty()) {
+                sum += q.top();
+                q.pop();
+            }
+            sink = sum;
+        });
+    }
+
+    // Steady state of a timer queue: each pop is followed by a push.
+    template <class Queue>
+    double hold(const std::vector<uint64_t>& keys) {
+        return time_ms([&]() {
+            Queue q;
+            for (size_t i = 0; i < keys.size(); ++i) {
+                q.push(keys[i]);
+            }
+            uint64_t sum = 0;
+            for (size_t i = 0; i < keys.size(); ++i) {
+                const uint64_t top = q.top();
+                sum += top;
+                q.pop();
+                q.push(top ^ keys[i]);
+            }
+            sink = sum;
+        });
+    }
+
+    template <size_t Arity>
+    double bulk(const std::vector<uint64_t>& keys) {
+        return time_ms([&]() {
+            tinySTL::priority_queue<uint64_t, tinySTL::vector<uint64_t>, tinySTL::less<uint64_t>, Arity> q;
+            q.push_range(keys.begin(), keys.end());
+            sink = q.top();
+        });
+    }
+}
+
+// Usage: priority_queue_bench [max_n]
+int main(int argc, char** argv) {
+    typedef tinySTL::priority_queue<uint64_t, tinySTL::vector<uint64_t>, tinySTL::less<uint64_t>, 2> binary;
+    typedef tinySTL::priority_queue<uint64_t, tinySTL::vector<uint64_t>, tinySTL::less<uint64_t>, 4> quaternary;
+    typedef tinySTL::priority_queue<uint64_t, tinySTL::vector<uint64_t>, tinySTL::less<uint64_t>, 8> octonary;
+    typedef std::priority_queue<uint64_t> standard;
+
+    const size_t max_n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 10000000;
+    std::printf("%-10s %12s %10s %10s %10s %10s\n", "workload", "n", "2ary_ms", "4ary_ms", "8ary_ms", "std_ms");
+    std::mt19937_64 rng(42);
+    for (size_t n = 1000; n <= max_n; n *= 10) {
+        std::vector<uint64_t> keys(n);
+        for (size_t i = 0; i < n; ++i) {
+            keys[i] = rng();
+        }
+        std::printf("%-10s %12zu %10.3f %10.3f %10.3f %10.3f\n", "push_pop", n,
+                    push_pop<binary>(keys), push_pop<quaternary>(keys), push_pop<octonary>(keys),
+                    push_pop<standard>(keys));
+        std::printf("%-10s %12zu %10.3f %10.3f %10.3f %10.3f\n", "hold", n,
+                    hold<binary>(keys), hold<quaternary>(keys), hold<octonary>(keys), hold<standard>(keys));
+        std::printf("%-10s %12zu %10.3f %10.3f %10.3f %10s\n", "heapify", n,
+                    bulk<2>(keys), bulk<4>(keys), bulk<8>(keys), "-");
+    }
+    return 0;
+}
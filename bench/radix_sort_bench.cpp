@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../algorithm.h"
+#include "../radix_sort.h"
+
+namespace {
+    struct record {
+        unsigned int key;
+        unsigned int payload;
+    };
+
+    struct record_key {
+        unsigned int operator()(const record& r) const { return r.key; }
+    };
+
+    struct record_less {
+        bool operator()(const record& a, const record& b) const { return a.key < b.key; }
+    };
+
+    template <class T, class Less, class Sort>
+    double time_ms(const std::vector<T>& input, int reps, Less less, Sort sort) {
+        double best = 1e300;
+        std::vector<T> work;
+        for (int r = 0; r < reps; ++r) {
+            work = input;
+            auto start = std::chrono::steady_clock::now();
+            sort(work.data(), work.data() + work.size());
+            auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(stop - start).count());
+            if (!std::is_sorted(work.begin(), work.end(), less)) {
+                std::fprintf(stderr, "sort produced unsorted output\n");
+                std::exit(1);
+            }
+        }
+        return best;
+    }
+
+    template <class T, class Less, class Key>
+    void run(const char* name, const std::vector<T>& input, Less less, Key key) {
+        const int reps = input.size() <= 100000 ? 10 : 3;
+        double lsd = time_ms(input, reps, less, [&](T* f, T* l) { tinySTL::radix_sort(f, l, key); });
+        double msd = time_ms(input, reps, less, [&](T* f, T* l) { tinySTL::radix_sort_inplace(f, l, key); });
+        double cmp = time_ms(input, reps, less, [&](T* f, T* l) { tinySTL::sort(f, l, less); });
+        std::printf("%-10s %12zu %12.3f %12.3f %12.3f %8.2f\n", name, input.size(), lsd, msd, cmp, lsd / cmp);
+    }
+
+    struct identity_key {
+        template <class T>
+        T operator()(const T& x) const { return x; }
+    };
+}
+
+// Usage: radix_sort_bench [max_n]
+int main(int argc, char** argv) {
+    const size_t max_n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 10000000;
+    std::printf("%-10s %12s %12s %12s %12s %8s\n", "type", "n", "lsd_ms", "msd_ms", "sort_ms", "ratio");
+    std::mt19937_64 rng(42);
+    for (size_t n = 1000; n <= max_n; n *= 10) {
+        std::vector<unsigned int> u32(n);
+        std::vector<unsigned long long> u64(n);
+        std::vector<double> f64(n);
+        std::vector<record> recs(n);
+        std::uniform_real_distribution<double> real(-1e6, 1e6);
+        for (size_t i = 0; i < n; ++i) {
+            u32[i] = unsigned(rng());
+            u64[i] = rng();
+            f64[i] = real(rng);
+            recs[i].key = unsigned(rng());
+            recs[i].payload = unsigned(i);
+        }
+        run("uint32", u32, tinySTL::less<unsigned int>(), identity_key());
+        run("uint64", u64, tinySTL::less<unsigned long long>(), identity_key());
+        run("double", f64, tinySTL::less<double>(), identity_key());
+        run("record", recs, record_less(), record_key());
+    }
+    return 0;
+}
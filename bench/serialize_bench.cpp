@@ -0,0 +1,151 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../serialize.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    struct record {
+        uint64_t key;
+        uint64_t value;
+        uint32_t flags;
+        uint32_t version;
+    };
+
+    double seconds_since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Flushes the file and drops it from the page cache, so the next read
+    // comes from the device.
+    void evict(const char* path) {
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        ::fdatasync(fd);
+#ifdef POSIX_FADV_DONTNEED
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+        ::close(fd);
+    }
+
+    void report(const char* name, double bytes, double s) {
+        std::printf("%-34s %10.3f s %10.1f MB/s\n", name, s, bytes / s / 1e6);
+        std::fflush(stdout);
+    }
+
+    template <class Container>
+    uint64_t checksum(const Container& c) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < c.size(); ++i) {
+            sum += c[i].key ^ c[i].value;
+        }
+        return sum;
+    }
+}
+
+// Usage: serialize_bench [bytes] [path]
+// Saves a vector of 24-byte records (512 MiB by default) to path
+// (./serialize_bench.bin) and reloads it several ways. Cold loads drop the
+// file from the page cache first, so they measure the device; the
+// element-by-element load is the read-and-push_back loop this replaces.
+int main(int argc, char** argv) {
+    const size_t bytes = argc > 1 ? std::strtoull(argv[1], 0, 10) : size_t(512) << 20;
+    const char* path = argc > 2 ? argv[2] : "serialize_bench.bin";
+    const size_t n = bytes / sizeof(record);
+    const double total = double(n * sizeof(record));
+
+    uint64_t expect;
+    {
+        tinySTL::vector<record> v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            record r = { i * 0x9e3779b97f4a7c15ull, i, uint32_t(i), 1 };
+            v.push_back(r);
+        }
+        expect = checksum(v);
+        auto start = std::chrono::steady_clock::now();
+        tinySTL::serialize(path, v);
+        evict(path);
+        report("save vector (with fdatasync)", total, seconds_since(start));
+    }
+    {
+        tinySTL::deque<record> d;
+        for (size_t i = 0; i < n; ++i) {
+            record r = { i * 0x9e3779b97f4a7c15ull, i, uint32_t(i), 1 };
+            d.push_back(r);
+        }
+        const std::string deque_path = std::string(path) + ".deque";
+        auto start = std::chrono::steady_clock::now();
+        tinySTL::serialize(deque_path.c_str(), d);
+        evict(deque_path.c_str());
+        report("save deque (with fdatasync)", total, seconds_since(start));
+        ::unlink(deque_path.c_str());
+    }
+    {
+        std::vector<char> buf(size_t(1) << 20);
+        evict(path);
+        auto start = std::chrono::steady_clock::now();
+        const int fd = ::open(path, O_RDONLY);
+        while (::read(fd, buf.data(), buf.size()) > 0) {
+        }
+        ::close(fd);
+        report("raw read, cold (device bound)", total, seconds_since(start));
+    }
+    {
+        evict(path);
+        tinySTL::vector<record> v;
+        auto start = std::chrono::steady_clock::now();
+        tinySTL::deserialize(path, v);
+        report("load vector, cold", total, seconds_since(start));
+        if (checksum(v) != expect) {
+            std::printf("checksum mismatch\n");
+            return 1;
+        }
+    }
+    {
+        tinySTL::vector<record> v;
+        auto start = std::chrono::steady_clock::now();
+        tinySTL::deserialize(path, v);
+        report("load vector, warm", total, seconds_since(start));
+    }
+    {
+        tinySTL::deque<record> d;
+        auto start = std::chrono::steady_clock::now();
+        tinySTL::deserialize(path, d);
+        report("load deque, warm", total, seconds_since(start));
+        if (checksum(d) != expect) {
+            std::printf("checksum mismatch\n");
+            return 1;
+        }
+    }
+    {
+        tinySTL::vector<record> v;
+        auto start = std::chrono::steady_clock::now();
+        FILE* f = std::fopen(path, "rb");
+        std::fseek(f, 64, SEEK_SET);
+        record r;
+        while (std::fread(&r, sizeof(r), 1, f) == 1) {
+            v.push_back(r);
+        }
+        std::fclose(f);
+        report("element by element, warm", total, seconds_since(start));
+    }
+    {
+        evict(path);
+        auto start = std::chrono::steady_clock::now();
+        tinySTL::mapped_array<record> m(path);
+        const double open_s = seconds_since(start);
+        sink = checksum(m);
+        report("mapped_array open", total, open_s);
+        report("mapped_array open + full scan, cold", total, seconds_since(start));
+    }
+    ::unlink(path);
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "../algorithm.h"
+
+namespace {
+    volatile size_t sink;
+
+    template <class F>
+    double time_ms(int reps, F f) {
+        double best = 1e300;
+        for (int r = 0; r < reps; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            sink = size_t(f());
+            auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(stop - start).count());
+        }
+        return best;
+    }
+
+    void report(const char* type, const char* op, size_t n, double tiny, double stdt) {
+        std::printf("%-8s %-12s %12zu %12.3f %12.3f %8.2f\n", type, op, n, tiny, stdt, stdt / tiny);
+    }
+
+    template <class T>
+    void run(const char* type, size_t n) {
+        std::mt19937_64 rng(42);
+        std::vector<T> a(n);
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = T(rng() % 100 + 1);
+        }
+        std::vector<T> b = a;
+        const T* f = a.data();
+        const T* l = f + n;
+        const T* g = b.data();
+        const T missing = T(0);
+        const int reps = 20;
+
+        report(type, "find", n,
+               time_ms(reps, [&] { return tinySTL::find(f, l, missing) - f; }),
+               time_ms(reps, [&] { return std::find(f, l, missing) - f; }));
+        report(type, "count", n,
+               time_ms(reps, [&] { return tinySTL::count(f, l, T(7)); }),
+               time_ms(reps, [&] { return std::count(f, l, T(7)); }));
+        report(type, "mismatch", n,
+               time_ms(reps, [&] { return tinySTL::mismatch(f, l, g).first - f; }),
+               time_ms(reps, [&] { return std::mismatch(f, l, g).first - f; }));
+        report(type, "min_element", n,
+               time_ms(reps, [&] { return tinySTL::min_element(f, l) - f; }),
+               time_ms(reps, [&] { return std::min_element(f, l) - f; }));
+        report(type, "max_element", n,
+               time_ms(reps, [&] { return tinySTL::max_element(f, l) - f; }),
+               time_ms(reps, [&] { return std::max_element(f, l) - f; }));
+        report(type, "accumulate", n,
+               time_ms(reps, [&] { return tinySTL::accumulate(f, l, T(0)); }),
+               time_ms(reps, [&] { return std::accumulate(f, l, T(0)); }));
+    }
+}
+
+// Usage: simd_bench [n]
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 1 << 22;
+    std::printf("%-8s %-12s %12s %12s %12s %8s\n", "type", "op", "n", "tinySTL_ms", "std_ms", "speedup");
+    run<unsigned char>("uint8", n);
+    run<short>("int16", n);
+    run<int>("int32", n);
+    run<long long>("int64", n);
+    run<float>("float", n);
+    run<double>("double", n);
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "../list.h"
+#include "../slot_map.h"
+#include "../vector.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    struct entity {
+        float x, y, z;
+        float vx, vy, vz;
+        uint64_t id;
+    };
+
+    uint64_t next_random(uint64_t& state) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    entity make_entity(uint64_t id) {
+        entity e = { float(id), 0, 0, 1, 1, 1, id };
+        return e;
+    }
+
+    template <class F>
+    double time_ns(size_t ops, F f) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count() / double(ops);
+    }
+
+    template <class Range>
+    uint64_t step_all(Range& r) {
+        uint64_t sum = 0;
+        for (auto it = r.begin(); it != r.end(); ++it) {
+            it->x += it->vx;
+            it->y += it->vy;
+            it->z += it->vz;
+            sum += it->id;
+        }
+        return sum;
+    }
+
+    // vector_ns is 0 where a vector has no handle to compare.
+    void report(const char* name, double slot_map_ns, double list_ns, double vector_ns) {
+        if (vector_ns > 0) {
+            std::printf("%-30s %12.2f %12.2f %12.2f\n", name, slot_map_ns, list_ns, vector_ns);
+        }
+        else {
+            std::printf("%-30s %12.2f %12.2f %12s\n", name, slot_map_ns, list_ns, "-");
+        }
+    }
+}
+
+// Usage: slot_map_bench [n] [churn]
+// Keeps n entities (1M by default) in a slot_map, in a list (handles are
+// iterators) and in a vector (handles are indices that erase shifts), and
+// times, in ns per entity, a random erase-and-insert churn and then a pass
+// that updates every live entity. The vector churn is timed over n / 100
+// operations, since each erase moves half the array.
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 1000000;
+    const size_t churn = argc > 2 ? std::strtoull(argv[2], 0, 10) : n;
+
+    tinySTL::slot_map<entity> sm;
+    tinySTL::vector<tinySTL::slot_map_handle> handles;
+    tinySTL::list<entity> l;
+    tinySTL::vector<decltype(l.begin())> positions;
+    tinySTL::vector<entity> v;
+    for (size_t i = 0; i < n; ++i) {
+        handles.push_back(sm.insert(make_entity(i)));
+        l.push_back(make_entity(i));
+        positions.push_back(--l.end());
+        v.push_back(make_entity(i));
+    }
+
+    uint64_t state = 42;
+    const double sm_churn = time_ns(churn, [&]() {
+        for (size_t i = 0; i < churn; ++i) {
+            const size_t k = size_t(next_random(state) % n);
+            sm.erase(handles[k]);
+            handles[k] = sm.insert(make_entity(n + i));
+        }
+    });
+    state = 42;
+    const double list_churn = time_ns(churn, [&]() {
+        for (size_t i = 0; i < churn; ++i) {
+            const size_t k = size_t(next_random(state) % n);
+            l.erase(positions[k]);
+            l.push_back(make_entity(n + i));
+            positions[k] = --l.end();
+        }
+    });
+    state = 42;
+    const size_t vector_churn = churn / 100 ? churn / 100 : 1;
+    const double vec_churn = time_ns(vector_churn, [&]() {
+        for (size_t i = 0; i < vector_churn; ++i) {
+            const size_t k = size_t(next_random(state) % v.size());
+            v.erase(v.begin() + k);
+            v.push_back(make_entity(n + i));
+        }
+    });
+
+    std::printf("%-30s %12s %12s %12s\n", "benchmark", "slot_map_ns", "list_ns", "vector_ns");
+    report("erase + insert", sm_churn, list_churn, vec_churn);
+    report("update all (after churn)", time_ns(n, [&]() { sink = step_all(sm); }),
+           time_ns(n, [&]() { sink = step_all(l); }), time_ns(n, [&]() { sink = step_all(v); }));
+    report("lookup by handle", time_ns(n, [&]() {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += sm[handles[i]].id;
+        }
+        sink = sum;
+    }), time_ns(n, [&]() {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += positions[i]->id;
+        }
+        sink = sum;
+    }), 0);
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../algorithm.h"
+
+namespace {
+    enum pattern { RANDOM, SORTED, REVERSED, FEW_UNIQUE, ORGAN_PIPE };
+    const char* const pattern_names[] = { "random", "sorted", "reversed", "few_unique", "organ_pipe" };
+
+    void generate(std::vector<unsigned long>& data, size_t n, pattern p, unsigned seed) {
+        std::mt19937_64 rng(seed);
+        data.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            switch (p) {
+            case RANDOM:     data[i] = rng(); break;
+            case SORTED:     data[i] = i; break;
+            case REVERSED:   data[i] = n - i; break;
+            case FEW_UNIQUE: data[i] = rng() % 16; break;
+            case ORGAN_PIPE: data[i] = i < n / 2 ? i : n - i; break;
+            }
+        }
+    }
+
+    template <class Sort>
+    double time_ms(const std::vector<unsigned long>& input, int reps, Sort sort) {
+        double best = 1e300;
+        std::vector<unsigned long> work;
+        for (int r = 0; r < reps; ++r) {
+            work = input;
+            auto start = std::chrono::steady_clock::now();
+            sort(work.data(), work.data() + work.size());
+            auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(stop - start).count());
+            if (!std::is_sorted(work.begin(), work.end())) {
+                std::fprintf(stderr, "sort produced unsorted output\n");
+                std::exit(1);
+            }
+        }
+        return best;
+    }
+}
+
+// Usage: sort_bench [max_n]
+int main(int argc, char** argv) {
+    const size_t max_n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 10000000;
+    std::printf("%-12s %12s %14s %14s %8s\n", "pattern", "n", "tinySTL_ms", "std_ms", "ratio");
+    std::vector<unsigned long> input;
+    for (size_t n = 1000; n <= max_n; n *= 10) {
+        const int reps = n <= 100000 ? 10 : 3;
+        for (int p = RANDOM; p <= ORGAN_PIPE; ++p) {
+            generate(input, n, pattern(p), 42);
+            double tiny = time_ms(input, reps, [](unsigned long* f, unsigned long* l) { tinySTL::sort(f, l); });
+            double stdt = time_ms(input, reps, [](unsigned long* f, unsigned long* l) { std::sort(f, l); });
+            std::printf("%-12s %12zu %14.3f %14.3f %8.2f\n", pattern_names[p], n, tiny, stdt, tiny / stdt);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "../algorithm.h"
+
+namespace {
+    // Timestamped events: key is the timestamp, id the arrival order.
+    struct event {
+        uint64_t key;
+        uint64_t id;
+    };
+
+    struct by_key {
+        bool operator()(const event& a, const event& b) const { return a.key < b.key; }
+    };
+
+    enum pattern { RANDOM, SORTED, NEARLY_SORTED, LATE_ARRIVALS, REVERSED, FEW_UNIQUE, SAWTOOTH };
+    const char* const pattern_names[] = {
+        "random", "sorted", "nearly", "late_1pct", "reversed", "few_unique", "sawtooth"
+    };
+
+    void generate(std::vector<event>& data, size_t n, pattern p, unsigned seed) {
+        std::mt19937_64 rng(seed);
+        data.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            switch (p) {
+            case RANDOM:        data[i].key = rng(); break;
+            case SORTED:        data[i].key = i; break;
+            case NEARLY_SORTED: data[i].key = i + rng() % 16; break;
+            case LATE_ARRIVALS: data[i].key = rng() % 100 == 0 ? i - rng() % (i + 1) : i; break;
+            case REVERSED:      data[i].key = n - i; break;
+            case FEW_UNIQUE:    data[i].key = rng() % 16; break;
+            case SAWTOOTH:      data[i].key = i % 1000; break;
+            }
+            data[i].id = i;
+        }
+    }
+
+    template <class Sort>
+    double time_ms(const std::vector<event>& input, int reps, Sort sort) {
+        double best = 1e300;
+        std::vector<event> work;
+        for (int r = 0; r < reps; ++r) {
+            work = input;
+            auto start = std::chrono::steady_clock::now();
+            sort(work.data(), work.data() + work.size());
+            auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(stop - start).count());
+            for (size_t i = 1; i < work.size(); ++i) {
+                if (work[i].key < work[i - 1].key || (work[i].key == work[i - 1].key && work[i].id < work[i - 1].id)) {
+                    std::fprintf(stderr, "stable_sort produced unsorted or unstable output\n");
+                    std::exit(1);
+                }
+            }
+        }
+        return best;
+    }
+}
+
+// Usage: stable_sort_bench [max_n]
+int main(int argc, char** argv) {
+    const size_t max_n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 10000000;
+    std::printf("%-12s %12s %14s %14s %8s\n", "pattern", "n", "tinySTL_ms", "std_ms", "ratio");
+    std::vector<event> input;
+    for (size_t n = 1000; n <= max_n; n *= 10) {
+        const int reps = n <= 100000 ? 10 : 3;
+        for (int p = RANDOM; p <= SAWTOOTH; ++p) {
+            generate(input, n, pattern(p), 42);
+            double tiny = time_ms(input, reps, [](event* f, event* l) { tinySTL::stable_sort(f, l, by_key()); });
+            double stdt = time_ms(input, reps, [](event* f, event* l) { std::stable_sort(f, l, by_key()); });
+            std::printf("%-12s %12zu %14.3f %14.3f %8.2f\n", pattern_names[p], n, tiny, stdt, tiny / stdt);
+        }
+    }
+    return 0;
+}
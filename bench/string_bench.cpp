@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "../basic_string.h"
+#include "../unordered_map.h"
+#include "../vector.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    template <class F>
+    double time_ns(size_t ops, F f) {
+        double best = 1e300;
+        for (int r = 0; r < 5; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            f();
+            auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count() / double(ops));
+        }
+        return best;
+    }
+
+    void report(const char* name, double tiny, double std_ns) {
+        std::printf("%-26s %12.2f %12.2f %8.2f\n", name, tiny, std_ns, tiny / std_ns);
+    }
+
+    // Builds n strings from words, then looks each up in a map keyed by them.
+    template <class String>
+    double map_lookup(const std::vector<std::string>& words) {
+        tinySTL::unordered_map<String, int> m;
+        std::vector<String> keys;
+        for (size_t i = 0; i < words.size(); ++i) {
+            keys.push_back(String(words[i].c_str()));
+            m[keys.back()] = int(i);
+        }
+        return time_ns(keys.size(), [&]() {
+            uint64_t sum = 0;
+            for (size_t i = 0; i < keys.size(); ++i) {
+                sum += uint64_t(m.find(keys[i])->second);
+            }
+            sink = sum;
+        });
+    }
+
+    template <class String>
+    double construct_small(const std::vector<std::string>& words) {
+        return time_ns(words.size(), [&]() {
+            uint64_t sum = 0;
+            for (size_t i = 0; i < words.size(); ++i) {
+                String s(words[i].c_str());
+                sum += uint64_t(s.size());
+            }
+            sink = sum;
+        });
+    }
+
+    template <class String>
+    double append_chars(size_t n) {
+        return time_ns(n, [&]() {
+            String s;
+            for (size_t i = 0; i < n; ++i) {
+                s.push_back(char('a' + i % 26));
+            }
+            sink = uint64_t(s.size());
+        });
+    }
+
+    template <class Vector, class String>
+    double vector_growth(const std::vector<std::string>& words) {
+        return time_ns(words.size(), [&]() {
+            Vector v;
+            for (size_t i = 0; i < words.size(); ++i) {
+                v.push_back(String(words[i].c_str()));
+            }
+            sink = uint64_t(v.size());
+        });
+    }
+}
+
+// Usage: string_bench [n]
+// Times tinySTL::basic_string against std::string in ns per operation:
+// construction of short strings (which fit tinySTL's 23-char buffer but not
+// always libstdc++'s 15), appends, find and compare in a long haystack,
+// growing a vector of strings and hash map lookups.
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 1000000;
+    std::mt19937_64 rng(42);
+    std::vector<std::string> words(n);
+    for (size_t i = 0; i < n; ++i) {
+        const size_t len = 8 + rng() % 16;
+        for (size_t j = 0; j < len; ++j) {
+            words[i].push_back(char('a' + rng() % 26));
+        }
+    }
+    std::string hay(n * 16, 'a');
+    for (size_t i = 0; i < hay.size(); ++i) {
+        hay[i] = char('a' + rng() % 16);
+    }
+    const std::string needle = "zzzzpattern";
+    hay.replace(hay.size() - needle.size(), needle.size(), needle);
+
+    std::printf("%-26s %12s %12s %8s\n", "benchmark", "tinySTL_ns", "std_ns", "ratio");
+    report("construct (8-23 chars)", construct_small<tinySTL::string>(words), construct_small<std::string>(words));
+    report("push_back", append_chars<tinySTL::string>(n * 16), append_chars<std::string>(n * 16));
+
+    const tinySTL::string tiny_hay(hay.c_str(), hay.size());
+    const tinySTL::string tiny_copy(hay.c_str(), hay.size());
+    const std::string std_copy = hay;
+    report("find char (per byte)", time_ns(hay.size(), [&]() { sink = tiny_hay.find('z'); }),
+           time_ns(hay.size(), [&]() { sink = hay.find('z'); }));
+    report("find substring (per byte)", time_ns(hay.size(), [&]() { sink = tiny_hay.find(needle.c_str()); }),
+           time_ns(hay.size(), [&]() { sink = hay.find(needle); }));
+    report("equal (per byte)", time_ns(hay.size(), [&]() { sink = tiny_hay == tiny_copy; }),
+           time_ns(hay.size(), [&]() { sink = hay == std_copy; }));
+
+    report("vector push_back", vector_growth<tinySTL::vector<tinySTL::string>, tinySTL::string>(words),
+           vector_growth<std::vector<std::string>, std::string>(words));
+    report("unordered_map find", map_lookup<tinySTL::string>(words), map_lookup<std::string>(words));
+    return 0;
+}
@@ -0,0 +1,483 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "../algorithm.h"
+#include "../deque.h"
+#include "../list.h"
+#include "../vector.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    // A 64-byte record ordered by its first word.
+    struct pod64 {
+        uint64_t v[8];
+    };
+
+    inline bool operator<(const pod64& a, const pod64& b) { return a.v[0] < b.v[0]; }
+    inline bool operator==(const pod64& a, const pod64& b) { return a.v[0] == b.v[0]; }
+
+    template <class T>
+    struct element;
+
+    template <>
+    struct element<int> {
+        static const char* name() { return "int"; }
+        static size_t heap_bytes() { return 0; }
+        static int make(uint64_t x) { return int(x); }
+        static uint64_t key(int x) { return uint64_t(x); }
+    };
+
+    template <>
+    struct element<pod64> {
+        static const char* name() { return "pod64"; }
+        static size_t heap_bytes() { return 0; }
+        static pod64 make(uint64_t x) {
+            pod64 p;
+            for (int i = 0; i < 8; ++i) {
+                p.v[i] = x + uint64_t(i);
+            }
+            return p;
+        }
+        static uint64_t key(const pod64& x) { return x.v[0]; }
+    };
+
+    // Long enough to defeat the small-string buffer, so every copy allocates.
+    template <>
+    struct element<std::string> {
+        static const char* name() { return "string"; }
+        static size_t heap_bytes() { return 64; }
+        static std::string make(uint64_t x) {
+            char buf[40];
+            std::snprintf(buf, sizeof(buf), "%020llu-heap-owning-str", static_cast<unsigned long long>(x));
+            return std::string(buf);
+        }
+        static uint64_t key(const std::string& x) { return uint64_t(x.size()) + uint64_t(x[19]); }
+    };
+
+    struct options {
+        size_t min_n;
+        size_t max_n;
+        size_t max_bytes;
+        double min_time;
+        std::string json_path;
+        std::string filter;
+        std::string types;
+    };
+
+    struct result {
+        std::string name;
+        std::string type;
+        std::string impl;
+        size_t n;
+        size_t ops;
+        size_t rounds;
+        double ns_per_op;
+    };
+
+    std::vector<result> results;
+
+    size_t physical_bytes() {
+        const long pages = sysconf(_SC_PHYS_PAGES);
+        const long page_size = sysconf(_SC_PAGESIZE);
+        return pages > 0 && page_size > 0 ? size_t(pages) * size_t(page_size) : size_t(1) << 32;
+    }
+
+    struct timing {
+        double ns_per_op;
+        size_t rounds;
+    };
+
+    // Best time per operation over repeated rounds. Each round sets up
+    // `batch` fresh states of n elements outside the clock and runs body,
+    // which does `ops` operations, on all of them, so tiny sizes still time a
+    // measurable amount of work.
+    template <class State, class Setup, class Body>
+    timing measure(const options& opt, size_t n, size_t ops, Setup setup, Body body) {
+        const size_t batch = std::max<size_t>(1, 100000 / std::max<size_t>(std::max(n, ops), 1));
+        timing t = { 1e300, 0 };
+        double spent = 0;
+        while (t.rounds < 2 || (spent < opt.min_time && t.rounds < 1000)) {
+            std::vector<State> states(batch);
+            for (size_t i = 0; i < batch; ++i) {
+                setup(states[i]);
+            }
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < batch; ++i) {
+                body(states[i]);
+            }
+            const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            t.ns_per_op = std::min(t.ns_per_op, s * 1e9 / double(batch * ops));
+            spent += s;
+            ++t.rounds;
+            if (s > 1.0) {
+                break;
+            }
+        }
+        return t;
+    }
+
+    void record(const char* name, const char* type, const char* impl, size_t n, size_t ops, timing t) {
+        result r = { name, type, impl, n, ops, t.rounds, t.ns_per_op };
+        results.push_back(r);
+    }
+
+    void report(const char* name, const char* type, size_t n, size_t ops, timing tiny, timing std_t) {
+        record(name, type, "tinySTL", n, ops, tiny);
+        record(name, type, "std", n, ops, std_t);
+        std::printf("%-22s %-7s %11zu %12.2f %12.2f %8.2f\n", name, type, n, tiny.ns_per_op, std_t.ns_per_op,
+                    tiny.ns_per_op / std_t.ns_per_op);
+        std::fflush(stdout);
+    }
+
+    // Number of O(n) middle inserts or erases to time at size n.
+    size_t middle_ops(size_t n) {
+        return std::max<size_t>(1, std::min<size_t>(n / 2, 10000000 / n));
+    }
+
+    template <class T, class Vector>
+    timing vector_push_back(const options& opt, const std::vector<T>& src) {
+        return measure<Vector>(opt, src.size(), src.size(), [](Vector&) {}, [&](Vector& v) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                v.push_back(src[i]);
+            }
+        });
+    }
+
+    template <class T, class Vector>
+    timing vector_copy(const options& opt, const std::vector<T>& src) {
+        Vector from;
+        for (size_t i = 0; i < src.size(); ++i) {
+            from.push_back(src[i]);
+        }
+        return measure<Vector>(opt, src.size(), src.size(), [](Vector&) {}, [&](Vector& v) { v = from; });
+    }
+
+    template <class T, class Vector>
+    timing vector_erase(const options& opt, const std::vector<T>& src) {
+        const size_t k = middle_ops(src.size());
+        return measure<Vector>(opt, src.size(), k, [&](Vector& v) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                v.push_back(src[i]);
+            }
+        }, [&](Vector& v) {
+            for (size_t i = 0; i < k; ++i) {
+                v.erase(v.begin() + (v.size() / 2));
+            }
+        });
+    }
+
+    template <class T, class List>
+    timing list_insert(const options& opt, const std::vector<T>& src) {
+        return measure<List>(opt, src.size(), src.size(), [](List&) {}, [&](List& l) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                l.insert(l.end(), src[i]);
+            }
+        });
+    }
+
+    // Moves every element of one list to another, one node at a time.
+    template <class T, class List>
+    timing list_splice(const options& opt, const std::vector<T>& src) {
+        struct pair_state {
+            List from;
+            List to;
+        };
+        return measure<pair_state>(opt, src.size(), src.size(), [&](pair_state& s) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                s.from.push_back(src[i]);
+            }
+        }, [&](pair_state& s) {
+            while (!s.from.empty()) {
+                s.to.splice(s.to.end(), s.from, s.from.begin());
+            }
+        });
+    }
+
+    template <class T, class List>
+    timing list_sort(const options& opt, const std::vector<T>& src) {
+        return measure<List>(opt, src.size(), src.size(), [&](List& l) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                l.push_back(src[i]);
+            }
+        }, [](List& l) { l.sort(); });
+    }
+
+    // Walks a list after sorting it, so successive nodes are scattered in memory.
+    template <class T, class List>
+    timing list_traversal(const options& opt, const std::vector<T>& src) {
+        return measure<List>(opt, src.size(), src.size(), [&](List& l) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                l.push_back(src[i]);
+            }
+            l.sort();
+        }, [](List& l) {
+            uint64_t sum = 0;
+            for (auto it = l.begin(); it != l.end(); ++it) {
+                sum += element<T>::key(*it);
+            }
+            sink = sum;
+        });
+    }
+
+    template <class T, class Deque>
+    timing deque_push(const options& opt, const std::vector<T>& src, bool front) {
+        return measure<Deque>(opt, src.size(), src.size(), [](Deque&) {}, [&](Deque& d) {
+            if (front) {
+                for (size_t i = 0; i < src.size(); ++i) {
+                    d.push_front(src[i]);
+                }
+            }
+            else {
+                for (size_t i = 0; i < src.size(); ++i) {
+                    d.push_back(src[i]);
+                }
+            }
+        });
+    }
+
+    template <class T, class Deque>
+    timing deque_pop(const options& opt, const std::vector<T>& src, bool front) {
+        return measure<Deque>(opt, src.size(), src.size(), [&](Deque& d) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                d.push_back(src[i]);
+            }
+        }, [&](Deque& d) {
+            if (front) {
+                while (!d.empty()) {
+                    d.pop_front();
+                }
+            }
+            else {
+                while (!d.empty()) {
+                    d.pop_back();
+                }
+            }
+        });
+    }
+
+    template <class T, class Deque>
+    timing deque_random_access(const options& opt, const std::vector<T>& src, const std::vector<uint32_t>& index) {
+        return measure<Deque>(opt, src.size(), src.size(), [&](Deque& d) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                d.push_back(src[i]);
+            }
+        }, [&](Deque& d) {
+            uint64_t sum = 0;
+            for (size_t i = 0; i < index.size(); ++i) {
+                sum += element<T>::key(d[index[i]]);
+            }
+            sink = sum;
+        });
+    }
+
+    // Inserts in the middle go through insert_aux, which shifts the shorter half.
+    template <class T, class Deque>
+    timing deque_insert_middle(const options& opt, const std::vector<T>& src) {
+        const size_t k = middle_ops(src.size());
+        return measure<Deque>(opt, src.size(), k, [&](Deque& d) {
+            for (size_t i = 0; i < src.size(); ++i) {
+                d.push_back(src[i]);
+            }
+        }, [&](Deque& d) {
+            for (size_t i = 0; i < k; ++i) {
+                d.insert(d.begin() + typename Deque::difference_type(d.size() / 2), src[i]);
+            }
+        });
+    }
+
+    template <class T, bool Tiny>
+    timing sort_random(const options& opt, const std::vector<T>& src) {
+        typedef std::vector<T> State;
+        return measure<State>(opt, src.size(), src.size(), [&](State& s) { s = src; }, [](State& s) {
+            if (Tiny) {
+                tinySTL::sort(s.data(), s.data() + s.size());
+            }
+            else {
+                std::sort(s.data(), s.data() + s.size());
+            }
+        });
+    }
+
+    bool selected(const options& opt, const char* name, size_t bytes_per_element, size_t n) {
+        if (!opt.filter.empty() && std::strstr(name, opt.filter.c_str()) == nullptr) {
+            return false;
+        }
+        // The source array, the container under test and a batch of states.
+        return n * bytes_per_element * 3 <= opt.max_bytes;
+    }
+
+    template <class T>
+    void run_type(const options& opt) {
+        const char* type = element<T>::name();
+        if (!opt.types.empty() && opt.types.find(type) == std::string::npos) {
+            return;
+        }
+        const size_t elem = sizeof(T) + element<T>::heap_bytes();
+        const size_t node = elem + 2 * sizeof(void*) + 16;
+        for (size_t n = opt.min_n; n <= opt.max_n; n *= 10) {
+            if (n * elem * 2 > opt.max_bytes) {
+                break;
+            }
+            std::mt19937_64 rng(42);
+            std::vector<T> src;
+            src.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                src.push_back(element<T>::make(rng()));
+            }
+
+            if (selected(opt, "vector/push_back", 2 * elem, n)) {
+                report("vector/push_back", type, n, n, vector_push_back<T, tinySTL::vector<T>>(opt, src),
+                       vector_push_back<T, std::vector<T>>(opt, src));
+            }
+            if (selected(opt, "vector/copy", 2 * elem, n)) {
+                report("vector/copy", type, n, n, vector_copy<T, tinySTL::vector<T>>(opt, src),
+                       vector_copy<T, std::vector<T>>(opt, src));
+            }
+            if (selected(opt, "vector/erase_middle", 2 * elem, n)) {
+                report("vector/erase_middle", type, n, middle_ops(n), vector_erase<T, tinySTL::vector<T>>(opt, src),
+                       vector_erase<T, std::vector<T>>(opt, src));
+            }
+            if (selected(opt, "list/insert", node, n)) {
+                report("list/insert", type, n, n, list_insert<T, tinySTL::list<T>>(opt, src),
+                       list_insert<T, std::list<T>>(opt, src));
+            }
+            if (selected(opt, "list/splice", node, n)) {
+                report("list/splice", type, n, n, list_splice<T, tinySTL::list<T>>(opt, src),
+                       list_splice<T, std::list<T>>(opt, src));
+            }
+            if (selected(opt, "list/sort", node, n)) {
+                report("list/sort", type, n, n, list_sort<T, tinySTL::list<T>>(opt, src),
+                       list_sort<T, std::list<T>>(opt, src));
+            }
+            if (selected(opt, "list/traversal", node, n)) {
+                report("list/traversal", type, n, n, list_traversal<T, tinySTL::list<T>>(opt, src),
+                       list_traversal<T, std::list<T>>(opt, src));
+            }
+            if (selected(opt, "deque/push_back", elem, n)) {
+                report("deque/push_back", type, n, n, deque_push<T, tinySTL::deque<T>>(opt, src, false),
+                       deque_push<T, std::deque<T>>(opt, src, false));
+            }
+            if (selected(opt, "deque/push_front", elem, n)) {
+                report("deque/push_front", type, n, n, deque_push<T, tinySTL::deque<T>>(opt, src, true),
+                       deque_push<T, std::deque<T>>(opt, src, true));
+            }
+            if (selected(opt, "deque/pop_back", elem, n)) {
+                report("deque/pop_back", type, n, n, deque_pop<T, tinySTL::deque<T>>(opt, src, false),
+                       deque_pop<T, std::deque<T>>(opt, src, false));
+            }
+            if (selected(opt, "deque/pop_front", elem, n)) {
+                report("deque/pop_front", type, n, n, deque_pop<T, tinySTL::deque<T>>(opt, src, true),
+                       deque_pop<T, std::deque<T>>(opt, src, true));
+            }
+            if (selected(opt, "deque/random_access", elem + sizeof(uint32_t), n)) {
+                std::vector<uint32_t> index(n);
+                for (size_t i = 0; i < n; ++i) {
+                    index[i] = uint32_t(rng() % n);
+                }
+                report("deque/random_access", type, n, n,
+                       deque_random_access<T, tinySTL::deque<T>>(opt, src, index),
+                       deque_random_access<T, std::deque<T>>(opt, src, index));
+            }
+            if (selected(opt, "deque/insert_middle", elem, n)) {
+                report("deque/insert_middle", type, n, middle_ops(n),
+                       deque_insert_middle<T, tinySTL::deque<T>>(opt, src),
+                       deque_insert_middle<T, std::deque<T>>(opt, src));
+            }
+            if (selected(opt, "sort", elem, n)) {
+                report("sort", type, n, n, sort_random<T, true>(opt, src), sort_random<T, false>(opt, src));
+            }
+        }
+    }
+
+    void write_json(const options& opt) {
+        FILE* f = opt.json_path == "-" ? stdout : std::fopen(opt.json_path.c_str(), "w");
+        if (!f) {
+            std::perror(opt.json_path.c_str());
+            std::exit(1);
+        }
+        std::fprintf(f, "{\n  \"suite\": \"tinystl_bench\",\n  \"schema_version\": 1,\n");
+        std::fprintf(f, "  \"timestamp\": %lld,\n", static_cast<long long>(std::time(nullptr)));
+#if defined(__VERSION__)
+        std::fprintf(f, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+        std::fprintf(f, "  \"unit\": \"ns_per_op\",\n  \"results\": [\n");
+        for (size_t i = 0; i < results.size(); ++i) {
+            const result& r = results[i];
+            std::fprintf(f, "    {\"name\": \"%s\", \"type\": \"%s\", \"impl\": \"%s\", \"n\": %zu, \"ops\": %zu, "
+                            "\"rounds\": %zu, \"ns_per_op\": %.4f}%s\n",
+                         r.name.c_str(), r.type.c_str(), r.impl.c_str(), r.n, r.ops, r.rounds, r.ns_per_op,
+                         i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(f, "  ]\n}\n");
+        if (f != stdout) {
+            std::fclose(f);
+        }
+    }
+
+    void usage() {
+        std::fprintf(stderr,
+                     "usage: tinystl_bench [--min-n N] [--max-n N] [--filter SUBSTR] [--types int,pod64,string]\n"
+                     "                     [--min-time SECONDS] [--max-bytes BYTES] [--json PATH|-]\n");
+        std::exit(2);
+    }
+}
+
+// Usage: tinystl_bench [--min-n N] [--max-n N] [--filter SUBSTR] [--types LIST] [--min-time S]
+//                      [--max-bytes B] [--json PATH]
+// Times tinySTL containers and sort against std:: in ns per element
+// operation, for sizes 10, 100, ... up to max-n (10^8 by default). Sizes
+// that would need more than max-bytes (half of physical memory by default)
+// are skipped. Results are also written as JSON, to tinystl_bench.json
+// unless --json says otherwise.
+int main(int argc, char** argv) {
+    options opt = { 10, 100000000, physical_bytes() / 2, 0.05, "tinystl_bench.json", "", "" };
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+        }
+        const char* value = argv[++i];
+        if (arg == "--min-n") {
+            opt.min_n = std::max<size_t>(1, std::strtoull(value, 0, 10));
+        }
+        else if (arg == "--max-n") {
+            opt.max_n = std::strtoull(value, 0, 10);
+        }
+        else if (arg == "--filter") {
+            opt.filter = value;
+        }
+        else if (arg == "--types") {
+            opt.types = value;
+        }
+        else if (arg == "--min-time") {
+            opt.min_time = std::strtod(value, 0);
+        }
+        else if (arg == "--max-bytes") {
+            opt.max_bytes = std::strtoull(value, 0, 10);
+        }
+        else if (arg == "--json") {
+            opt.json_path = value;
+        }
+        else {
+            usage();
+        }
+    }
+
+    std::printf("%-22s %-7s %11s %12s %12s %8s\n", "benchmark", "type", "n", "tinySTL_ns", "std_ns", "ratio");
+    run_type<int>(opt);
+    run_type<pod64>(opt);
+    run_type<std::string>(opt);
+    write_json(opt);
+    return 0;
+}
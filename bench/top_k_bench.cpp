@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+#include "../algorithm.h"
+#include "../top_k.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    template <class F>
+    double time_ms(const std::vector<uint64_t>& keys, F f) {
+        double best = 1e300;
+        for (int r = 0; r < 3; ++r) {
+            std::vector<uint64_t> v = keys;
+            auto start = std::chrono::steady_clock::now();
+            f(v);
+            auto stop = std::chrono::steady_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(stop - start).count());
+        }
+        return best;
+    }
+}
+
+// Usage: top_k_bench [n]
+// Times getting the k smallest of n random keys in order, for growing k.
+int main(int argc, char** argv) {
+    const size_t n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 10000000;
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> keys(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = rng();
+    }
+
+    std::printf("%10s %10s %12s %12s %12s %12s %12s %12s\n", "k", "sort_ms", "partial_ms", "std_part_ms",
+                "nth_ms", "std_nth_ms", "top_k_ms", "copy_ms");
+    for (size_t k = 10; k <= n / 10; k *= 10) {
+        const double sort_ms = time_ms(keys, [&](std::vector<uint64_t>& v) {
+            tinySTL::sort(v.data(), v.data() + v.size());
+            sink = v[k - 1];
+        });
+        const double partial_ms = time_ms(keys, [&](std::vector<uint64_t>& v) {
+            tinySTL::partial_sort(v.data(), v.data() + k, v.data() + v.size());
+            sink = v[k - 1];
+        });
+        const double std_partial_ms = time_ms(keys, [&](std::vector<uint64_t>& v) {
+            std::partial_sort(v.begin(), v.begin() + k, v.end());
+            sink = v[k - 1];
+        });
+        const double nth_ms = time_ms(keys, [&](std::vector<uint64_t>& v) {
+            tinySTL::nth_element(v.data(), v.data() + (k - 1), v.data() + v.size());
+            sink = v[k - 1];
+        });
+        const double std_nth_ms = time_ms(keys, [&](std::vector<uint64_t>& v) {
+            std::nth_element(v.begin(), v.begin() + (k - 1), v.end());
+            sink = v[k - 1];
+        });
+        const double top_k_ms = time_ms(keys, [&](std::vector<uint64_t>& v) {
+            tinySTL::top_k<uint64_t> t(k);
+            t.push(v.begin(), v.end());
+            sink = t.extract_sorted()[k - 1];
+        });
+        const double copy_ms = time_ms(keys, [&](std::vector<uint64_t>& v) {
+            std::vector<uint64_t> out(k);
+            tinySTL::partial_sort_copy(v.begin(), v.end(), out.data(), out.data() + k);
+            sink = out[k - 1];
+        });
+        std::printf("%10zu %10.3f %12.3f %12.3f %12.3f %12.3f %12.3f %12.3f\n", k, sort_ms, partial_ms,
+                    std_partial_ms, nth_ms, std_nth_ms, top_k_ms, copy_ms);
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "../unordered_map.h"
+
+namespace {
+    volatile uint64_t sink;
+
+    template <class F>
+    double ns_per_op(size_t ops, F f) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count() / double(ops);
+    }
+
+    // Inserts every key, looks up a mix of present and absent keys, then
+    // erases half of the keys; reports ns per operation for each phase.
+    template <class Map>
+    void run(const char* name, const std::vector<uint64_t>& keys, const std::vector<uint64_t>& probes) {
+        Map m;
+        const double insert_ns = ns_per_op(keys.size(), [&]() {
+            for (size_t i = 0; i < keys.size(); ++i) {
+                m[keys[i]] = i;
+            }
+        });
+        const double lookup_ns = ns_per_op(probes.size(), [&]() {
+            uint64_t sum = 0;
+            for (size_t i = 0; i < probes.size(); ++i) {
+                auto it = m.find(probes[i]);
+                sum += it == m.end() ? 0 : it->second;
+            }
+            sink = sum;
+        });
+        const double erase_ns = ns_per_op(keys.size() / 2, [&]() {
+            for (size_t i = 0; i < keys.size(); i += 2) {
+                m.erase(keys[i]);
+            }
+        });
+        std::printf("%-10s %12zu %10.1f %10.1f %10.1f\n", name, keys.size(), insert_ns, lookup_ns, erase_ns);
+    }
+}
+
+// Usage: unordered_map_bench [max_n]   (100000000 needs several GB of memory)
+int main(int argc, char** argv) {
+    const size_t max_n = argc > 1 ? std::strtoull(argv[1], 0, 10) : 10000000;
+    std::printf("%-10s %12s %10s %10s %10s\n", "map", "n", "insert_ns", "lookup_ns", "erase_ns");
+    std::mt19937_64 rng(42);
+    for (size_t n = 1000; n <= max_n; n *= 10) {
+        std::vector<uint64_t> keys(n);
+        for (size_t i = 0; i < n; ++i) {
+            keys[i] = rng();
+        }
+        const size_t probe_count = std::min<size_t>(n, 10000000);
+        std::vector<uint64_t> probes(probe_count);
+        for (size_t i = 0; i < probe_count; ++i) {
+            probes[i] = i % 2 ? keys[rng() % n] : rng();
+        }
+        run<tinySTL::unordered_map<uint64_t, uint64_t> >("tinySTL", keys, probes);
+        run<std::unordered_map<uint64_t, uint64_t> >("std", keys, probes);
+    }
+    return 0;
+}
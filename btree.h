@@ -0,0 +1,765 @@
+#ifndef _TINY_BTREE_H_
+#define _TINY_BTREE_H_
+
+#include <cstddef>
+#include <utility>
+#include "allocator.h"
+#include "iterator.h"
+#include "algorithm.h"
+#include "vector.h"
+
+namespace tinySTL {
+    // Tag for constructors whose input is already sorted and free of duplicates.
+    struct sorted_unique_t {};
+    const sorted_unique_t sorted_unique = sorted_unique_t();
+
+    // Number of slot_size entries that fit in a node of `bytes` bytes after
+    // its header, but never fewer than four.
+    inline constexpr size_t __btree_slots(size_t bytes, size_t header, size_t slot_size) {
+        return bytes > header + 4 * slot_size ? (bytes - header) / slot_size : 4;
+    }
+
+    template <class Value, class Ref, class Ptr, class Leaf>
+    struct __btree_iterator {
+        typedef __btree_iterator<Value, Value&, Value*, Leaf>               iterator;
+        typedef __btree_iterator<Value, const Value&, const Value*, Leaf>   const_iterator;
+        typedef __btree_iterator<Value, Ref, Ptr, Leaf>                     self;
+
+        typedef bidirectional_iterator_tag  iterator_category;
+        typedef Value                       value_type;
+        typedef Ptr                         pointer;
+        typedef Ref                         reference;
+        typedef ptrdiff_t                   difference_type;
+
+        Leaf* node;
+        size_t position;
+
+        __btree_iterator() : node(nullptr), position(0) {}
+        __btree_iterator(Leaf* n, size_t i) : node(n), position(i) {}
+        __btree_iterator(const iterator& x) : node(x.node), position(x.position) {}
+        self& operator=(const self&) = default;
+
+        reference operator*() const { return node->values()[position]; }
+        pointer operator->() const { return node->values() + position; }
+
+        // Only the last leaf is ever left at position == count, which is end().
+        self& operator++() {
+            if (++position == node->count && node->next) {
+                node = node->next;
+                position = 0;
+            }
+            return *this;
+        }
+
+        self operator++(int) {
+            self tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        self& operator--() {
+            if (position == 0) {
+                node = node->prev;
+                position = node->count;
+            }
+            --position;
+            return *this;
+        }
+
+        self operator--(int) {
+            self tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        bool operator==(const self& x) const { return node == x.node && position == x.position; }
+        bool operator!=(const self& x) const { return !(*this == x); }
+    };
+
+    template <class Value, class Key, class KeyOfValue, class Compare>
+    struct __btree_lower_compare {
+        Compare comp;
+
+        bool operator()(const Value& x, const Key& k) const { return comp(KeyOfValue()(x), k); }
+    };
+
+    template <class Value, class Key, class KeyOfValue, class Compare>
+    struct __btree_upper_compare {
+        Compare comp;
+
+        bool operator()(const Key& k, const Value& x) const { return comp(k, KeyOfValue()(x)); }
+    };
+
+    // B+tree behind btree_set and btree_map. Values live only in the leaves,
+    // which are chained in key order, so iteration and range scans walk arrays
+    // and follow one pointer per leaf. Internal nodes hold just separator keys
+    // and child pointers, packed so a node spans NodeBytes, a few cache lines;
+    // a lookup then misses about once per level of a tree only log_B(n) deep.
+    //
+    // Separator keys[i] bounds the subtrees around it: everything under
+    // children[i] orders before it, everything under children[i + 1] doesn't.
+    // Nodes other than the root stay at least half full, except that appends
+    // at the right edge split off a new node and leave the old one full, so
+    // ascending inserts pack the tree the way bulk loading does.
+    template <class Key, class Value, class KeyOfValue, class Compare, size_t NodeBytes>
+    class __btree {
+    protected:
+        struct internal_node;
+
+        struct node_base {
+            internal_node* parent;
+            unsigned short position;
+            unsigned short count;
+            bool leaf;
+        };
+
+        static constexpr size_t leaf_slots =
+            __btree_slots(NodeBytes, sizeof(node_base) + 2 * sizeof(void*), sizeof(Value));
+        static constexpr size_t internal_slots =
+            __btree_slots(NodeBytes, sizeof(node_base) + sizeof(void*), sizeof(Key) + sizeof(void*));
+        static constexpr size_t leaf_min = leaf_slots / 2;
+        static constexpr size_t internal_min = internal_slots / 2;
+
+        struct leaf_node : node_base {
+            leaf_node* prev;
+            leaf_node* next;
+            alignas(Value) unsigned char storage[sizeof(Value) * leaf_slots];
+
+            Value* values() { return reinterpret_cast<Value*>(storage); }
+        };
+
+        struct internal_node : node_base {
+            alignas(Key) unsigned char storage[sizeof(Key) * internal_slots];
+            node_base* children[internal_slots + 1];
+
+            Key* keys() { return reinterpret_cast<Key*>(storage); }
+        };
+
+    public:
+        typedef Key                                                             key_type;
+        typedef Value                                                           value_type;
+        typedef Compare                                                         key_compare;
+        typedef size_t                                                          size_type;
+        typedef ptrdiff_t                                                       difference_type;
+        typedef __btree_iterator<Value, Value&, Value*, leaf_node>              iterator;
+        typedef __btree_iterator<Value, const Value&, const Value*, leaf_node>  const_iterator;
+
+    protected:
+        typedef allocator<leaf_node>                                    leaf_allocator;
+        typedef allocator<internal_node>                                internal_allocator;
+        typedef __btree_lower_compare<Value, Key, KeyOfValue, Compare>  lower_compare;
+        typedef __btree_upper_compare<Value, Key, KeyOfValue, Compare>  upper_compare;
+
+        node_base* root;
+        leaf_node* leftmost;
+        leaf_node* rightmost;
+        size_type count;
+        Compare comp;
+
+        static const Key& key(const Value& x) { return KeyOfValue()(x); }
+
+        static leaf_node* new_leaf() {
+            leaf_node* n = ::new (static_cast<void*>(leaf_allocator::allocate(1))) leaf_node;
+            n->parent = nullptr;
+            n->position = 0;
+            n->count = 0;
+            n->leaf = true;
+            n->prev = n->next = nullptr;
+            return n;
+        }
+
+        static internal_node* new_internal() {
+            internal_node* n = ::new (static_cast<void*>(internal_allocator::allocate(1))) internal_node;
+            n->parent = nullptr;
+            n->position = 0;
+            n->count = 0;
+            n->leaf = false;
+            return n;
+        }
+
+        static void set_child(internal_node* p, size_t i, node_base* child) {
+            p->children[i] = child;
+            child->parent = p;
+            child->position = (unsigned short)i;
+        }
+
+        void destroy_node(node_base* n) {
+            if (n->leaf) {
+                leaf_node* l = static_cast<leaf_node*>(n);
+                tinySTL::destroy(l->values(), l->values() + l->count);
+                leaf_allocator::deallocate(l, 1);
+            }
+            else {
+                internal_node* p = static_cast<internal_node*>(n);
+                for (size_t i = 0; i <= p->count; ++i) {
+                    destroy_node(p->children[i]);
+                }
+                tinySTL::destroy(p->keys(), p->keys() + p->count);
+                internal_allocator::deallocate(p, 1);
+            }
+        }
+
+        leaf_node* find_leaf(const Key& k) const {
+            node_base* n = root;
+            while (!n->leaf) {
+                internal_node* p = static_cast<internal_node*>(n);
+                Key* keys = p->keys();
+                n = p->children[tinySTL::upper_bound(keys, keys + p->count, k, comp) - keys];
+            }
+            return static_cast<leaf_node*>(n);
+        }
+
+        size_t leaf_lower_bound(leaf_node* l, const Key& k) const {
+            const lower_compare lcomp = { comp };
+            return size_t(tinySTL::lower_bound(l->values(), l->values() + l->count, k, lcomp) - l->values());
+        }
+
+        size_t leaf_upper_bound(leaf_node* l, const Key& k) const {
+            const upper_compare ucomp = { comp };
+            return size_t(tinySTL::upper_bound(l->values(), l->values() + l->count, k, ucomp) - l->values());
+        }
+
+        // Steps past the end of a leaf other than the last.
+        static iterator make_iterator(leaf_node* l, size_t i) {
+            if (i == l->count && l->next) {
+                return iterator(l->next, 0);
+            }
+            return iterator(l, i);
+        }
+
+        static bool on_right_edge(node_base* n) {
+            for (; n->parent; n = n->parent) {
+                if (n->position != n->parent->count) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static const Key& min_key(node_base* n) {
+            while (!n->leaf) {
+                n = static_cast<internal_node*>(n)->children[0];
+            }
+            return key(static_cast<leaf_node*>(n)->values()[0]);
+        }
+
+        // Takes a node off the list of those allocated ahead of a split, which
+        // are chained through their parent pointers.
+        static internal_node* take_spare(internal_node*& spare) {
+            internal_node* p = spare;
+            spare = p->parent;
+            p->parent = nullptr;
+            return p;
+        }
+
+        // Adds separator sep and the new node right just after left in left's
+        // parent, drawing any nodes it needs from spare.
+        void insert_into_parent(node_base* left, Key&& sep, node_base* right, internal_node*& spare) {
+            internal_node* p = left->parent;
+            if (!p) {
+                p = take_spare(spare);
+                ::new (static_cast<void*>(p->keys())) Key(std::move(sep));
+                set_child(p, 0, left);
+                set_child(p, 1, right);
+                p->count = 1;
+                root = p;
+                return;
+            }
+            if (p->count == internal_slots) {
+                split_internal(p, left->position + 1u, spare);
+                p = left->parent;
+            }
+            const size_t k = left->position;
+            Key* keys = p->keys();
+            for (size_t j = p->count; j > k; --j) {
+                tinySTL::__relocate(keys + j, keys + j - 1);
+                set_child(p, j + 1, p->children[j]);
+            }
+            ::new (static_cast<void*>(keys + k)) Key(std::move(sep));
+            set_child(p, k + 1, right);
+            ++p->count;
+        }
+
+        // Splits a full internal node about to receive a child at index pos.
+        void split_internal(internal_node* p, size_t pos, internal_node*& spare) {
+            internal_node* q = take_spare(spare);
+            const size_t n = p->count;
+            const size_t mid = pos == n + 1 && on_right_edge(p) ? n - 1 : n / 2;
+            Key* keys = p->keys();
+            for (size_t j = mid + 1; j < n; ++j) {
+                tinySTL::__relocate(q->keys() + (j - mid - 1), keys + j);
+            }
+            for (size_t j = mid + 1; j <= n; ++j) {
+                set_child(q, j - mid - 1, p->children[j]);
+            }
+            q->count = (unsigned short)(n - mid - 1);
+            Key up(std::move(keys[mid]));
+            tinySTL::destroy(keys + mid);
+            p->count = (unsigned short)mid;
+            insert_into_parent(p, std::move(up), q, spare);
+        }
+
+        // Splits the full leaf l before value x goes in at index i, and points
+        // l and i at the place x now belongs. The separator is copied and
+        // every node the split reaches is allocated before anything moves, so
+        // if either throws the tree is left as it was.
+        void split_leaf(leaf_node*& l, size_t& i, const Value& x) {
+            const size_t n = l->count;
+            const size_t mid = l == rightmost && i == n ? n : n / 2;
+            Key sep(mid < n ? key(l->values()[mid]) : key(x));
+            size_t internals = 0;
+            internal_node* p = l->parent;
+            for (; p && p->count == internal_slots; p = p->parent) {
+                ++internals;
+            }
+            if (!p) {
+                ++internals;
+            }
+            leaf_node* r = new_leaf();
+            internal_node* spare = nullptr;
+            try {
+                for (; internals > 0; --internals) {
+                    internal_node* q = new_internal();
+                    q->parent = spare;
+                    spare = q;
+                }
+            }
+            catch (...) {
+                while (spare) {
+                    internal_allocator::deallocate(take_spare(spare), 1);
+                }
+                leaf_allocator::deallocate(r, 1);
+                throw;
+            }
+            for (size_t j = mid; j < n; ++j) {
+                tinySTL::__relocate(r->values() + (j - mid), l->values() + j);
+            }
+            r->count = (unsigned short)(n - mid);
+            l->count = (unsigned short)mid;
+            r->next = l->next;
+            r->prev = l;
+            if (r->next) {
+                r->next->prev = r;
+            }
+            else {
+                rightmost = r;
+            }
+            l->next = r;
+            insert_into_parent(l, std::move(sep), r, spare);
+            if (i > mid || mid == leaf_slots) {
+                l = r;
+                i -= mid;
+            }
+        }
+
+        // Relocates the value at x into leaf l at index i.
+        iterator insert_at(leaf_node* l, size_t i, Value* x) {
+            if (l->count == leaf_slots) {
+                try {
+                    split_leaf(l, i, *x);
+                }
+                catch (...) {
+                    tinySTL::destroy(x);
+                    throw;
+                }
+            }
+            Value* values = l->values();
+            for (size_t j = l->count; j > i; --j) {
+                tinySTL::__relocate(values + j, values + j - 1);
+            }
+            tinySTL::__relocate(values + i, x);
+            ++l->count;
+            ++count;
+            return iterator(l, i);
+        }
+
+        // Removes keys[k] and children[k + 1] from p.
+        static void erase_from_internal(internal_node* p, size_t k) {
+            Key* keys = p->keys();
+            tinySTL::destroy(keys + k);
+            for (size_t j = k; j + 1 < p->count; ++j) {
+                tinySTL::__relocate(keys + j, keys + j + 1);
+                set_child(p, j + 1, p->children[j + 2]);
+            }
+            --p->count;
+        }
+
+        void merge_leaves(leaf_node* a, leaf_node* b) {
+            for (size_t j = 0; j < b->count; ++j) {
+                tinySTL::__relocate(a->values() + a->count + j, b->values() + j);
+            }
+            a->count = (unsigned short)(a->count + b->count);
+            a->next = b->next;
+            if (b->next) {
+                b->next->prev = a;
+            }
+            else {
+                rightmost = a;
+            }
+            leaf_allocator::deallocate(b, 1);
+        }
+
+        // Pulls the separator keys[k] of a's parent down between a and its right
+        // sibling b, then appends b to a.
+        static void merge_internal(internal_node* a, internal_node* b, size_t k) {
+            internal_node* p = a->parent;
+            Key* keys = a->keys();
+            ::new (static_cast<void*>(keys + a->count)) Key(std::move(p->keys()[k]));
+            for (size_t j = 0; j < b->count; ++j) {
+                tinySTL::__relocate(keys + a->count + 1 + j, b->keys() + j);
+            }
+            for (size_t j = 0; j <= b->count; ++j) {
+                set_child(a, a->count + 1 + j, b->children[j]);
+            }
+            a->count = (unsigned short)(a->count + 1 + b->count);
+            internal_allocator::deallocate(b, 1);
+            erase_from_internal(p, k);
+        }
+
+        void rebalance_leaf(leaf_node* l) {
+            internal_node* p = l->parent;
+            const size_t i = l->position;
+            leaf_node* left = i > 0 ? static_cast<leaf_node*>(p->children[i - 1]) : nullptr;
+            leaf_node* right = i < p->count ? static_cast<leaf_node*>(p->children[i + 1]) : nullptr;
+            Value* values = l->values();
+            if (left && left->count > leaf_min) {
+                for (size_t j = l->count; j > 0; --j) {
+                    tinySTL::__relocate(values + j, values + j - 1);
+                }
+                tinySTL::__relocate(values, left->values() + left->count - 1);
+                --left->count;
+                ++l->count;
+                p->keys()[i - 1] = key(values[0]);
+                return;
+            }
+            if (right && right->count > leaf_min) {
+                Value* r = right->values();
+                tinySTL::__relocate(values + l->count, r);
+                for (size_t j = 0; j + 1 < right->count; ++j) {
+                    tinySTL::__relocate(r + j, r + j + 1);
+                }
+                ++l->count;
+                --right->count;
+                p->keys()[i] = key(r[0]);
+                return;
+            }
+            if (left) {
+                merge_leaves(left, l);
+                erase_from_internal(p, i - 1);
+            }
+            else {
+                merge_leaves(l, right);
+                erase_from_internal(p, i);
+            }
+            rebalance_internal(p);
+        }
+
+        void rebalance_internal(internal_node* n) {
+            if (n == root) {
+                if (n->count == 0) {
+                    root = n->children[0];
+                    root->parent = nullptr;
+                    root->position = 0;
+                    internal_allocator::deallocate(n, 1);
+                }
+                return;
+            }
+            if (n->count >= internal_min) {
+                return;
+            }
+            internal_node* p = n->parent;
+            const size_t i = n->position;
+            internal_node* left = i > 0 ? static_cast<internal_node*>(p->children[i - 1]) : nullptr;
+            internal_node* right = i < p->count ? static_cast<internal_node*>(p->children[i + 1]) : nullptr;
+            Key* keys = n->keys();
+            if (left && left->count > internal_min) {
+                for (size_t j = n->count; j > 0; --j) {
+                    tinySTL::__relocate(keys + j, keys + j - 1);
+                }
+                for (size_t j = n->count + 1u; j > 0; --j) {
+                    set_child(n, j, n->children[j - 1]);
+                }
+                ::new (static_cast<void*>(keys)) Key(std::move(p->keys()[i - 1]));
+                p->keys()[i - 1] = std::move(left->keys()[left->count - 1]);
+                tinySTL::destroy(left->keys() + left->count - 1);
+                set_child(n, 0, left->children[left->count]);
+                --left->count;
+                ++n->count;
+                return;
+            }
+            if (right && right->count > internal_min) {
+                Key* r = right->keys();
+                ::new (static_cast<void*>(keys + n->count)) Key(std::move(p->keys()[i]));
+                p->keys()[i] = std::move(r[0]);
+                set_child(n, n->count + 1u, right->children[0]);
+                tinySTL::destroy(r);
+                for (size_t j = 0; j + 1 < right->count; ++j) {
+                    tinySTL::__relocate(r + j, r + j + 1);
+                }
+                for (size_t j = 0; j < right->count; ++j) {
+                    set_child(right, j, right->children[j + 1]);
+                }
+                --right->count;
+                ++n->count;
+                return;
+            }
+            if (left) {
+                merge_internal(left, n, i - 1);
+            }
+            else {
+                merge_internal(n, right, i);
+            }
+            rebalance_internal(p);
+        }
+
+        // Builds the tree from sorted, duplicate-free input with every node as
+        // full as the even spread of n values allows.
+        template <class ForwardIterator>
+        void bulk_load(ForwardIterator first, ForwardIterator last) {
+            const size_t n = size_t(tinySTL::distance(first, last));
+            if (n == 0) {
+                return;
+            }
+            const size_t leaves = (n + leaf_slots - 1) / leaf_slots;
+            vector<node_base*> level;
+            level.reserve(leaves);
+            try {
+                for (size_t j = 0; j < leaves; ++j) {
+                    leaf_node* l = new_leaf();
+                    l->prev = rightmost;
+                    if (rightmost) {
+                        rightmost->next = l;
+                    }
+                    else {
+                        leftmost = l;
+                    }
+                    rightmost = l;
+                    level.push_back(l);
+                    const size_t take = n / leaves + (j < n % leaves ? 1 : 0);
+                    for (; l->count < take; ++first) {
+                        ::new (static_cast<void*>(l->values() + l->count)) Value(*first);
+                        ++l->count;
+                    }
+                }
+            }
+            catch (...) {
+                for (leaf_node* l = leftmost; l; ) {
+                    leaf_node* next = l->next;
+                    destroy_node(l);
+                    l = next;
+                }
+                leftmost = rightmost = nullptr;
+                throw;
+            }
+            while (level.size() > 1) {
+                const size_t m = level.size();
+                const size_t parents = (m + internal_slots) / (internal_slots + 1);
+                vector<node_base*> next;
+                next.reserve(parents);
+                size_t c = 0;
+                for (size_t j = 0; j < parents; ++j) {
+                    internal_node* p = new_internal();
+                    const size_t take = m / parents + (j < m % parents ? 1 : 0);
+                    for (size_t t = 0; t < take; ++t) {
+                        set_child(p, t, level[c + t]);
+                        if (t > 0) {
+                            ::new (static_cast<void*>(p->keys() + t - 1)) Key(min_key(level[c + t]));
+                        }
+                    }
+                    p->count = (unsigned short)(take - 1);
+                    c += take;
+                    next.push_back(p);
+                }
+                level = std::move(next);
+            }
+            root = level[0];
+            count = n;
+        }
+
+    public:
+        __btree() : root(nullptr), leftmost(nullptr), rightmost(nullptr), count(0), comp() {}
+        explicit __btree(const Compare& x) : root(nullptr), leftmost(nullptr), rightmost(nullptr), count(0), comp(x) {}
+
+        template <class ForwardIterator>
+        __btree(sorted_unique_t, ForwardIterator first, ForwardIterator last, const Compare& x)
+            : root(nullptr), leftmost(nullptr), rightmost(nullptr), count(0), comp(x) {
+            bulk_load(first, last);
+        }
+
+        __btree(const __btree& x) : root(nullptr), leftmost(nullptr), rightmost(nullptr), count(0), comp(x.comp) {
+            bulk_load(x.begin(), x.end());
+        }
+
+        __btree(__btree&& x) noexcept
+            : root(x.root), leftmost(x.leftmost), rightmost(x.rightmost), count(x.count), comp(x.comp) {
+            x.root = nullptr;
+            x.leftmost = x.rightmost = nullptr;
+            x.count = 0;
+        }
+
+        ~__btree() { clear(); }
+
+        __btree& operator=(const __btree& x) {
+            if (this != &x) {
+                __btree tmp(x);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        __btree& operator=(__btree&& x) noexcept {
+            if (this != &x) {
+                __btree tmp(std::move(x));
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        void swap(__btree& x) {
+            tinySTL::swap(root, x.root);
+            tinySTL::swap(leftmost, x.leftmost);
+            tinySTL::swap(rightmost, x.rightmost);
+            tinySTL::swap(count, x.count);
+            tinySTL::swap(comp, x.comp);
+        }
+
+        iterator begin() const { return iterator(leftmost, 0); }
+        iterator end() const { return iterator(rightmost, rightmost ? rightmost->count : 0); }
+        size_type size() const { return count; }
+        bool empty() const { return count == 0; }
+        key_compare key_comp() const { return comp; }
+
+        void clear() {
+            if (root) {
+                destroy_node(root);
+            }
+            root = nullptr;
+            leftmost = rightmost = nullptr;
+            count = 0;
+        }
+
+        iterator lower_bound(const Key& k) const {
+            if (!root) {
+                return end();
+            }
+            leaf_node* l = find_leaf(k);
+            return make_iterator(l, leaf_lower_bound(l, k));
+        }
+
+        iterator upper_bound(const Key& k) const {
+            if (!root) {
+                return end();
+            }
+            leaf_node* l = find_leaf(k);
+            return make_iterator(l, leaf_upper_bound(l, k));
+        }
+
+        iterator find(const Key& k) const {
+            if (!root) {
+                return end();
+            }
+            leaf_node* l = find_leaf(k);
+            const size_t i = leaf_lower_bound(l, k);
+            return i < l->count && !comp(k, key(l->values()[i])) ? iterator(l, i) : end();
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key& k) const {
+            iterator first = find(k);
+            if (first == end()) {
+                first = lower_bound(k);
+                return std::pair<iterator, iterator>(first, first);
+            }
+            iterator last = first;
+            return std::pair<iterator, iterator>(first, ++last);
+        }
+
+        size_type count_of(const Key& k) const { return find(k) != end() ? 1 : 0; }
+
+        // Inserts Value(args...) unless a value with key k is present; nothing
+        // is constructed when it is.
+        template <class... Args>
+        std::pair<iterator, bool> emplace_key(const Key& k, Args&&... args) {
+            if (!root) {
+                root = leftmost = rightmost = new_leaf();
+            }
+            leaf_node* l = find_leaf(k);
+            const size_t i = leaf_lower_bound(l, k);
+            if (i < l->count && !comp(k, key(l->values()[i]))) {
+                return std::pair<iterator, bool>(iterator(l, i), false);
+            }
+            alignas(Value) unsigned char buffer[sizeof(Value)];
+            Value* x = ::new (static_cast<void*>(buffer)) Value(std::forward<Args>(args)...);
+            return std::pair<iterator, bool>(insert_at(l, i, x), true);
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args&&... args) {
+            alignas(Value) unsigned char buffer[sizeof(Value)];
+            Value* x = ::new (static_cast<void*>(buffer)) Value(std::forward<Args>(args)...);
+            try {
+                if (!root) {
+                    root = leftmost = rightmost = new_leaf();
+                }
+            }
+            catch (...) {
+                tinySTL::destroy(x);
+                throw;
+            }
+            leaf_node* l = find_leaf(key(*x));
+            const size_t i = leaf_lower_bound(l, key(*x));
+            if (i < l->count && !comp(key(*x), key(l->values()[i]))) {
+                tinySTL::destroy(x);
+                return std::pair<iterator, bool>(iterator(l, i), false);
+            }
+            return std::pair<iterator, bool>(insert_at(l, i, x), true);
+        }
+
+        iterator erase(const_iterator position) {
+            leaf_node* l = position.node;
+            const size_t i = position.position;
+            Value* values = l->values();
+            tinySTL::destroy(values + i);
+            for (size_t j = i; j + 1 < l->count; ++j) {
+                tinySTL::__relocate(values + j, values + j + 1);
+            }
+            --l->count;
+            --count;
+            if (l == root) {
+                if (l->count == 0) {
+                    clear();
+                    return end();
+                }
+                return iterator(l, i);
+            }
+            if (l->count >= leaf_min) {
+                return make_iterator(l, i);
+            }
+            // Rebalancing may move the next value to another leaf; find it again.
+            if (i == l->count && !l->next) {
+                rebalance_leaf(l);
+                return end();
+            }
+            const Key next_key(key(i < l->count ? values[i] : l->next->values()[0]));
+            rebalance_leaf(l);
+            return find(next_key);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            for (size_t n = size_t(tinySTL::distance(first, last)); n > 0; --n) {
+                first = erase(first);
+            }
+            return iterator(first.node, first.position);
+        }
+
+        size_type erase_key(const Key& k) {
+            iterator it = find(k);
+            if (it == end()) {
+                return 0;
+            }
+            erase(it);
+            return 1;
+        }
+    };
+}
+
+#endif // _TINY_BTREE_H_
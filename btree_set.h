@@ -0,0 +1,83 @@
+#ifndef _TINY_BTREE_SET_H_
+#define _TINY_BTREE_SET_H_
+
+#include <cstddef>
+#include <utility>
+#include "btree.h"
+#include "functional.h"
+
+namespace tinySTL {
+    // Ordered set on a B+tree whose nodes are NodeBytes wide. Inserts and
+    // erases invalidate iterators, since values move between nodes.
+    template <class Key, class Compare = less<Key>, size_t NodeBytes = 256>
+    class btree_set {
+    private:
+        typedef __btree<Key, Key, identity<Key>, Compare, NodeBytes> rep_type;
+        rep_type t;
+
+    public:
+        typedef Key                                 key_type;
+        typedef Key                                 value_type;
+        typedef Compare                             key_compare;
+        typedef Compare                             value_compare;
+        typedef typename rep_type::size_type        size_type;
+        typedef typename rep_type::difference_type  difference_type;
+        typedef typename rep_type::const_iterator   iterator;
+        typedef typename rep_type::const_iterator   const_iterator;
+
+        btree_set() : t() {}
+        explicit btree_set(const Compare& comp) : t(comp) {}
+
+        template <class InputIterator>
+        btree_set(InputIterator first, InputIterator last, const Compare& comp = Compare()) : t(comp) {
+            insert(first, last);
+        }
+
+        // Builds packed nodes directly from sorted, duplicate-free input in O(n).
+        template <class ForwardIterator>
+        btree_set(sorted_unique_t, ForwardIterator first, ForwardIterator last, const Compare& comp = Compare())
+            : t(sorted_unique, first, last, comp) {}
+
+        iterator begin() const { return t.begin(); }
+        iterator end() const { return t.end(); }
+        size_type size() const { return t.size(); }
+        bool empty() const { return t.empty(); }
+        key_compare key_comp() const { return t.key_comp(); }
+        value_compare value_comp() const { return t.key_comp(); }
+
+        void clear() { t.clear(); }
+
+        iterator find(const key_type& k) const { return t.find(k); }
+        size_type count(const key_type& k) const { return t.count_of(k); }
+        bool contains(const key_type& k) const { return t.count_of(k) != 0; }
+        iterator lower_bound(const key_type& k) const { return t.lower_bound(k); }
+        iterator upper_bound(const key_type& k) const { return t.upper_bound(k); }
+
+        std::pair<iterator, iterator> equal_range(const key_type& k) const {
+            return t.equal_range(k);
+        }
+
+        std::pair<iterator, bool> insert(const value_type& x) { return t.emplace_key(x, x); }
+        std::pair<iterator, bool> insert(value_type&& x) { return t.emplace_key(x, std::move(x)); }
+
+        template <class InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            for (; first != last; ++first) {
+                t.emplace_key(*first, *first);
+            }
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args&&... args) {
+            return t.emplace(std::forward<Args>(args)...);
+        }
+
+        iterator erase(const_iterator position) { return t.erase(position); }
+        iterator erase(const_iterator first, const_iterator last) { return t.erase(first, last); }
+        size_type erase(const key_type& k) { return t.erase_key(k); }
+
+        void swap(btree_set& x) { t.swap(x.t); }
+    };
+}
+
+#endif // _TINY_BTREE_SET_H_
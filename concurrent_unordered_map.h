@@ -0,0 +1,878 @@
+#ifndef _TINY_CONCURRENT_UNORDERED_MAP_H_
+#define _TINY_CONCURRENT_UNORDERED_MAP_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include "allocator.h"
+#include "execution.h"
+#include "functional.h"
+#include "hashtable.h"
+#include "vector.h"
+
+namespace tinySTL {
+    // Epoch-based reclamation. A thread announces the global epoch while it
+    // may hold pointers into a shared structure; memory unlinked at epoch e is
+    // freed once the epoch has reached e + 2, which it can only do after every
+    // thread inside a guard has announced e + 1 or later, so no reader can
+    // still see it.
+    struct __epoch_record {
+        std::atomic<uint64_t> state;    // (epoch << 1) | 1 inside a guard, 0 outside
+        std::atomic<bool> in_use;
+        unsigned depth;
+        __epoch_record* next;
+    };
+
+    // Records are recycled between threads but never freed, so the list can
+    // be walked without locking.
+    class __epoch_domain {
+    private:
+        std::atomic<uint64_t> global;
+        std::atomic<__epoch_record*> head;
+
+    public:
+        __epoch_domain() : global(1), head(nullptr) {}
+
+        __epoch_record* acquire() {
+            for (__epoch_record* r = head.load(std::memory_order_acquire); r; r = r->next) {
+                bool expected = false;
+                if (!r->in_use.load(std::memory_order_relaxed) &&
+                    r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    return r;
+                }
+            }
+            __epoch_record* r = ::new (static_cast<void*>(allocator<__epoch_record>::allocate(1))) __epoch_record;
+            r->state.store(0, std::memory_order_relaxed);
+            r->in_use.store(true, std::memory_order_relaxed);
+            r->depth = 0;
+            r->next = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed)) {
+            }
+            return r;
+        }
+
+        void release(__epoch_record* r) { r->in_use.store(false, std::memory_order_release); }
+
+        void enter(__epoch_record* r) {
+            if (r->depth++ == 0) {
+                r->state.store((global.load(std::memory_order_relaxed) << 1) | 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+
+        void leave(__epoch_record* r) {
+            if (--r->depth == 0) {
+                r->state.store(0, std::memory_order_release);
+            }
+        }
+
+        uint64_t epoch() const { return global.load(std::memory_order_seq_cst); }
+
+        // Moves the epoch on if every thread inside a guard has seen the
+        // current one, and returns the epoch.
+        uint64_t try_advance() {
+            uint64_t e = global.load(std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            for (__epoch_record* r = head.load(std::memory_order_acquire); r; r = r->next) {
+                const uint64_t s = r->state.load(std::memory_order_seq_cst);
+                if ((s & 1) && (s >> 1) != e) {
+                    return e;
+                }
+            }
+            global.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+            return global.load(std::memory_order_seq_cst);
+        }
+    };
+
+    inline __epoch_domain& __epoch_global() {
+        static __epoch_domain domain;
+        return domain;
+    }
+
+    struct __epoch_thread {
+        __epoch_record* record;
+
+        __epoch_thread() : record(tinySTL::__epoch_global().acquire()) {}
+        ~__epoch_thread() { tinySTL::__epoch_global().release(record); }
+    };
+
+    inline __epoch_record* __epoch_this_thread() {
+        thread_local __epoch_thread t;
+        return t.record;
+    }
+
+    // Guards nest, so a callback running under one can take another.
+    class __epoch_guard {
+    private:
+        __epoch_record* record;
+
+    public:
+        __epoch_guard() : record(tinySTL::__epoch_this_thread()) { tinySTL::__epoch_global().enter(record); }
+        ~__epoch_guard() { tinySTL::__epoch_global().leave(record); }
+
+        __epoch_guard(const __epoch_guard&) = delete;
+        __epoch_guard& operator=(const __epoch_guard&) = delete;
+    };
+
+    struct __epoch_retired {
+        void* p;
+        void (*dispose)(void*);
+        uint64_t epoch;
+    };
+
+    // Frees what has been unlinked for two epochs and keeps the rest.
+    inline void __epoch_reclaim(vector<__epoch_retired>& garbage, uint64_t epoch) {
+        size_t kept = 0;
+        for (size_t i = 0; i < garbage.size(); ++i) {
+            if (garbage[i].epoch + 2 <= epoch) {
+                garbage[i].dispose(garbage[i].p);
+            }
+            else {
+                garbage[kept++] = garbage[i];
+            }
+        }
+        while (garbage.size() > kept) {
+            garbage.pop_back();
+        }
+    }
+
+    // A hash map many threads can read and write at once. Each entry is an
+    // immutable node, and the table is an open-addressing array of atomic
+    // pointers to them, probed linearly:
+    //
+    // - Lookups take no lock and write nothing shared. Nodes and tables
+    //   are freed through epoch-based reclamation, so a reader's pointers
+    //   stay valid until it is done.
+    // - Writers lock one of a set of stripes chosen by the key's hash, so
+    //   writes to the same key are serialized while others proceed. Slots
+    //   are claimed with compare-and-swap, since probe sequences cross
+    //   stripes. A changed value is a new node swapped into the slot; a
+    //   slot never returns to empty, so probe chains stay unbroken.
+    // - Growing the table moves entries to the new one a chunk at a time,
+    //   with every writer doing a share before its own operation. Lookups
+    //   check the old table, then the new one. A writer waits for the move
+    //   to finish only if the new table has no room left for its entry.
+    //
+    // There are no iterators. find copies the value out, visit runs a
+    // function on it in place, and update and upsert apply a function to a
+    // copy and publish it.
+    template <class Key, class T, class Hash = hash<Key>, class KeyEqual = equal_to<Key>>
+    class concurrent_unordered_map {
+    public:
+        typedef Key                             key_type;
+        typedef T                               mapped_type;
+        typedef std::pair<const Key, T>         value_type;
+        typedef Hash                            hasher;
+        typedef KeyEqual                        key_equal;
+        typedef size_t                          size_type;
+
+    private:
+        struct node {
+            size_type hash;
+            value_type value;
+
+            template <class... Args>
+            node(size_type h, Args&&... args) : hash(h), value(std::forward<Args>(args)...) {}
+        };
+
+        struct table {
+            size_type cap;
+            std::atomic<size_type> used;        // slots no longer empty or reserved for an entry being added
+            std::atomic<size_type> incoming;    // entries still to be moved in from the table before
+            std::atomic<table*> next;           // where the entries are being moved
+            std::atomic<size_type> claimed;     // slots handed out to movers
+            std::atomic<size_type> moved;       // slots they have finished
+            std::atomic<node*>* slots;
+        };
+
+        // Padded so neighbouring stripes' locks don't share a cache line.
+        struct stripe {
+            std::mutex lock;
+            std::atomic<size_type> count;
+            vector<__epoch_retired> garbage;
+            size_type reclaim_at;
+            char pad[64];
+
+            stripe() : count(0), reclaim_at(64) {}
+        };
+
+        typedef allocator<node>                 node_allocator;
+        typedef allocator<table>                table_allocator;
+        typedef allocator<std::atomic<node*>>   slot_allocator;
+        typedef allocator<stripe>               stripe_allocator;
+
+        enum {
+            min_capacity = 16,
+            move_chunk = 64
+        };
+
+        mutable std::atomic<table*> current;
+        stripe* stripes;
+        size_type stripe_mask;
+        mutable std::mutex resize_lock;
+        mutable vector<__epoch_retired> retired_tables;
+        Hash hash;
+        KeyEqual equal;
+
+        // Markers for an erased slot and for one whose entry went to the next table.
+        static node* tombstone() { return reinterpret_cast<node*>(uintptr_t(1)); }
+        static node* moved_marker() { return reinterpret_cast<node*>(uintptr_t(2)); }
+        static bool is_node(const node* p) { return uintptr_t(p) > 2; }
+
+        static size_type capacity_for(size_type n) {
+            size_type cap = min_capacity;
+            while (cap - cap / 4 < n) {
+                cap <<= 1;
+            }
+            return cap;
+        }
+
+        static size_type limit(const table* t) { return t->cap - t->cap / 4; }
+
+        static bool overloaded(const table* t) {
+            return t->incoming.load(std::memory_order_acquire) + t->used.load(std::memory_order_acquire) >= limit(t);
+        }
+
+        // Admits one more entry to t if the slots in use, those reserved and
+        // those still owed to entries moving in stay under t's limit, which
+        // leaves an empty slot in every table. incoming is read first: a move
+        // adds to used before taking itself off incoming, so the sum is never
+        // seen short.
+        static bool reserve_slot(table* t) {
+            while (true) {
+                const size_type owed = t->incoming.load(std::memory_order_acquire);
+                size_type u = t->used.load(std::memory_order_acquire);
+                if (owed + u >= limit(t)) {
+                    return false;
+                }
+                if (t->used.compare_exchange_weak(u, u + 1, std::memory_order_acq_rel)) {
+                    return true;
+                }
+            }
+        }
+
+        static table* new_table(size_type cap) {
+            table* t = table_allocator::allocate(1);
+            try {
+                t->slots = slot_allocator::allocate(cap);
+            }
+            catch (...) {
+                table_allocator::deallocate(t, 1);
+                throw;
+            }
+            for (size_type i = 0; i < cap; ++i) {
+                ::new (static_cast<void*>(t->slots + i)) std::atomic<node*>(nullptr);
+            }
+            t->cap = cap;
+            ::new (static_cast<void*>(&t->used)) std::atomic<size_type>(0);
+            ::new (static_cast<void*>(&t->incoming)) std::atomic<size_type>(0);
+            ::new (static_cast<void*>(&t->next)) std::atomic<table*>(nullptr);
+            ::new (static_cast<void*>(&t->claimed)) std::atomic<size_type>(0);
+            ::new (static_cast<void*>(&t->moved)) std::atomic<size_type>(0);
+            return t;
+        }
+
+        static void dispose_table(void* p) {
+            table* t = static_cast<table*>(p);
+            slot_allocator::deallocate(t->slots, t->cap);
+            table_allocator::deallocate(t, 1);
+        }
+
+        template <class... Args>
+        static node* new_node(size_type h, Args&&... args) {
+            node* n = node_allocator::allocate(1);
+            try {
+                ::new (static_cast<void*>(n)) node(h, std::forward<Args>(args)...);
+            }
+            catch (...) {
+                node_allocator::deallocate(n, 1);
+                throw;
+            }
+            return n;
+        }
+
+        static void dispose_node(void* p) {
+            node* n = static_cast<node*>(p);
+            n->~node();
+            node_allocator::deallocate(n, 1);
+        }
+
+        // For a table that owns its entries outright, as clear leaves it.
+        static void dispose_table_and_nodes(void* p) {
+            table* t = static_cast<table*>(p);
+            for (size_type i = 0; i < t->cap; ++i) {
+                node* n = t->slots[i].load(std::memory_order_relaxed);
+                if (is_node(n)) {
+                    dispose_node(n);
+                }
+            }
+            dispose_table(t);
+        }
+
+        size_type hash_of(const key_type& k) const { return tinySTL::__hash_mix(hash(k)); }
+
+        // Probes use the low bits of the hash, stripes the high ones.
+        stripe& stripe_of(size_type h) const { return stripes[(h >> (sizeof(size_type) * 4)) & stripe_mask]; }
+
+        // Makes room in the stripe's garbage list before anything is unlinked,
+        // so retiring can't fail halfway through an update.
+        static void reserve_garbage(stripe& s) {
+            if (s.garbage.size() == s.garbage.capacity()) {
+                s.garbage.reserve(s.garbage.capacity() < 16 ? 16 : 2 * s.garbage.capacity());
+            }
+        }
+
+        static void retire(stripe& s, node* n) {
+            __epoch_retired r = { n, &dispose_node, tinySTL::__epoch_global().epoch() };
+            s.garbage.push_back(r);
+            if (s.garbage.size() >= s.reclaim_at) {
+                tinySTL::__epoch_reclaim(s.garbage, tinySTL::__epoch_global().try_advance());
+                s.reclaim_at = s.garbage.size() * 2 < 64 ? 64 : s.garbage.size() * 2;
+            }
+        }
+
+        // The node for k in t or the tables it is moving to, or null.
+        node* find_node(const key_type& k, size_type h) const {
+            for (const table* t = current.load(std::memory_order_acquire); t; t = t->next.load(std::memory_order_acquire)) {
+                const size_type mask = t->cap - 1;
+                size_type i = h & mask;
+                for (size_type n = 0; n < t->cap; ++n, i = (i + 1) & mask) {
+                    node* p = t->slots[i].load(std::memory_order_acquire);
+                    if (!p) {
+                        break;
+                    }
+                    if (is_node(p) && p->hash == h && equal(p->value.first, k)) {
+                        return p;
+                    }
+                }
+            }
+            return nullptr;
+        }
+
+        // Puts n into the first free slot of t from i on, erased or empty.
+        // An entry admitted by reserve_slot is already counted in used; one
+        // moved in is counted now and comes off incoming. Returns false,
+        // dropping any reservation, if no slot is free, which the admission
+        // limit rules out.
+        static bool place(table* t, size_type i, node* n, bool reserved) {
+            const size_type mask = t->cap - 1;
+            for (size_type probes = 0; probes < t->cap; ++probes, ++i) {
+                std::atomic<node*>& slot = t->slots[i & mask];
+                node* p = slot.load(std::memory_order_seq_cst);
+                while (!p || p == tombstone()) {
+                    if (slot.compare_exchange_strong(p, n, std::memory_order_seq_cst)) {
+                        if (!p && !reserved) {
+                            t->used.fetch_add(1, std::memory_order_acq_rel);
+                        }
+                        else if (p && reserved) {
+                            t->used.fetch_sub(1, std::memory_order_acq_rel);
+                        }
+                        if (!reserved) {
+                            t->incoming.fetch_sub(1, std::memory_order_acq_rel);
+                        }
+                        return true;
+                    }
+                }
+            }
+            if (reserved) {
+                t->used.fetch_sub(1, std::memory_order_acq_rel);
+            }
+            return false;
+        }
+
+        // With k's stripe locked: moves k's entry, if any, from t to next.
+        void move_key(table* t, table* next, const key_type& k, size_type h) {
+            const size_type mask = t->cap - 1;
+            size_type i = h & mask;
+            for (size_type n = 0; n < t->cap; ++n, i = (i + 1) & mask) {
+                node* p = t->slots[i].load(std::memory_order_seq_cst);
+                if (!p) {
+                    return;
+                }
+                if (is_node(p) && p->hash == h && equal(p->value.first, k)) {
+                    if (place(next, h, p, false)) {
+                        t->slots[i].store(moved_marker(), std::memory_order_seq_cst);
+                    }
+                    return;
+                }
+            }
+        }
+
+        // With no stripe locked: moves slot i's entry, if any, from t to next.
+        // Returns false if next had no room, leaving the entry in t.
+        bool move_slot(table* t, table* next, size_type i) const {
+            while (true) {
+                node* p = t->slots[i].load(std::memory_order_seq_cst);
+                if (!is_node(p)) {
+                    return true;
+                }
+                stripe& s = stripe_of(p->hash);
+                std::lock_guard<std::mutex> lock(s.lock);
+                if (t->slots[i].load(std::memory_order_seq_cst) == p) {
+                    if (!place(next, p->hash, p, false)) {
+                        return false;
+                    }
+                    t->slots[i].store(moved_marker(), std::memory_order_seq_cst);
+                    return true;
+                }
+            }
+        }
+
+        // Moves one chunk of the table being resized, if there is one, and
+        // switches to the new table after the last chunk. A slot that could
+        // not be moved is not counted, so t is never retired with an entry
+        // still in it. Returns false when no chunk was left to take.
+        bool help_resize() const {
+            table* t = current.load(std::memory_order_acquire);
+            table* next = t->next.load(std::memory_order_seq_cst);
+            if (!next) {
+                return false;
+            }
+            const size_type first = t->claimed.fetch_add(move_chunk, std::memory_order_relaxed);
+            if (first >= t->cap) {
+                return false;
+            }
+            const size_type last = first + move_chunk < t->cap ? first + move_chunk : t->cap;
+            size_type done = 0;
+            for (size_type i = first; i < last; ++i) {
+                done += move_slot(t, next, i);
+            }
+            if (t->moved.fetch_add(done, std::memory_order_acq_rel) + done == t->cap) {
+                std::lock_guard<std::mutex> lock(resize_lock);
+                current.store(next, std::memory_order_seq_cst);
+                __epoch_retired r = { t, &dispose_table, tinySTL::__epoch_global().epoch() };
+                retired_tables.push_back(r);
+            }
+            return true;
+        }
+
+        // Starts moving t's entries to a new table, unless t is no longer
+        // current or already being resized. The new table has new_cap slots,
+        // or if that is 0, twice t's, or as many if most of t's slots hold
+        // erased entries; in any case enough to take all of t's entries with
+        // room to spare. Every stripe is held while next is set, so no write
+        // aimed at t is under way, t holds exactly size() entries, and the
+        // new table is owed that many.
+        void start_resize(table* t, size_type new_cap) {
+            std::lock_guard<std::mutex> lock(resize_lock);
+            if (current.load(std::memory_order_acquire) != t || t->next.load(std::memory_order_acquire)) {
+                return;
+            }
+            tinySTL::__epoch_reclaim(retired_tables, tinySTL::__epoch_global().try_advance());
+            lock_all();
+            const size_type live = size();
+            if (!new_cap) {
+                new_cap = live > t->cap / 4 + t->cap / 8 ? 2 * t->cap : t->cap;
+            }
+            while (new_cap - new_cap / 4 <= live) {
+                new_cap <<= 1;
+            }
+            table* next;
+            try {
+                next = new_table(new_cap);
+            }
+            catch (...) {
+                unlock_all();
+                throw;
+            }
+            next->incoming.store(live, std::memory_order_relaxed);
+            t->next.store(next, std::memory_order_seq_cst);
+            unlock_all();
+        }
+
+        // Grows t once its entries, reserved or still owed, reach its limit.
+        void maybe_resize(table* t) {
+            if (overloaded(t)) {
+                start_resize(t, 0);
+            }
+        }
+
+        // With no stripe locked, after t, the newest table, refused an
+        // entry: waits for any move into t to finish, then grows it.
+        void make_room(table* t) {
+            finish_resize();
+            start_resize(t, 0);
+        }
+
+        // With k's stripe locked: brings k's entry into the newest table and
+        // returns that table.
+        table* settle(const key_type& k, size_type h) {
+            table* t = current.load(std::memory_order_acquire);
+            for (table* next; (next = t->next.load(std::memory_order_seq_cst)) != nullptr; t = next) {
+                move_key(t, next, k, h);
+            }
+            return t;
+        }
+
+        // With k's stripe locked and t settled: the slot holding k in t, the
+        // first free slot on its probe path in *free, or null in both. A
+        // moved marker means t is being resized again, which the caller
+        // retries on.
+        std::atomic<node*>* probe(table* t, const key_type& k, size_type h, std::atomic<node*>** free, bool* stale) {
+            const size_type mask = t->cap - 1;
+            *free = nullptr;
+            *stale = false;
+            size_type i = h & mask;
+            for (size_type n = 0; n < t->cap; ++n, i = (i + 1) & mask) {
+                node* p = t->slots[i].load(std::memory_order_seq_cst);
+                if (p == moved_marker()) {
+                    *stale = true;
+                    return nullptr;
+                }
+                if (!p || p == tombstone()) {
+                    if (!*free) {
+                        *free = t->slots + i;
+                    }
+                    if (!p) {
+                        return nullptr;
+                    }
+                }
+                else if (p->hash == h && equal(p->value.first, k)) {
+                    return t->slots + i;
+                }
+            }
+            return nullptr;
+        }
+
+        // The writers' common path. With k's stripe locked, calls
+        // op(stripe, hash, slot), where slot holds k in the newest table or is
+        // null. op changes or erases k's entry through slot; or, for Adds and
+        // a null slot, returns a new node for k, which is published once the
+        // table admits it. A full table is grown with no lock held, and the
+        // write retried. Returns whether an entry was added.
+        template <bool Adds, class Op>
+        bool write(const key_type& k, Op op) {
+            const size_type h = hash_of(k);
+            __epoch_guard guard;
+            help_resize();
+            while (true) {
+                table* t;
+                bool added = false;
+                bool full = false;
+                {
+                    stripe& s = stripe_of(h);
+                    std::lock_guard<std::mutex> lock(s.lock);
+                    reserve_garbage(s);
+                    std::atomic<node*>* slot;
+                    std::atomic<node*>* free;
+                    bool stale;
+                    do {
+                        t = settle(k, h);
+                        slot = probe(t, k, h, &free, &stale);
+                    } while (stale);
+                    if (slot || !Adds) {
+                        op(s, h, slot);
+                    }
+                    else if (!free || !reserve_slot(t)) {
+                        full = true;
+                    }
+                    else {
+                        node* n;
+                        try {
+                            n = op(s, h, slot);
+                        }
+                        catch (...) {
+                            t->used.fetch_sub(1, std::memory_order_acq_rel);
+                            throw;
+                        }
+                        if (place(t, size_type(free - t->slots), n, true)) {
+                            s.count.fetch_add(1, std::memory_order_relaxed);
+                            added = true;
+                        }
+                        else {
+                            dispose_node(n);
+                            full = true;
+                        }
+                    }
+                }
+                if (!full) {
+                    maybe_resize(t);
+                    return added;
+                }
+                make_room(t);
+            }
+        }
+
+        template <class... Args>
+        bool insert_node(const key_type& k, Args&&... args) {
+            return write<true>(k, [&](stripe&, size_type h, std::atomic<node*>* slot) -> node* {
+                return slot ? nullptr : new_node(h, std::forward<Args>(args)...);
+            });
+        }
+
+        void lock_all() const {
+            for (size_type i = 0; i <= stripe_mask; ++i) {
+                stripes[i].lock.lock();
+            }
+        }
+
+        void unlock_all() const {
+            for (size_type i = 0; i <= stripe_mask; ++i) {
+                stripes[i].lock.unlock();
+            }
+        }
+
+        void finish_resize() const {
+            __epoch_guard guard;
+            while (current.load(std::memory_order_acquire)->next.load(std::memory_order_seq_cst)) {
+                if (!help_resize()) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    public:
+        // concurrency is the number of threads expected to write at once;
+        // 0 means one per hardware thread.
+        explicit concurrent_unordered_map(size_type n = 0, unsigned concurrency = 0,
+                                          const Hash& hf = Hash(), const KeyEqual& eq = KeyEqual())
+            : stripes(nullptr), stripe_mask(0), hash(hf), equal(eq) {
+            const size_type wanted = 8 * size_type(concurrency ? concurrency : tinySTL::hardware_concurrency());
+            size_type count = 16;
+            while (count < wanted && count < 1024) {
+                count <<= 1;
+            }
+            current.store(new_table(capacity_for(n)), std::memory_order_relaxed);
+            try {
+                stripes = stripe_allocator::allocate(count);
+            }
+            catch (...) {
+                dispose_table(current.load(std::memory_order_relaxed));
+                throw;
+            }
+            for (size_type i = 0; i < count; ++i) {
+                ::new (static_cast<void*>(stripes + i)) stripe();
+            }
+            stripe_mask = count - 1;
+        }
+
+        // Needs exclusive access, like any destructor.
+        ~concurrent_unordered_map() {
+            for (table* t = current.load(std::memory_order_relaxed); t; ) {
+                for (size_type i = 0; i < t->cap; ++i) {
+                    node* p = t->slots[i].load(std::memory_order_relaxed);
+                    if (is_node(p)) {
+                        dispose_node(p);
+                    }
+                }
+                table* next = t->next.load(std::memory_order_relaxed);
+                dispose_table(t);
+                t = next;
+            }
+            for (size_type i = 0; i <= stripe_mask; ++i) {
+                tinySTL::__epoch_reclaim(stripes[i].garbage, ~uint64_t(0));
+                stripes[i].~stripe();
+            }
+            stripe_allocator::deallocate(stripes, stripe_mask + 1);
+            tinySTL::__epoch_reclaim(retired_tables, ~uint64_t(0));
+        }
+
+        concurrent_unordered_map(const concurrent_unordered_map&) = delete;
+        concurrent_unordered_map& operator=(const concurrent_unordered_map&) = delete;
+
+        // Exact when no writes are in flight.
+        size_type size() const {
+            size_type n = 0;
+            for (size_type i = 0; i <= stripe_mask; ++i) {
+                n += stripes[i].count.load(std::memory_order_relaxed);
+            }
+            return n;
+        }
+
+        bool empty() const { return size() == 0; }
+        size_type bucket_count() const { return current.load(std::memory_order_acquire)->cap; }
+        hasher hash_function() const { return hash; }
+        key_equal key_eq() const { return equal; }
+
+        bool find(const key_type& k, T& value) const {
+            __epoch_guard guard;
+            const node* n = find_node(k, hash_of(k));
+            if (!n) {
+                return false;
+            }
+            value = n->value.second;
+            return true;
+        }
+
+        bool contains(const key_type& k) const {
+            __epoch_guard guard;
+            return find_node(k, hash_of(k)) != nullptr;
+        }
+
+        // Calls f(const value_type&) on k's entry without copying it. The
+        // entry is a snapshot; writes made meanwhile go to a new node.
+        template <class F>
+        bool visit(const key_type& k, F f) const {
+            __epoch_guard guard;
+            const node* n = find_node(k, hash_of(k));
+            if (!n) {
+                return false;
+            }
+            f(n->value);
+            return true;
+        }
+
+        bool insert(const value_type& x) { return insert_node(x.first, x); }
+        bool insert(value_type&& x) { return insert_node(x.first, std::move(x)); }
+
+        template <class... Args>
+        bool try_emplace(const key_type& k, Args&&... args) {
+            return insert_node(k, std::piecewise_construct, std::forward_as_tuple(k),
+                               std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        // Returns true if k was added, false if its value was replaced.
+        template <class M>
+        bool insert_or_assign(const key_type& k, M&& obj) {
+            return write<true>(k, [&](stripe& s, size_type h, std::atomic<node*>* slot) -> node* {
+                node* n = new_node(h, k, std::forward<M>(obj));
+                if (!slot) {
+                    return n;
+                }
+                node* old = slot->load(std::memory_order_relaxed);
+                slot->store(n, std::memory_order_release);
+                retire(s, old);
+                return nullptr;
+            });
+        }
+
+        // Replaces k's value with f applied to a copy of it; returns false
+        // if k is absent. f runs under k's stripe lock.
+        template <class F>
+        bool update(const key_type& k, F f) {
+            bool found = false;
+            write<false>(k, [&](stripe& s, size_type, std::atomic<node*>* slot) -> node* {
+                if (slot) {
+                    node* old = slot->load(std::memory_order_relaxed);
+                    node* n = new_node(old->hash, old->value);
+                    try {
+                        f(n->value.second);
+                    }
+                    catch (...) {
+                        dispose_node(n);
+                        throw;
+                    }
+                    slot->store(n, std::memory_order_release);
+                    retire(s, old);
+                    found = true;
+                }
+                return nullptr;
+            });
+            return found;
+        }
+
+        // update(k, f) if k is present, try_emplace(k, init) if not. Returns
+        // true if k was added.
+        template <class F>
+        bool upsert(const key_type& k, F f, const T& init) {
+            return write<true>(k, [&](stripe& s, size_type h, std::atomic<node*>* slot) -> node* {
+                if (!slot) {
+                    return new_node(h, k, init);
+                }
+                node* old = slot->load(std::memory_order_relaxed);
+                node* n = new_node(h, old->value);
+                try {
+                    f(n->value.second);
+                }
+                catch (...) {
+                    dispose_node(n);
+                    throw;
+                }
+                slot->store(n, std::memory_order_release);
+                retire(s, old);
+                return nullptr;
+            });
+        }
+
+        size_type erase(const key_type& k) {
+            size_type erased = 0;
+            write<false>(k, [&](stripe& s, size_type, std::atomic<node*>* slot) -> node* {
+                if (slot) {
+                    node* old = slot->load(std::memory_order_relaxed);
+                    slot->store(tombstone(), std::memory_order_release);
+                    retire(s, old);
+                    s.count.fetch_sub(1, std::memory_order_relaxed);
+                    erased = 1;
+                }
+                return nullptr;
+            });
+            return erased;
+        }
+
+        // Makes room for n entries, waiting for the table to be rebuilt.
+        void reserve(size_type n) {
+            const size_type cap = capacity_for(n);
+            while (true) {
+                finish_resize();
+                table* t = current.load(std::memory_order_acquire);
+                if (t->cap >= cap) {
+                    return;
+                }
+                start_resize(t, cap);
+            }
+        }
+
+        // Calls f(const value_type&) on every entry. Writers wait until it
+        // returns, so it sees one consistent state; readers carry on. f must
+        // not write to the map.
+        template <class F>
+        void for_each(F f) const {
+            finish_resize();
+            __epoch_guard guard;
+            lock_all();
+            try {
+                for (const table* t = current.load(std::memory_order_acquire); t; t = t->next.load(std::memory_order_acquire)) {
+                    for (size_type i = 0; i < t->cap; ++i) {
+                        const node* p = t->slots[i].load(std::memory_order_acquire);
+                        if (is_node(p)) {
+                            f(p->value);
+                        }
+                    }
+                }
+            }
+            catch (...) {
+                unlock_all();
+                throw;
+            }
+            unlock_all();
+        }
+
+        // Safe alongside other operations; entries written while it runs
+        // may or may not survive.
+        void clear() {
+            table* fresh = new_table(min_capacity);
+            std::unique_lock<std::mutex> resize(resize_lock, std::defer_lock);
+            while (true) {
+                finish_resize();
+                resize.lock();
+                if (!current.load(std::memory_order_acquire)->next.load(std::memory_order_seq_cst)) {
+                    break;
+                }
+                resize.unlock();
+            }
+            try {
+                retired_tables.reserve(retired_tables.size() + 1);
+            }
+            catch (...) {
+                dispose_table(fresh);
+                throw;
+            }
+            lock_all();
+            table* t = current.load(std::memory_order_acquire);
+            current.store(fresh, std::memory_order_seq_cst);
+            __epoch_retired r = { t, &dispose_table_and_nodes, tinySTL::__epoch_global().epoch() };
+            retired_tables.push_back(r);
+            for (size_type i = 0; i <= stripe_mask; ++i) {
+                stripes[i].count.store(0, std::memory_order_relaxed);
+            }
+            unlock_all();
+        }
+    };
+}
+
+#endif // _TINY_CONCURRENT_UNORDERED_MAP_H_
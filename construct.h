@@ -1,7 +1,10 @@
 #ifndef _TINY_CONSTRUCT_H_
 #define _TINY_CONSTRUCT_H_
 
+#include <cstring>
 #include <new>
+#include <type_traits>
+#include <utility>
 
 namespace tinySTL {
     template <class T>
@@ -16,7 +19,7 @@ namespace tinySTL {
 
     template <class T>
     void construct(T* ptr, T&& value) {
-        ::new ((void*)ptr) T(move(value));
+        ::new ((void*)ptr) T(std::move(value));
     }
 
     template <class T>
@@ -26,11 +29,64 @@ namespace tinySTL {
 
     template <class T>
     void destroy(T* first, T* last) {
+        if (std::is_trivially_destructible<T>::value) {
+            return;
+        }
         while (first != last) {
             first -> ~T();
             ++first;
         }
     }
+
+    template <class ForwardIterator>
+    void destroy(ForwardIterator first, ForwardIterator last) {
+        while (first != last) {
+            destroy(&*first);
+            ++first;
+        }
+    }
+
+    // Types whose objects can be moved to new storage with memcpy, the old
+    // copy then being reused as raw memory without running its destructor.
+    // Trivially copyable types qualify; a class that holds no pointers into
+    // itself can opt in by specializing this.
+    template <class T>
+    struct __is_relocatable : std::is_trivially_copyable<T> {};
+
+    template <class T1, class T2>
+    struct __is_relocatable<std::pair<T1, T2>> : std::integral_constant<bool,
+        __is_relocatable<typename std::remove_const<T1>::type>::value
+        && __is_relocatable<typename std::remove_const<T2>::type>::value> {};
+
+    template <class T>
+    inline void __relocate_bytes(T* dst, T* src) {
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T));
+    }
+
+    // Moves *src into raw storage at dst and ends the lifetime of *src.
+    template <class T>
+    inline void __relocate(T* dst, T* src) {
+        if (__is_relocatable<T>::value) {
+            tinySTL::__relocate_bytes(dst, src);
+            return;
+        }
+        ::new (static_cast<void*>(dst)) T(std::move(*src));
+        src->~T();
+    }
+
+    // The key of a map entry is const, but the source is destroyed right after,
+    // so it is safe to move from; this keeps relocation cheap for string keys
+    // and possible for move-only ones.
+    template <class Key, class T>
+    inline void __relocate(std::pair<const Key, T>* dst, std::pair<const Key, T>* src) {
+        if (__is_relocatable<std::pair<const Key, T>>::value) {
+            tinySTL::__relocate_bytes(dst, src);
+            return;
+        }
+        ::new (static_cast<void*>(dst)) std::pair<const Key, T>(std::move(const_cast<Key&>(src->first)),
+                                                               std::move(src->second));
+        src->~pair();
+    }
 }
 
 #endif // _TINY_CONSTRUCT_H_
\ No newline at end of file
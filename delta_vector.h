@@ -0,0 +1,210 @@
+#ifndef _TINY_DELTA_VECTOR_H_
+#define _TINY_DELTA_VECTOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "algorithm.h"
+#include "iterator.h"
+#include "packed_vector.h"
+#include "vector.h"
+
+namespace tinySTL {
+    // A non-decreasing sequence of unsigned integers, compressed by frame of
+    // reference: each block of 128 keeps its first value and the rest as
+    // offsets from it, bit-packed at the width its largest offset needs.
+    // Dense ids or offsets shrink to a few bits each; a value still costs
+    // O(1) to read, and lower_bound narrows to one block through the block
+    // bases. Values are appended to an uncompressed tail, which is packed
+    // once it fills a block.
+    class delta_vector {
+    public:
+        typedef uint64_t        value_type;
+        typedef size_t          size_type;
+        typedef ptrdiff_t       difference_type;
+
+        typedef __packed_decode_iterator<delta_vector> const_iterator;
+        typedef const_iterator iterator;
+
+    private:
+        struct block {
+            uint64_t base;
+            size_t offset;      // into words
+            unsigned width;
+        };
+
+        vector<block> blocks;
+        vector<uint64_t> words;
+        uint64_t tail[__packed_block];
+        size_type tail_size;
+
+        // Packs the first 128 values at values as a new block.
+        void append_block(const uint64_t* values) {
+            const unsigned width = tinySTL::__packed_bit_width(values[__packed_block - 1] - values[0]);
+            const block b = { values[0], words.size(), width };
+            const size_t n = tinySTL::__packed_block_words(width);
+            if (words.size() + n > words.capacity()) {
+                words.reserve(words.size() + n > 2 * words.capacity() ? words.size() + n : 2 * words.capacity());
+            }
+            for (size_t i = 0; i < n; ++i) {
+                words.push_back(0);
+            }
+            blocks.push_back(b);
+            tinySTL::__packed_pack(values, width, b.base, words.begin() + b.offset);
+        }
+
+        // Index of the first element >= x in [first, last), which are known
+        // to lie in one block or the tail.
+        size_type search(size_type first, size_type last, uint64_t x) const {
+            while (first < last) {
+                const size_type mid = first + (last - first) / 2;
+                if ((*this)[mid] < x) {
+                    first = mid + 1;
+                }
+                else {
+                    last = mid;
+                }
+            }
+            return first;
+        }
+
+    public:
+        delta_vector() : tail_size(0) {}
+
+        // v must be sorted.
+        explicit delta_vector(const vector<uint64_t>& v) : tail_size(0) {
+            reserve(v.size());
+            for (size_type i = 0; i < v.size(); ++i) {
+                if (i && v[i] < v[i - 1]) {
+                    throw std::invalid_argument("delta_vector: values must be sorted");
+                }
+            }
+            size_type i = 0;
+            for (; i + __packed_block <= v.size(); i += __packed_block) {
+                append_block(v.begin() + i);
+            }
+            for (; i < v.size(); ++i) {
+                tail[tail_size++] = v[i];
+            }
+        }
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, size()); }
+        size_type size() const { return blocks.size() * __packed_block + tail_size; }
+        bool empty() const { return size() == 0; }
+
+        // Bytes of compressed storage in use, tail included.
+        size_type bytes() const {
+            return words.size() * sizeof(uint64_t) + blocks.size() * sizeof(block) + sizeof(tail);
+        }
+
+        uint64_t operator[](size_type n) const {
+            const size_type b = n / __packed_block;
+            if (b == blocks.size()) {
+                return tail[n % __packed_block];
+            }
+            const block& blk = blocks[b];
+            return blk.width ? blk.base + tinySTL::__packed_get(words.begin() + blk.offset, blk.width, n % __packed_block) : blk.base;
+        }
+
+        uint64_t at(size_type n) const {
+            if (n >= size()) {
+                throw std::out_of_range("delta_vector::at");
+            }
+            return (*this)[n];
+        }
+
+        uint64_t front() const { return (*this)[0]; }
+        uint64_t back() const { return tail_size ? tail[tail_size - 1] : (*this)[size() - 1]; }
+
+        void reserve(size_type n) { blocks.reserve(n / __packed_block); }
+
+        void push_back(uint64_t x) {
+            if (!empty() && x < back()) {
+                throw std::invalid_argument("delta_vector::push_back: values must be sorted");
+            }
+            tail[tail_size++] = x;
+            if (tail_size == __packed_block) {
+                append_block(tail);
+                tail_size = 0;
+            }
+        }
+
+        void clear() {
+            blocks.clear();
+            words.clear();
+            tail_size = 0;
+        }
+
+        // Writes block b's 128 values, or the tail's, to out.
+        void decode_block(size_type b, uint64_t* out) const {
+            if (b == blocks.size()) {
+                memcpy(out, tail, tail_size * sizeof(uint64_t));
+                return;
+            }
+            const block& blk = blocks[b];
+            tinySTL::__packed_unpack(words.begin() + blk.offset, blk.width, blk.base, out);
+        }
+
+        // Writes all size() values to out.
+        void decode(uint64_t* out) const {
+            for (size_type b = 0; b < blocks.size(); ++b, out += __packed_block) {
+                decode_block(b, out);
+            }
+            memcpy(out, tail, tail_size * sizeof(uint64_t));
+        }
+
+        // Calls f(value) on every element in order; the fastest full scan.
+        template <class F>
+        void for_each(F f) const {
+            uint64_t buf[__packed_block];
+            for (size_type b = 0; b < blocks.size(); ++b) {
+                decode_block(b, buf);
+                for (size_type i = 0; i < size_type(__packed_block); ++i) {
+                    f(buf[i]);
+                }
+            }
+            for (size_type i = 0; i < tail_size; ++i) {
+                f(tail[i]);
+            }
+        }
+
+        // Index of the first element not less than x, or size().
+        size_type lower_bound(uint64_t x) const {
+            size_type lo = 0;
+            size_type hi = blocks.size();
+            while (lo < hi) {
+                const size_type mid = lo + (hi - lo) / 2;
+                if (blocks[mid].base < x) {
+                    lo = mid + 1;
+                }
+                else {
+                    hi = mid;
+                }
+            }
+            // Blocks from lo on start at x or above; the answer is in the
+            // block before them, or is lo's first element.
+            const size_type first = lo ? (lo - 1) * __packed_block : 0;
+            const size_type last = lo < blocks.size() ? lo * __packed_block : size();
+            return search(first, last, x);
+        }
+
+        bool contains(uint64_t x) const {
+            const size_type i = lower_bound(x);
+            return i < size() && (*this)[i] == x;
+        }
+
+        void swap(delta_vector& x) {
+            tinySTL::swap(blocks, x.blocks);
+            tinySTL::swap(words, x.words);
+            uint64_t t[__packed_block];
+            memcpy(t, tail, sizeof(tail));
+            memcpy(tail, x.tail, sizeof(tail));
+            memcpy(x.tail, t, sizeof(tail));
+            tinySTL::swap(tail_size, x.tail_size);
+        }
+    };
+}
+
+#endif // _TINY_DELTA_VECTOR_H_
@@ -3,19 +3,34 @@
 
 #include "allocator.h"
 #include "iterator.h"
+#include "algorithm.h"
 
 using namespace tinySTL;
 
 namespace tinySTL {
-    inline size_t __deque_buf_size(size_t n, size_t sz) {
-        return n != 0 ? n : (sz < 512 ? size_t(512 / sz) : size_t(1));
+    inline constexpr size_t __deque_floor_pow2(size_t n) {
+        return n < 2 ? n : 2 * __deque_floor_pow2(n / 2);
+    }
+
+    inline constexpr size_t __deque_log2(size_t n) {
+        return n < 2 ? 0 : 1 + __deque_log2(n / 2);
+    }
+
+    inline constexpr bool __deque_is_pow2(size_t n) {
+        return n != 0 && (n & (n - 1)) == 0;
+    }
+
+    inline constexpr size_t __deque_buf_size(size_t n, size_t sz) {
+        return n != 0 ? n : (sz < 512 ? __deque_floor_pow2(512 / sz) : size_t(1));
     }
 
     template <class T, class Ref, class Ptr, size_t BufSize>
     struct __deque_iterator {
         typedef __deque_iterator<T, T&, T*, BufSize>    iterator;
         typedef __deque_iterator<T, Ref, Ptr, BufSize>  self;
-        static size_t buffer_size() { return __deque_buf_size(BufSize, sizeof(T)); }
+        static constexpr size_t buffer_size() { return __deque_buf_size(BufSize, sizeof(T)); }
+        static constexpr bool buffer_is_pow2() { return __deque_is_pow2(buffer_size()); }
+        static constexpr size_t buffer_shift() { return __deque_log2(buffer_size()); }
 
         typedef random_access_iterator_tag              iterator_category;
         typedef T                                       value_type;
@@ -30,6 +45,10 @@ namespace tinySTL {
         pointer last;
         map_pointer node;
 
+        __deque_iterator() : cur(0), first(0), last(0), node(0) {}
+        __deque_iterator(const iterator& x) : cur(x.cur), first(x.first), last(x.last), node(x.node) {}
+        self& operator=(const self& x) = default;
+
         void set_node(map_pointer new_node) {
             node = new_node;
             first = *new_node;
@@ -72,14 +91,27 @@ namespace tinySTL {
             return tmp;
         }
 
-        self operator+=(difference_type n) {
-            difference_type offset = n + (cur - first);
-            if (offset >= 0 && offset < difference_type(buffer_size()))
+        static difference_type node_offset(difference_type offset) {
+            if (buffer_is_pow2())
+                return offset >> buffer_shift();
+            return offset >= 0 ? difference_type(size_t(offset) / buffer_size())
+                               : -difference_type(size_t(-offset - 1) / buffer_size()) - 1;
+        }
+
+        static difference_type block_offset(difference_type offset, difference_type node_offset) {
+            if (buffer_is_pow2())
+                return offset & difference_type(buffer_size() - 1);
+            return offset - node_offset * difference_type(buffer_size());
+        }
+
+        self& operator+=(difference_type n) {
+            const difference_type offset = n + (cur - first);
+            if (size_t(offset) < buffer_size())
                 cur += n;
             else {
-                difference_type node_offset = offset > 0 ? offset / difference_type(buffer_size()) : -difference_type((-offset - 1) / buffer_size()) - 1;
-                set_node(node + node_offset);
-                cur = first + (offset - node_offset * difference_type(buffer_size()));
+                const difference_type noff = node_offset(offset);
+                set_node(node + noff);
+                cur = first + block_offset(offset, noff);
             }
             return *this;
         }
@@ -89,7 +121,7 @@ namespace tinySTL {
             return tmp += n;
         }
 
-        self operator-=(difference_type n) { return *this += -n; }
+        self& operator-=(difference_type n) { return *this += -n; }
 
         self operator-(difference_type n) const {
             self tmp = *this;
@@ -108,6 +140,299 @@ namespace tinySTL {
         bool operator>=(const self& x) const { return !(*this < x); }
     };
 
+    template <class T, class Ref, class Ptr, size_t BufSize, class Function>
+    Function __for_each_segment(__deque_iterator<T, Ref, Ptr, BufSize> first,
+                                __deque_iterator<T, Ref, Ptr, BufSize> last, Function f) {
+        typedef __deque_iterator<T, Ref, Ptr, BufSize> iterator;
+        if (first.node == last.node) {
+            f(first.cur, last.cur);
+            return f;
+        }
+        f(first.cur, first.last);
+        for (typename iterator::map_pointer node = first.node + 1; node < last.node; ++node)
+            f(static_cast<Ptr>(*node), static_cast<Ptr>(*node + iterator::buffer_size()));
+        f(last.first, last.cur);
+        return f;
+    }
+
+    template <class T, class Ref, class Ptr, size_t BufSize, class Function>
+    Function for_each(__deque_iterator<T, Ref, Ptr, BufSize> first,
+                      __deque_iterator<T, Ref, Ptr, BufSize> last, Function f) {
+        struct segment {
+            Function& f;
+            void operator()(Ptr first, Ptr last) {
+                for (; first != last; ++first)
+                    f(*first);
+            }
+        };
+        tinySTL::__for_each_segment(first, last, segment{f});
+        return f;
+    }
+
+    template <class T, class Ref, class Ptr, size_t BufSize, class U>
+    __deque_iterator<T, Ref, Ptr, BufSize> find(__deque_iterator<T, Ref, Ptr, BufSize> first,
+                                                __deque_iterator<T, Ref, Ptr, BufSize> last, const U& value) {
+        if (first.node == last.node) {
+            first.cur = tinySTL::find(first.cur, last.cur, value);
+            return first;
+        }
+        Ptr p = tinySTL::find(first.cur, first.last, value);
+        if (p != first.last) {
+            first.cur = p;
+            return first;
+        }
+        for (first.set_node(first.node + 1); first.node != last.node; first.set_node(first.node + 1)) {
+            p = tinySTL::find(first.first, first.last, value);
+            if (p != first.last) {
+                first.cur = p;
+                return first;
+            }
+        }
+        last.cur = tinySTL::find(last.first, last.cur, value);
+        return last;
+    }
+
+    template <class T, class Ref, class Ptr, size_t BufSize, class U>
+    U accumulate(__deque_iterator<T, Ref, Ptr, BufSize> first,
+                 __deque_iterator<T, Ref, Ptr, BufSize> last, U init) {
+        struct segment {
+            U& sum;
+            void operator()(Ptr first, Ptr last) { sum = tinySTL::accumulate(first, last, sum); }
+        };
+        tinySTL::__for_each_segment(first, last, segment{init});
+        return init;
+    }
+
+    template <class T, size_t BufSize, class U>
+    void fill(__deque_iterator<T, T&, T*, BufSize> first,
+              __deque_iterator<T, T&, T*, BufSize> last, const U& value) {
+        struct segment {
+            const U& value;
+            void operator()(T* first, T* last) { tinySTL::fill(first, last, value); }
+        };
+        tinySTL::__for_each_segment(first, last, segment{value});
+    }
+
+    template <class T, size_t BufSize>
+    void destroy(__deque_iterator<T, T&, T*, BufSize> first, __deque_iterator<T, T&, T*, BufSize> last) {
+        if (std::is_trivially_destructible<T>::value)
+            return;
+        struct segment {
+            void operator()(T* first, T* last) { tinySTL::destroy(first, last); }
+        };
+        tinySTL::__for_each_segment(first, last, segment());
+    }
+
+    template <class T, size_t BufSize, class U>
+    void uninitialized_fill(__deque_iterator<T, T&, T*, BufSize> first,
+                            __deque_iterator<T, T&, T*, BufSize> last, const U& x) {
+        __deque_iterator<T, T&, T*, BufSize> cur = first;
+        try {
+            while (cur.node != last.node) {
+                tinySTL::uninitialized_fill(cur.cur, cur.last, x);
+                cur.set_node(cur.node + 1);
+                cur.cur = cur.first;
+            }
+            tinySTL::uninitialized_fill(cur.cur, last.cur, x);
+        }
+        catch (...) {
+            tinySTL::destroy(first, cur);
+            throw;
+        }
+    }
+
+    template <class T, class Ref, class Ptr, size_t BufSize, class OutputIterator>
+    OutputIterator copy(__deque_iterator<T, Ref, Ptr, BufSize> first,
+                        __deque_iterator<T, Ref, Ptr, BufSize> last, OutputIterator result) {
+        struct segment {
+            OutputIterator& result;
+            void operator()(Ptr first, Ptr last) { result = tinySTL::copy(first, last, result); }
+        };
+        tinySTL::__for_each_segment(first, last, segment{result});
+        return result;
+    }
+
+    template <class T, size_t BufSize>
+    __deque_iterator<T, T&, T*, BufSize> __copy_to_deque(const T* first, const T* last,
+                                                         __deque_iterator<T, T&, T*, BufSize> result) {
+        ptrdiff_t n = last - first;
+        while (n > 0) {
+            const ptrdiff_t len = tinySTL::min(n, ptrdiff_t(result.last - result.cur));
+            tinySTL::copy(first, first + len, result.cur);
+            first += len;
+            result += len;
+            n -= len;
+        }
+        return result;
+    }
+
+    template <class T, size_t BufSize>
+    inline __deque_iterator<T, T&, T*, BufSize> copy(const T* first, const T* last,
+                                                     __deque_iterator<T, T&, T*, BufSize> result) {
+        return tinySTL::__copy_to_deque(first, last, result);
+    }
+
+    template <class T, size_t BufSize>
+    inline __deque_iterator<T, T&, T*, BufSize> copy(T* first, T* last,
+                                                     __deque_iterator<T, T&, T*, BufSize> result) {
+        return tinySTL::__copy_to_deque(static_cast<const T*>(first), static_cast<const T*>(last), result);
+    }
+
+    template <class T, class Ref, class Ptr, size_t BufSize>
+    __deque_iterator<T, T&, T*, BufSize> copy(__deque_iterator<T, Ref, Ptr, BufSize> first,
+                                              __deque_iterator<T, Ref, Ptr, BufSize> last,
+                                              __deque_iterator<T, T&, T*, BufSize> result) {
+        ptrdiff_t n = last - first;
+        while (n > 0) {
+            const ptrdiff_t len = tinySTL::min(n, tinySTL::min(ptrdiff_t(first.last - first.cur),
+                                                               ptrdiff_t(result.last - result.cur)));
+            tinySTL::copy(first.cur, first.cur + len, result.cur);
+            first += len;
+            result += len;
+            n -= len;
+        }
+        return result;
+    }
+
+    template <class T, size_t BufSize>
+    __deque_iterator<T, T&, T*, BufSize> move(__deque_iterator<T, T&, T*, BufSize> first,
+                                              __deque_iterator<T, T&, T*, BufSize> last,
+                                              __deque_iterator<T, T&, T*, BufSize> result) {
+        ptrdiff_t n = last - first;
+        while (n > 0) {
+            const ptrdiff_t len = tinySTL::min(n, tinySTL::min(ptrdiff_t(first.last - first.cur),
+                                                               ptrdiff_t(result.last - result.cur)));
+            tinySTL::move(first.cur, first.cur + len, result.cur);
+            first += len;
+            result += len;
+            n -= len;
+        }
+        return result;
+    }
+
+    template <class InputIterator, class T, size_t BufSize>
+    __deque_iterator<T, T&, T*, BufSize> __uninitialized_copy_to_deque(InputIterator first, InputIterator last,
+                                                                       __deque_iterator<T, T&, T*, BufSize> result,
+                                                                       input_iterator_tag) {
+        __deque_iterator<T, T&, T*, BufSize> cur = result;
+        try {
+            for (; first != last; ++first, ++cur)
+                tinySTL::construct(&*cur, *first);
+        }
+        catch (...) {
+            tinySTL::destroy(result, cur);
+            throw;
+        }
+        return cur;
+    }
+
+    template <class RandomAccessIterator, class T, size_t BufSize>
+    __deque_iterator<T, T&, T*, BufSize> __uninitialized_copy_to_deque(RandomAccessIterator first, RandomAccessIterator last,
+                                                                       __deque_iterator<T, T&, T*, BufSize> result,
+                                                                       random_access_iterator_tag) {
+        __deque_iterator<T, T&, T*, BufSize> cur = result;
+        try {
+            ptrdiff_t n = last - first;
+            while (n > 0) {
+                const ptrdiff_t len = tinySTL::min(n, ptrdiff_t(cur.last - cur.cur));
+                tinySTL::uninitialized_copy(first, first + len, cur.cur);
+                first += len;
+                cur += len;
+                n -= len;
+            }
+        }
+        catch (...) {
+            tinySTL::destroy(result, cur);
+            throw;
+        }
+        return cur;
+    }
+
+    template <class InputIterator, class T, size_t BufSize>
+    inline __deque_iterator<T, T&, T*, BufSize> uninitialized_copy(InputIterator first, InputIterator last,
+                                                                   __deque_iterator<T, T&, T*, BufSize> result) {
+        return tinySTL::__uninitialized_copy_to_deque(first, last, result, iterator_category(first));
+    }
+
+    template <class T, class Ref, class Ptr, size_t BufSize>
+    __deque_iterator<T, T&, T*, BufSize> uninitialized_copy(__deque_iterator<T, Ref, Ptr, BufSize> first,
+                                                            __deque_iterator<T, Ref, Ptr, BufSize> last,
+                                                            __deque_iterator<T, T&, T*, BufSize> result) {
+        __deque_iterator<T, T&, T*, BufSize> cur = result;
+        try {
+            ptrdiff_t n = last - first;
+            while (n > 0) {
+                const ptrdiff_t len = tinySTL::min(n, tinySTL::min(ptrdiff_t(first.last - first.cur),
+                                                                   ptrdiff_t(cur.last - cur.cur)));
+                tinySTL::uninitialized_copy(first.cur, first.cur + len, cur.cur);
+                first += len;
+                cur += len;
+                n -= len;
+            }
+        }
+        catch (...) {
+            tinySTL::destroy(result, cur);
+            throw;
+        }
+        return cur;
+    }
+
+    template <class T, class Ref, class Ptr, size_t BufSize>
+    __deque_iterator<T, T&, T*, BufSize> copy_backward(__deque_iterator<T, Ref, Ptr, BufSize> first,
+                                                       __deque_iterator<T, Ref, Ptr, BufSize> last,
+                                                       __deque_iterator<T, T&, T*, BufSize> result) {
+        const ptrdiff_t buf = ptrdiff_t(__deque_iterator<T, T&, T*, BufSize>::buffer_size());
+        ptrdiff_t n = last - first;
+        while (n > 0) {
+            ptrdiff_t llen = last.cur - last.first;
+            Ptr lend = last.cur;
+            if (llen == 0) {
+                llen = buf;
+                lend = *(last.node - 1) + buf;
+            }
+            ptrdiff_t rlen = result.cur - result.first;
+            T* rend = result.cur;
+            if (rlen == 0) {
+                rlen = buf;
+                rend = *(result.node - 1) + buf;
+            }
+            const ptrdiff_t len = tinySTL::min(n, tinySTL::min(llen, rlen));
+            tinySTL::copy_backward(lend - len, lend, rend);
+            last -= len;
+            result -= len;
+            n -= len;
+        }
+        return result;
+    }
+
+    template <class T, size_t BufSize>
+    __deque_iterator<T, T&, T*, BufSize> move_backward(__deque_iterator<T, T&, T*, BufSize> first,
+                                                       __deque_iterator<T, T&, T*, BufSize> last,
+                                                       __deque_iterator<T, T&, T*, BufSize> result) {
+        const ptrdiff_t buf = ptrdiff_t(__deque_iterator<T, T&, T*, BufSize>::buffer_size());
+        ptrdiff_t n = last - first;
+        while (n > 0) {
+            ptrdiff_t llen = last.cur - last.first;
+            T* lend = last.cur;
+            if (llen == 0) {
+                llen = buf;
+                lend = *(last.node - 1) + buf;
+            }
+            ptrdiff_t rlen = result.cur - result.first;
+            T* rend = result.cur;
+            if (rlen == 0) {
+                rlen = buf;
+                rend = *(result.node - 1) + buf;
+            }
+            const ptrdiff_t len = tinySTL::min(n, tinySTL::min(llen, rlen));
+            tinySTL::move_backward(lend - len, lend, rend);
+            last -= len;
+            result -= len;
+            n -= len;
+        }
+        return result;
+    }
+
     template <class T, class Alloc = allocator<T>, size_t BufSize = 0>
     class deque {
     public:
@@ -118,7 +443,10 @@ namespace tinySTL {
         typedef ptrdiff_t                               difference_type;
         typedef allocator<value_type>                   data_allocator;
         typedef allocator<pointer>                      map_allocator;
+        typedef const value_type*                       const_pointer;
+        typedef const value_type&                       const_reference;
         typedef __deque_iterator<T, T&, T*, BufSize>    iterator;
+        typedef __deque_iterator<T, const T&, const T*, BufSize> const_iterator;
 
     protected:
         typedef pointer*                                map_pointer;
@@ -130,11 +458,13 @@ namespace tinySTL {
 
         size_type map_size;
 
-        pointer allocate_node() { return data_allocator::allocate(__deque_buf_size(BufSize, sizeof(T))); }
-        void deallocate_node(pointer p) { data_allocator::deallocate(p, __deque_buf_size(BufSize, sizeof(T))); }
+        static constexpr size_type buffer_size() { return iterator::buffer_size(); }
+
+        pointer allocate_node() { return data_allocator::allocate(buffer_size()); }
+        void deallocate_node(pointer p) { data_allocator::deallocate(p, buffer_size()); }
 
         void create_map_and_nodes(size_type num_elements) {
-            size_type num_nodes = num_elements / __deque_buf_size(BufSize, sizeof(T)) + 1;
+            size_type num_nodes = num_elements / buffer_size() + 1;
 
             map_size = max(static_cast<size_t>(8), num_nodes + 2);
             map = map_allocator::allocate(map_size);
@@ -149,12 +479,12 @@ namespace tinySTL {
             start.set_node(nstart);
             finish.set_node(nfinish);
             start.cur = start.first;
-            finish.cur = finish.first + num_elements % __deque_buf_size(BufSize, sizeof(T));
+            finish.cur = finish.first + num_elements % buffer_size();
         }
 
         void destroy_map_and_nodes() {
             for (map_pointer cur = start.node; cur <= finish.node; ++cur)
-                data_allocator::deallocate(*cur, __deque_buf_size(BufSize, sizeof(T)));
+                deallocate_node(*cur);
             map_allocator::deallocate(map, map_size);
         }
 
@@ -163,12 +493,12 @@ namespace tinySTL {
             map_pointer cur;
             try {
                 for (cur = start.node; cur < finish.node; ++cur)
-                    uninitialized_fill(*cur, *cur + __deque_buf_size(BufSize, sizeof(T)), value);
-                uninitialized_fill(finish.first, finish.cur, value);
+                    tinySTL::uninitialized_fill(*cur, *cur + buffer_size(), value);
+                tinySTL::uninitialized_fill(finish.first, finish.cur, value);
             }
             catch (...) {
                 for (map_pointer n = start.node; n < cur; ++n)
-                    destroy(*n, *n + __deque_buf_size(BufSize, sizeof(T)));
+                    tinySTL::destroy(*n, *n + buffer_size());
                 destroy_map_and_nodes();
                 throw;
             }
@@ -182,15 +512,15 @@ namespace tinySTL {
             if (map_size > 2 * new_num_nodes) {
                 new_nstart = map + (map_size - new_num_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
                 if (new_nstart < start.node)
-                    copy(start.node, finish.node + 1, new_nstart);
+                    tinySTL::copy(start.node, finish.node + 1, new_nstart);
                 else
-                    copy_backward(start.node, finish.node + 1, new_nstart + old_num_nodes);
+                    tinySTL::copy_backward(start.node, finish.node + 1, new_nstart + old_num_nodes);
             }
             else {
                 size_type new_map_size = map_size + max(map_size, nodes_to_add) + 2;
                 map_pointer new_map = map_allocator::allocate(new_map_size);
                 new_nstart = new_map + (new_map_size - new_num_nodes) / 2 + (add_at_front ? nodes_to_add : 0);
-                copy(start.node, finish.node + 1, new_nstart);
+                tinySTL::copy(start.node, finish.node + 1, new_nstart);
                 map_allocator::deallocate(map, map_size);
                 map = new_map;
                 map_size = new_map_size;
@@ -210,6 +540,206 @@ namespace tinySTL {
                 reallocate_map(nodes_to_add, true);
         }
 
+        iterator reserve_elements_at_front(size_type n) {
+            size_type vacancies = start.cur - start.first;
+            if (n > vacancies)
+                new_elements_at_front(n - vacancies);
+            return start - difference_type(n);
+        }
+
+        iterator reserve_elements_at_back(size_type n) {
+            size_type vacancies = (finish.last - finish.cur) - 1;
+            if (n > vacancies)
+                new_elements_at_back(n - vacancies);
+            return finish + difference_type(n);
+        }
+
+        void new_elements_at_front(size_type new_elements) {
+            size_type new_nodes = (new_elements + buffer_size() - 1) / buffer_size();
+            reserve_map_at_front(new_nodes);
+            size_type i = 1;
+            try {
+                for (; i <= new_nodes; ++i)
+                    *(start.node - i) = allocate_node();
+            }
+            catch (...) {
+                for (size_type j = 1; j < i; ++j)
+                    deallocate_node(*(start.node - j));
+                throw;
+            }
+        }
+
+        void new_elements_at_back(size_type new_elements) {
+            size_type new_nodes = (new_elements + buffer_size() - 1) / buffer_size();
+            reserve_map_at_back(new_nodes);
+            size_type i = 1;
+            try {
+                for (; i <= new_nodes; ++i)
+                    *(finish.node + i) = allocate_node();
+            }
+            catch (...) {
+                for (size_type j = 1; j < i; ++j)
+                    deallocate_node(*(finish.node + j));
+                throw;
+            }
+        }
+
+        void destroy_nodes_at_front(iterator before_start) {
+            for (map_pointer n = before_start.node; n < start.node; ++n)
+                deallocate_node(*n);
+        }
+
+        void destroy_nodes_at_back(iterator after_finish) {
+            for (map_pointer n = after_finish.node; n > finish.node; --n)
+                deallocate_node(*n);
+        }
+
+        template <class InputIterator>
+        void range_initialize(InputIterator first, InputIterator last, input_iterator_tag) {
+            create_map_and_nodes(0);
+            try {
+                for (; first != last; ++first)
+                    push_back(*first);
+            }
+            catch (...) {
+                clear();
+                destroy_map_and_nodes();
+                throw;
+            }
+        }
+
+        template <class ForwardIterator>
+        void range_initialize(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+            create_map_and_nodes(size_type(tinySTL::distance(first, last)));
+            try {
+                tinySTL::uninitialized_copy(first, last, start);
+            }
+            catch (...) {
+                destroy_map_and_nodes();
+                throw;
+            }
+        }
+
+        template <class Integer>
+        void initialize_dispatch(Integer n, Integer x, std::true_type) {
+            fill_initialize(size_type(n), value_type(x));
+        }
+
+        template <class InputIterator>
+        void initialize_dispatch(InputIterator first, InputIterator last, std::false_type) {
+            range_initialize(first, last, iterator_category(first));
+        }
+
+        void fill_insert(iterator pos, size_type n, const value_type& x) {
+            if (n == 0)
+                return;
+            if (pos.cur == start.cur) {
+                iterator new_start = reserve_elements_at_front(n);
+                try {
+                    tinySTL::uninitialized_fill(new_start, start, x);
+                }
+                catch (...) {
+                    destroy_nodes_at_front(new_start);
+                    throw;
+                }
+                start = new_start;
+            }
+            else if (pos.cur == finish.cur) {
+                iterator new_finish = reserve_elements_at_back(n);
+                try {
+                    tinySTL::uninitialized_fill(finish, new_finish, x);
+                }
+                catch (...) {
+                    destroy_nodes_at_back(new_finish);
+                    throw;
+                }
+                finish = new_finish;
+            }
+            else
+                insert_aux(pos, n, x);
+        }
+
+        template <class InputIterator>
+        void range_insert(iterator pos, InputIterator first, InputIterator last, input_iterator_tag) {
+            for (; first != last; ++first, ++pos)
+                pos = insert(pos, *first);
+        }
+
+        template <class ForwardIterator>
+        void range_insert(iterator pos, ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+            size_type n = size_type(tinySTL::distance(first, last));
+            if (n == 0)
+                return;
+            if (pos.cur == start.cur) {
+                iterator new_start = reserve_elements_at_front(n);
+                try {
+                    tinySTL::uninitialized_copy(first, last, new_start);
+                }
+                catch (...) {
+                    destroy_nodes_at_front(new_start);
+                    throw;
+                }
+                start = new_start;
+            }
+            else if (pos.cur == finish.cur) {
+                iterator new_finish = reserve_elements_at_back(n);
+                try {
+                    tinySTL::uninitialized_copy(first, last, finish);
+                }
+                catch (...) {
+                    destroy_nodes_at_back(new_finish);
+                    throw;
+                }
+                finish = new_finish;
+            }
+            else
+                insert_aux(pos, first, last, n);
+        }
+
+        template <class Integer>
+        void insert_dispatch(iterator pos, Integer n, Integer x, std::true_type) {
+            fill_insert(pos, size_type(n), value_type(x));
+        }
+
+        template <class InputIterator>
+        void insert_dispatch(iterator pos, InputIterator first, InputIterator last, std::false_type) {
+            range_insert(pos, first, last, iterator_category(first));
+        }
+
+        template <class Integer>
+        void assign_dispatch(Integer n, Integer x, std::true_type) {
+            assign(size_type(n), value_type(x));
+        }
+
+        template <class InputIterator>
+        void assign_dispatch(InputIterator first, InputIterator last, std::false_type) {
+            assign_aux(first, last, iterator_category(first));
+        }
+
+        template <class InputIterator>
+        void assign_aux(InputIterator first, InputIterator last, input_iterator_tag) {
+            iterator cur = begin();
+            for (; first != last && cur != end(); ++cur, ++first)
+                *cur = *first;
+            if (first == last)
+                erase(cur, end());
+            else
+                range_insert(end(), first, last, input_iterator_tag());
+        }
+
+        template <class ForwardIterator>
+        void assign_aux(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+            size_type len = size_type(tinySTL::distance(first, last));
+            if (len > size()) {
+                ForwardIterator mid = first;
+                tinySTL::advance(mid, size());
+                tinySTL::copy(first, mid, begin());
+                range_insert(end(), mid, last, forward_iterator_tag());
+            }
+            else
+                erase(tinySTL::copy(first, last, begin()), end());
+        }
+
         void push_front_aux(const value_type& t) {
             value_type t_copy = t;
             reserve_map_at_front();
@@ -217,7 +747,7 @@ namespace tinySTL {
             try {
                 start.set_node(start.node - 1);
                 start.cur = start.last - 1;
-                construct(start.cur, t_copy);
+                tinySTL::construct(start.cur, t_copy);
             }
             catch (...) {
                 start.set_node(start.node + 1);
@@ -232,7 +762,7 @@ namespace tinySTL {
             reserve_map_at_back();
             *(finish.node + 1) = allocate_node();
             try {
-                construct(finish.cur, t_copy);
+                tinySTL::construct(finish.cur, t_copy);
                 finish.set_node(finish.node + 1);
                 finish.cur = finish.first;
             }
@@ -254,7 +784,7 @@ namespace tinySTL {
                 pos = start + index;
                 iterator pos1 = pos;
                 ++pos1;
-                copy(front2, pos1, front1);
+                tinySTL::move(front2, pos1, front1);
             }
             else {
                 push_back(back());
@@ -263,28 +793,282 @@ namespace tinySTL {
                 iterator back2 = back1;
                 --back2;
                 pos = start + index;
-                copy_backward(pos, back2, back1);
+                tinySTL::move_backward(pos, back2, back1);
             }
             *pos = x_copy;
             return pos;
         }
 
+        void insert_aux(iterator pos, size_type n, const value_type& x) {
+            const difference_type elems_before = pos - start;
+            const size_type length = size();
+            value_type x_copy = x;
+            if (elems_before < difference_type(length / 2)) {
+                iterator new_start = reserve_elements_at_front(n);
+                iterator old_start = start;
+                pos = start + elems_before;
+                try {
+                    if (elems_before >= difference_type(n)) {
+                        iterator start_n = start + difference_type(n);
+                        tinySTL::uninitialized_copy(start, start_n, new_start);
+                        start = new_start;
+                        tinySTL::move(start_n, pos, old_start);
+                        tinySTL::fill(pos - difference_type(n), pos, x_copy);
+                    }
+                    else {
+                        iterator mid = tinySTL::uninitialized_copy(start, pos, new_start);
+                        try {
+                            tinySTL::uninitialized_fill(mid, start, x_copy);
+                        }
+                        catch (...) {
+                            tinySTL::destroy(new_start, mid);
+                            throw;
+                        }
+                        start = new_start;
+                        tinySTL::fill(old_start, pos, x_copy);
+                    }
+                }
+                catch (...) {
+                    destroy_nodes_at_front(new_start);
+                    throw;
+                }
+            }
+            else {
+                iterator new_finish = reserve_elements_at_back(n);
+                iterator old_finish = finish;
+                const difference_type elems_after = difference_type(length) - elems_before;
+                pos = finish - elems_after;
+                try {
+                    if (elems_after > difference_type(n)) {
+                        iterator finish_n = finish - difference_type(n);
+                        tinySTL::uninitialized_copy(finish_n, finish, finish);
+                        finish = new_finish;
+                        tinySTL::move_backward(pos, finish_n, old_finish);
+                        tinySTL::fill(pos, pos + difference_type(n), x_copy);
+                    }
+                    else {
+                        iterator pos_n = pos + difference_type(n);
+                        tinySTL::uninitialized_fill(finish, pos_n, x_copy);
+                        try {
+                            tinySTL::uninitialized_copy(pos, finish, pos_n);
+                        }
+                        catch (...) {
+                            tinySTL::destroy(finish, pos_n);
+                            throw;
+                        }
+                        finish = new_finish;
+                        tinySTL::fill(pos, old_finish, x_copy);
+                    }
+                }
+                catch (...) {
+                    destroy_nodes_at_back(new_finish);
+                    throw;
+                }
+            }
+        }
+
+        template <class ForwardIterator>
+        void insert_aux(iterator pos, ForwardIterator first, ForwardIterator last, size_type n) {
+            const difference_type elems_before = pos - start;
+            const size_type length = size();
+            if (elems_before < difference_type(length / 2)) {
+                iterator new_start = reserve_elements_at_front(n);
+                iterator old_start = start;
+                pos = start + elems_before;
+                try {
+                    if (elems_before >= difference_type(n)) {
+                        iterator start_n = start + difference_type(n);
+                        tinySTL::uninitialized_copy(start, start_n, new_start);
+                        start = new_start;
+                        tinySTL::move(start_n, pos, old_start);
+                        tinySTL::copy(first, last, pos - difference_type(n));
+                    }
+                    else {
+                        ForwardIterator mid = first;
+                        tinySTL::advance(mid, difference_type(n) - elems_before);
+                        iterator mid_result = tinySTL::uninitialized_copy(start, pos, new_start);
+                        try {
+                            tinySTL::uninitialized_copy(first, mid, mid_result);
+                        }
+                        catch (...) {
+                            tinySTL::destroy(new_start, mid_result);
+                            throw;
+                        }
+                        start = new_start;
+                        tinySTL::copy(mid, last, old_start);
+                    }
+                }
+                catch (...) {
+                    destroy_nodes_at_front(new_start);
+                    throw;
+                }
+            }
+            else {
+                iterator new_finish = reserve_elements_at_back(n);
+                iterator old_finish = finish;
+                const difference_type elems_after = difference_type(length) - elems_before;
+                pos = finish - elems_after;
+                try {
+                    if (elems_after > difference_type(n)) {
+                        iterator finish_n = finish - difference_type(n);
+                        tinySTL::uninitialized_copy(finish_n, finish, finish);
+                        finish = new_finish;
+                        tinySTL::move_backward(pos, finish_n, old_finish);
+                        tinySTL::copy(first, last, pos);
+                    }
+                    else {
+                        ForwardIterator mid = first;
+                        tinySTL::advance(mid, elems_after);
+                        iterator mid_result = tinySTL::uninitialized_copy(mid, last, finish);
+                        try {
+                            tinySTL::uninitialized_copy(pos, finish, mid_result);
+                        }
+                        catch (...) {
+                            tinySTL::destroy(finish, mid_result);
+                            throw;
+                        }
+                        finish = new_finish;
+                        tinySTL::copy(first, mid, pos);
+                    }
+                }
+                catch (...) {
+                    destroy_nodes_at_back(new_finish);
+                    throw;
+                }
+            }
+        }
+
     public:
         iterator begin() { return start; }
         iterator end() { return finish; }
-        reference operator[](size_type n) { return start[difference_type(n)]; }
+        const_iterator begin() const { return start; }
+        const_iterator end() const { return finish; }
+        reference operator[](size_type n) {
+            const size_type offset = n + size_type(start.cur - start.first);
+            return start.node[offset / buffer_size()][offset % buffer_size()];
+        }
+        const_reference operator[](size_type n) const {
+            const size_type offset = n + size_type(start.cur - start.first);
+            return start.node[offset / buffer_size()][offset % buffer_size()];
+        }
         reference front() { return *start; }
+        const_reference front() const { return *start; }
         reference back() {
             iterator tmp = finish;
             --tmp;
             return *tmp;
         }
+        const_reference back() const {
+            iterator tmp = finish;
+            --tmp;
+            return *tmp;
+        }
         size_type size() const { return finish - start; }
         size_type max_size() const { return size_type(-1); }
         bool empty() const { return finish == start; }
 
         deque() { create_map_and_nodes(0); }
         deque(int n, const value_type& value) { fill_initialize(n, value); }
+        deque(size_type n, const value_type& value) { fill_initialize(n, value); }
+        explicit deque(size_type n) { fill_initialize(n, value_type()); }
+
+        template <class InputIterator>
+        deque(InputIterator first, InputIterator last) {
+            initialize_dispatch(first, last, std::is_integral<InputIterator>());
+        }
+
+        deque(const deque& x) { range_initialize(x.begin(), x.end(), random_access_iterator_tag()); }
+
+        deque(deque&& x) {
+            create_map_and_nodes(0);
+            swap(x);
+        }
+
+        ~deque() {
+            tinySTL::destroy(start, finish);
+            destroy_map_and_nodes();
+        }
+
+        deque& operator=(const deque& x) {
+            if (this != &x)
+                assign(x.begin(), x.end());
+            return *this;
+        }
+
+        deque& operator=(deque&& x) {
+            if (this != &x) {
+                clear();
+                swap(x);
+            }
+            return *this;
+        }
+
+        void swap(deque& x) {
+            iterator tmp_start = start;
+            iterator tmp_finish = finish;
+            map_pointer tmp_map = map;
+            size_type tmp_map_size = map_size;
+            start = x.start;
+            finish = x.finish;
+            map = x.map;
+            map_size = x.map_size;
+            x.start = tmp_start;
+            x.finish = tmp_finish;
+            x.map = tmp_map;
+            x.map_size = tmp_map_size;
+        }
+
+        void assign(size_type n, const value_type& value) {
+            if (n > size()) {
+                tinySTL::fill(begin(), end(), value);
+                fill_insert(end(), n - size(), value);
+            }
+            else {
+                erase(begin() + difference_type(n), end());
+                tinySTL::fill(begin(), end(), value);
+            }
+        }
+
+        template <class InputIterator>
+        void assign(InputIterator first, InputIterator last) {
+            assign_dispatch(first, last, std::is_integral<InputIterator>());
+        }
+
+        void resize(size_type new_size, const value_type& x) {
+            const size_type len = size();
+            if (new_size < len)
+                erase(start + difference_type(new_size), finish);
+            else
+                fill_insert(finish, new_size - len, x);
+        }
+
+        void resize(size_type new_size) { resize(new_size, value_type()); }
+
+        // Grows without constructing the new elements, for trivially copyable
+        // T that the caller fills in right after, block by block.
+        void resize_default_init(size_type new_size) {
+            static_assert(std::is_trivially_copyable<T>::value, "resize_default_init leaves elements unconstructed");
+            const size_type len = size();
+            if (new_size < len)
+                erase(start + difference_type(new_size), finish);
+            else
+                finish = reserve_elements_at_back(new_size - len);
+        }
+
+        void shrink_to_fit() {
+            const size_type num_nodes = finish.node - start.node + 1;
+            const size_type new_map_size = max(static_cast<size_t>(8), num_nodes + 2);
+            if (new_map_size >= map_size)
+                return;
+            map_pointer new_map = map_allocator::allocate(new_map_size);
+            map_pointer new_nstart = new_map + (new_map_size - num_nodes) / 2;
+            tinySTL::copy(start.node, finish.node + 1, new_nstart);
+            map_allocator::deallocate(map, map_size);
+            map = new_map;
+            map_size = new_map_size;
+            start.set_node(new_nstart);
+            finish.set_node(new_nstart + num_nodes - 1);
+        }
 
         void push_front(const value_type& t) {
             if (start.cur != start.first) {
@@ -331,19 +1115,9 @@ namespace tinySTL {
         }
 
         void clear() {
-            for (map_pointer node = start.node + 1; node < finish.node; ++node) {
-                destroy(*node, *node + __deque_buf_size(BufSize, sizeof(T)));
-                data_allocator::deallocate(*node, __deque_buf_size(BufSize, sizeof(T)));
-            }
-
-            if (start.node != finish.node) {
-                destroy(start.cur, start.last);
-                destroy(finish.first, finish.cur);
-                data_allocator::deallocate(finish.first, __deque_buf_size(BufSize, sizeof(T)));
-            }
-            else
-                destroy(start.cur, finish.cur);
-
+            tinySTL::destroy(start, finish);
+            for (map_pointer node = start.node + 1; node <= finish.node; ++node)
+                deallocate_node(*node);
             finish = start;
         }
 
@@ -352,18 +1126,21 @@ namespace tinySTL {
             ++next;
             difference_type index = pos - start;
             if (index < (size() >> 1)) {
-                copy_backward(start, pos, next);
+                tinySTL::move_backward(start, pos, next);
                 pop_front();
             }
             else {
-                copy(next, finish, pos);
+                tinySTL::move(next, finish, pos);
                 pop_back();
             }
             return start + index;
         }
 
         iterator erase(iterator first, iterator last) {
-            if (first == start && last == finish) {
+            if (first == last) {
+                return first;
+            }
+            else if (first == start && last == finish) {
                 clear();
                 return finish;
             }
@@ -371,19 +1148,19 @@ namespace tinySTL {
                 difference_type n = last - first;
                 difference_type elems_before = first - start;
                 if (elems_before < (size() - n) / 2) {
-                    copy_backward(start, first, last);
+                    tinySTL::move_backward(start, first, last);
                     iterator new_start = start + n;
-                    destroy(start, new_start);
+                    tinySTL::destroy(start, new_start);
                     for (map_pointer cur = start.node; cur < new_start.node; ++cur)
-                        data_allocator::deallocate(*cur, __deque_buf_size(BufSize, sizeof(T)));
+                        deallocate_node(*cur);
                     start = new_start;
                 }
                 else {
-                    copy(last, finish, first);
+                    tinySTL::move(last, finish, first);
                     iterator new_finish = finish - n;
-                    destroy(new_finish, finish);
+                    tinySTL::destroy(new_finish, finish);
                     for (map_pointer cur = new_finish.node + 1; cur <= finish.node; ++cur)
-                        data_allocator::deallocate(*cur, __deque_buf_size(BufSize, sizeof(T)));
+                        deallocate_node(*cur);
                     finish = new_finish;
                 }
                 return start + elems_before;
@@ -405,6 +1182,13 @@ namespace tinySTL {
                 return insert_aux(position, x);
             }
         }
+
+        void insert(iterator position, size_type n, const value_type& x) { fill_insert(position, n, x); }
+
+        template <class InputIterator>
+        void insert(iterator position, InputIterator first, InputIterator last) {
+            insert_dispatch(position, first, last, std::is_integral<InputIterator>());
+        }
     };
 }
 
@@ -0,0 +1,195 @@
+#ifndef _TINY_EXECUTION_H_
+#define _TINY_EXECUTION_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace tinySTL {
+    namespace execution {
+        struct sequenced_policy {};
+
+        // threads == 0 means one thread per hardware thread.
+        struct parallel_policy {
+            unsigned threads;
+
+            explicit parallel_policy(unsigned n = 0) : threads(n) {}
+        };
+
+        struct parallel_unsequenced_policy {
+            unsigned threads;
+
+            explicit parallel_unsequenced_policy(unsigned n = 0) : threads(n) {}
+        };
+
+        const sequenced_policy              seq = sequenced_policy();
+        const parallel_policy               par = parallel_policy();
+        const parallel_unsequenced_policy   par_unseq = parallel_unsequenced_policy();
+    }
+
+    template <class T>
+    struct is_execution_policy : std::false_type {};
+
+    template <>
+    struct is_execution_policy<execution::sequenced_policy> : std::true_type {};
+
+    template <>
+    struct is_execution_policy<execution::parallel_policy> : std::true_type {};
+
+    template <>
+    struct is_execution_policy<execution::parallel_unsequenced_policy> : std::true_type {};
+
+    inline unsigned hardware_concurrency() {
+        const unsigned n = std::thread::hardware_concurrency();
+        return n ? n : 1;
+    }
+
+    inline unsigned __policy_threads(const execution::sequenced_policy&) { return 1; }
+
+    inline unsigned __policy_threads(const execution::parallel_policy& policy) {
+        return policy.threads ? policy.threads : hardware_concurrency();
+    }
+
+    inline unsigned __policy_threads(const execution::parallel_unsequenced_policy& policy) {
+        return policy.threads ? policy.threads : hardware_concurrency();
+    }
+
+    // Fixed set of worker threads that run index-parallel jobs. The submitting
+    // thread takes part in its own job, and a job submitted while another is
+    // running (e.g. from inside a task) runs inline on the caller instead of
+    // waiting for workers. As with the standard parallel algorithms, a task
+    // that throws calls std::terminate.
+    class thread_pool {
+    private:
+        struct job {
+            void (*invoke)(void*, size_t);
+            void* context;
+            size_t count;
+            std::atomic<size_t> next;
+            unsigned helpers;
+            unsigned joined;
+            unsigned active;
+        };
+
+        std::thread* workers;
+        unsigned worker_count;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+        std::mutex submit;
+        job* current;
+        unsigned long long generation;
+        bool stop;
+
+        template <class Function>
+        static void invoke(void* f, size_t i) { (*static_cast<Function*>(f))(i); }
+
+        static void drain(job& j) noexcept {
+            for (size_t i; (i = j.next.fetch_add(1, std::memory_order_relaxed)) < j.count; ) {
+                j.invoke(j.context, i);
+            }
+        }
+
+        void worker_loop() {
+            unsigned long long seen = 0;
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                wake.wait(lock, [&]() { return stop || generation != seen; });
+                if (stop) {
+                    return;
+                }
+                seen = generation;
+                job* j = current;
+                if (!j || j->joined >= j->helpers) {
+                    continue;
+                }
+                ++j->joined;
+                ++j->active;
+                lock.unlock();
+                drain(*j);
+                lock.lock();
+                if (--j->active == 0) {
+                    idle.notify_all();
+                }
+            }
+        }
+
+    public:
+        // `threads` counts the submitting thread, so threads - 1 workers are started.
+        explicit thread_pool(unsigned threads) : workers(nullptr), worker_count(0), current(nullptr),
+                                                 generation(0), stop(false) {
+            if (threads > 1) {
+                workers = new std::thread[threads - 1];
+                for (; worker_count < threads - 1; ++worker_count) {
+                    workers[worker_count] = std::thread([this]() { worker_loop(); });
+                }
+            }
+        }
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = true;
+            }
+            wake.notify_all();
+            for (unsigned i = 0; i < worker_count; ++i) {
+                workers[i].join();
+            }
+            delete[] workers;
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        unsigned size() const { return worker_count + 1; }
+
+        // Runs f(0) ... f(count - 1) on up to `threads` threads and returns when all are done.
+        template <class Function>
+        void run(size_t count, unsigned threads, Function& f) {
+            if (threads > count) {
+                threads = unsigned(count);
+            }
+            std::unique_lock<std::mutex> guard(submit, std::try_to_lock);
+            if (threads <= 1 || worker_count == 0 || !guard.owns_lock()) {
+                for (size_t i = 0; i < count; ++i) {
+                    f(i);
+                }
+                return;
+            }
+            job j;
+            j.invoke = &invoke<Function>;
+            j.context = &f;
+            j.count = count;
+            j.next.store(0, std::memory_order_relaxed);
+            j.helpers = threads - 1 < worker_count ? threads - 1 : worker_count;
+            j.joined = 0;
+            j.active = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                current = &j;
+                ++generation;
+            }
+            wake.notify_all();
+            drain(j);
+            std::unique_lock<std::mutex> lock(mutex);
+            current = nullptr;
+            idle.wait(lock, [&]() { return j.active == 0; });
+        }
+
+        static thread_pool& instance() {
+            static thread_pool pool(hardware_concurrency());
+            return pool;
+        }
+    };
+
+    // Runs f(0) ... f(count - 1) on up to `threads` threads of the shared pool.
+    template <class Function>
+    inline void __parallel_for(size_t count, unsigned threads, Function f) {
+        thread_pool::instance().run(count, threads, f);
+    }
+}
+
+#endif // _TINY_EXECUTION_H_
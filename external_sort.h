@@ -0,0 +1,546 @@
+#ifndef _TINY_EXTERNAL_SORT_H_
+#define _TINY_EXTERNAL_SORT_H_
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "allocator.h"
+#include "algorithm.h"
+#include "deque.h"
+#include "functional.h"
+#include "k_way_merge.h"
+#include "vector.h"
+
+namespace tinySTL {
+    // Sorting for data sets larger than memory. Records are gathered into a
+    // buffer the size of the memory budget, sorted, and spilled as a run to an
+    // unlinked temporary file in one large write. The runs are then merged
+    // through a loser tree, each run read a block at a time by a background
+    // thread while the merge consumes the block before it. When there are too
+    // many runs for useful block sizes, they are merged in several passes.
+    // File access goes through POSIX descriptors.
+
+    enum {
+        __external_min_block_bytes = 1 << 16,
+        __external_max_block_bytes = 1 << 23
+    };
+
+    inline void __external_throw(int error, const char* what) {
+        throw std::system_error(error, std::generic_category(), what);
+    }
+
+    inline void __write_fully(int fd, const void* data, size_t bytes, off_t offset) {
+        const char* p = static_cast<const char*>(data);
+        while (bytes > 0) {
+            const ssize_t n = ::pwrite(fd, p, bytes, offset);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                tinySTL::__external_throw(errno, "external_sort: write");
+            }
+            p += n;
+            bytes -= size_t(n);
+            offset += off_t(n);
+        }
+    }
+
+    // Returns 0 or an errno value; it runs on the read-ahead thread, so it doesn't throw.
+    inline int __read_fully(int fd, void* data, size_t bytes, off_t offset) noexcept {
+        char* p = static_cast<char*>(data);
+        while (bytes > 0) {
+            const ssize_t n = ::pread(fd, p, bytes, offset);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return errno;
+            }
+            if (n == 0) {
+                return EIO;
+            }
+            p += n;
+            bytes -= size_t(n);
+            offset += off_t(n);
+        }
+        return 0;
+    }
+
+    // A file that is unlinked as soon as it is created, so it goes away when
+    // closed even if the process dies first.
+    class __temp_file {
+    private:
+        int fd;
+
+    public:
+        __temp_file() : fd(-1) {}
+        ~__temp_file() { close(); }
+
+        __temp_file(const __temp_file&) = delete;
+        __temp_file& operator=(const __temp_file&) = delete;
+
+        void open(const std::string& dir) {
+            std::string path = dir + "/tinystl-sort-XXXXXX";
+            const int f = ::mkstemp(&path[0]);
+            if (f < 0) {
+                tinySTL::__external_throw(errno, "external_sort: cannot create temporary file");
+            }
+            ::unlink(path.c_str());
+            close();
+            fd = f;
+        }
+
+        void close() {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+
+        int get() const { return fd; }
+        void swap(__temp_file& x) { tinySTL::swap(fd, x.fd); }
+    };
+
+    struct __read_request {
+        int fd;
+        void* buffer;
+        size_t bytes;
+        off_t offset;
+        int error;
+        bool done;
+    };
+
+    // A thread that serves block reads in the order they are submitted.
+    // Requests still queued when it is destroyed are completed first.
+    class __read_ahead {
+    private:
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable finished;
+        deque<__read_request*> queue;
+        bool stop;
+        std::thread worker;
+
+        void loop() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                wake.wait(lock, [this]() { return stop || !queue.empty(); });
+                if (queue.empty()) {
+                    return;
+                }
+                __read_request* r = queue.front();
+                queue.pop_front();
+                lock.unlock();
+                const int error = tinySTL::__read_fully(r->fd, r->buffer, r->bytes, r->offset);
+                lock.lock();
+                r->error = error;
+                r->done = true;
+                finished.notify_all();
+            }
+        }
+
+    public:
+        __read_ahead() : stop(false) { worker = std::thread([this]() { loop(); }); }
+
+        ~__read_ahead() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = true;
+            }
+            wake.notify_one();
+            worker.join();
+        }
+
+        __read_ahead(const __read_ahead&) = delete;
+        __read_ahead& operator=(const __read_ahead&) = delete;
+
+        void submit(__read_request& r) {
+            std::lock_guard<std::mutex> lock(mutex);
+            r.error = 0;
+            r.done = false;
+            queue.push_back(&r);
+            wake.notify_one();
+        }
+
+        void wait(__read_request& r) {
+            std::unique_lock<std::mutex> lock(mutex);
+            finished.wait(lock, [&r]() { return r.done; });
+            if (r.error) {
+                tinySTL::__external_throw(r.error, "external_sort: read");
+            }
+        }
+    };
+
+    // A sorted run: `count` records starting at byte `offset` of a run file.
+    struct __sort_run {
+        off_t offset;
+        size_t count;
+    };
+
+    // Reads a run through two blocks of `block` records: while the merge
+    // consumes one, the read-ahead thread fills the other with what follows.
+    template <class T>
+    class __run_reader {
+    private:
+        __read_ahead* io;
+        int fd;
+        off_t offset;
+        size_t left;
+        size_t block;
+        T* buffer;
+        __read_request request[2];
+        bool pending[2];
+        const T* cur;
+        const T* last;
+        int active;
+
+        void fetch(int b) {
+            if (left == 0) {
+                return;
+            }
+            const size_t n = left < block ? left : block;
+            request[b].fd = fd;
+            request[b].buffer = buffer + b * block;
+            request[b].bytes = n * sizeof(T);
+            request[b].offset = offset;
+            offset += off_t(n * sizeof(T));
+            left -= n;
+            pending[b] = true;
+            io->submit(request[b]);
+        }
+
+        void use(int b) {
+            active = b;
+            cur = last = buffer + b * block;
+            if (pending[b]) {
+                pending[b] = false;
+                io->wait(request[b]);
+                last = cur + request[b].bytes / sizeof(T);
+            }
+        }
+
+    public:
+        // `buf` has room for 2 * blk records and must outlive every request
+        // submitted to r.
+        void open(__read_ahead& r, int f, const __sort_run& run, T* buf, size_t blk) {
+            io = &r;
+            fd = f;
+            offset = run.offset;
+            left = run.count;
+            block = blk;
+            buffer = buf;
+            pending[0] = pending[1] = false;
+            fetch(0);
+            fetch(1);
+            use(0);
+        }
+
+        bool empty() const { return cur == last; }
+        const T& front() const { return *cur; }
+
+        void pop() {
+            if (++cur == last) {
+                fetch(active);
+                use(active ^ 1);
+            }
+        }
+    };
+
+    // Buffers records and appends them to a file `block` records at a time.
+    template <class T>
+    class __run_writer {
+    private:
+        int fd;
+        off_t offset;
+        T* buffer;
+        size_t block;
+        size_t n;
+
+    public:
+        __run_writer(int f, off_t start, T* buf, size_t blk) : fd(f), offset(start), buffer(buf), block(blk), n(0) {}
+
+        void push(const T& x) {
+            buffer[n++] = x;
+            if (n == block) {
+                flush();
+            }
+        }
+
+        void flush() {
+            if (n) {
+                tinySTL::__write_fully(fd, buffer, n * sizeof(T), offset);
+                offset += off_t(n * sizeof(T));
+                n = 0;
+            }
+        }
+
+        off_t tell() const { return offset + off_t(n * sizeof(T)); }
+    };
+
+    template <class OutputIterator>
+    struct __iterator_sink {
+        OutputIterator out;
+
+        template <class T>
+        void push(const T& x) {
+            *out = x;
+            ++out;
+        }
+    };
+
+    // Merges the k runs at `runs` from file fd into sink, reading each run
+    // through its own pair of blocks of `block` records at `memory`.
+    template <class T, class Sink, class Compare>
+    void __merge_runs(int fd, const __sort_run* runs, size_t k, T* memory, size_t block, Sink& sink, Compare comp) {
+        typedef __run_reader<T> Reader;
+        vector<Reader> readers(k);
+        __read_ahead io;
+        for (size_t i = 0; i < k; ++i) {
+            readers[i].open(io, fd, runs[i], memory + 2 * block * i, block);
+        }
+        __loser_tree<Reader, Compare> tree(readers.begin(), k, comp);
+        while (!tree.empty()) {
+            Reader& r = readers[tree.top()];
+            sink.push(r.front());
+            r.pop();
+            tree.replay();
+        }
+    }
+
+    // Sorts any number of trivially copyable records within a fixed memory
+    // budget. push() the records, then finish() writes them out in order and
+    // leaves the sorter empty for reuse.
+    template <class T, class Compare = less<T>>
+    class external_sorter {
+        static_assert(std::is_trivially_copyable<T>::value, "external_sorter needs trivially copyable records");
+
+    public:
+        typedef T           value_type;
+        typedef Compare     value_compare;
+        typedef size_t      size_type;
+
+    private:
+        size_t capacity;
+        std::string temp_dir;
+        Compare comp;
+        T* buffer;
+        size_t n;
+        size_t total;
+        __temp_file file;
+        off_t file_size;
+        vector<__sort_run> runs;
+
+        size_t min_block() const {
+            const size_t records = __external_min_block_bytes / sizeof(T);
+            return records ? records : 1;
+        }
+
+        // Records per block when k runs are read while one block is written.
+        size_t block_size(size_t k, size_t writers) const {
+            const size_t limit = __external_max_block_bytes / sizeof(T);
+            const size_t block = capacity / (2 * k + writers);
+            return block < limit ? block : (limit ? limit : 1);
+        }
+
+        // Most runs one pass can merge with blocks of at least min_block().
+        size_t fan_in() const {
+            const size_t blocks = capacity / min_block();
+            return blocks > 5 ? (blocks - 1) / 2 : 2;
+        }
+
+        void spill() {
+            tinySTL::sort(buffer, buffer + n, comp);
+            if (file.get() < 0) {
+                file.open(temp_dir);
+                file_size = 0;
+            }
+            tinySTL::__write_fully(file.get(), buffer, n * sizeof(T), file_size);
+            const __sort_run run = { file_size, n };
+            runs.push_back(run);
+            file_size += off_t(n * sizeof(T));
+            n = 0;
+        }
+
+        // Merges groups of fan_in() runs into a new file until a single pass can finish.
+        void merge_passes() {
+            const size_t k_max = fan_in();
+            while (runs.size() > k_max) {
+                __temp_file next;
+                next.open(temp_dir);
+                off_t next_size = 0;
+                vector<__sort_run> merged;
+                for (size_t i = 0; i < runs.size(); i += k_max) {
+                    const size_t k = runs.size() - i < k_max ? runs.size() - i : k_max;
+                    const size_t block = block_size(k, 1);
+                    __sort_run run = { next_size, 0 };
+                    for (size_t j = i; j < i + k; ++j) {
+                        run.count += runs[j].count;
+                    }
+                    __run_writer<T> writer(next.get(), next_size, buffer + 2 * block * k, block);
+                    tinySTL::__merge_runs(file.get(), runs.begin() + i, k, buffer, block, writer, comp);
+                    writer.flush();
+                    next_size = writer.tell();
+                    merged.push_back(run);
+                }
+                file.swap(next);
+                file_size = next_size;
+                runs = std::move(merged);
+            }
+        }
+
+        template <class Sink>
+        void finish_into(Sink& sink) {
+            if (runs.empty()) {
+                tinySTL::sort(buffer, buffer + n, comp);
+                for (size_t i = 0; i < n; ++i) {
+                    sink.push(buffer[i]);
+                }
+            }
+            else {
+                if (n) {
+                    spill();
+                }
+                merge_passes();
+                tinySTL::__merge_runs(file.get(), runs.begin(), runs.size(), buffer, block_size(runs.size(), 0),
+                                      sink, comp);
+            }
+            n = 0;
+            total = 0;
+            runs.clear();
+            file.close();
+        }
+
+    public:
+        // At most memory_bytes are used for records, however many are pushed.
+        // Runs go to temp_dir, or to $TMPDIR or /tmp when it is null.
+        explicit external_sorter(size_t memory_bytes, const char* dir = nullptr, const Compare& x = Compare())
+            : capacity(memory_bytes / sizeof(T)), temp_dir(), comp(x), buffer(nullptr), n(0), total(0),
+              file(), file_size(0), runs() {
+            if (capacity < 16) {
+                capacity = 16;
+            }
+            if (!dir) {
+                dir = std::getenv("TMPDIR");
+            }
+            temp_dir = dir && *dir ? dir : "/tmp";
+        }
+
+        ~external_sorter() {
+            if (buffer) {
+                allocator<T>::deallocate(buffer, capacity);
+            }
+        }
+
+        external_sorter(const external_sorter&) = delete;
+        external_sorter& operator=(const external_sorter&) = delete;
+
+        size_type size() const { return total; }
+        bool empty() const { return total == 0; }
+
+        void push(const T& x) {
+            if (!buffer) {
+                buffer = allocator<T>::allocate(capacity);
+            }
+            else if (n == capacity) {
+                spill();
+            }
+            buffer[n++] = x;
+            ++total;
+        }
+
+        template <class InputIterator>
+        void push(InputIterator first, InputIterator last) {
+            for (; first != last; ++first) {
+                push(*first);
+            }
+        }
+
+        // Writes all records in order to result and returns the end of the output.
+        template <class OutputIterator>
+        OutputIterator finish(OutputIterator result) {
+            __iterator_sink<OutputIterator> sink = { result };
+            finish_into(sink);
+            return sink.out;
+        }
+
+        // Sorts the records in the file at input_path into a file at
+        // output_path, which may be the same path.
+        void sort_file(const char* input_path, const char* output_path);
+    };
+
+    template <class T, class Compare>
+    void external_sorter<T, Compare>::sort_file(const char* input_path, const char* output_path) {
+        const size_t block = min_block() * 4;
+        T* io_buffer = allocator<T>::allocate(2 * block);
+        try {
+            {
+                const int in = ::open(input_path, O_RDONLY);
+                if (in < 0) {
+                    tinySTL::__external_throw(errno, "external_sort: cannot open input");
+                }
+                struct stat st;
+                if (::fstat(in, &st) != 0 || size_t(st.st_size) % sizeof(T) != 0) {
+                    const int error = errno;
+                    ::close(in);
+                    tinySTL::__external_throw(error ? error : EINVAL, "external_sort: bad input size");
+                }
+                try {
+                    const __sort_run whole = { 0, size_t(st.st_size) / sizeof(T) };
+                    __run_reader<T> reader;
+                    __read_ahead io;
+                    reader.open(io, in, whole, io_buffer, block);
+                    for (; !reader.empty(); reader.pop()) {
+                        push(reader.front());
+                    }
+                }
+                catch (...) {
+                    ::close(in);
+                    throw;
+                }
+                ::close(in);
+            }
+            const int out = ::open(output_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (out < 0) {
+                tinySTL::__external_throw(errno, "external_sort: cannot open output");
+            }
+            try {
+                __run_writer<T> writer(out, 0, io_buffer, 2 * block);
+                finish_into(writer);
+                writer.flush();
+            }
+            catch (...) {
+                ::close(out);
+                throw;
+            }
+            if (::close(out) != 0) {
+                tinySTL::__external_throw(errno, "external_sort: close");
+            }
+        }
+        catch (...) {
+            allocator<T>::deallocate(io_buffer, 2 * block);
+            throw;
+        }
+        allocator<T>::deallocate(io_buffer, 2 * block);
+    }
+
+    // Sorts a file of raw T records into output_path using about memory_bytes
+    // of memory plus a few I/O blocks.
+    template <class T, class Compare = less<T>>
+    void external_sort(const char* input_path, const char* output_path, size_t memory_bytes,
+                       const Compare& comp = Compare(), const char* temp_dir = nullptr) {
+        external_sorter<T, Compare> sorter(memory_bytes, temp_dir, comp);
+        sorter.sort_file(input_path, output_path);
+    }
+}
+
+#endif // _TINY_EXTERNAL_SORT_H_
@@ -0,0 +1,201 @@
+#ifndef _TINY_EYTZINGER_H_
+#define _TINY_EYTZINGER_H_
+
+#include <cstddef>
+#include <utility>
+#include "functional.h"
+#include "vector.h"
+#include "flat_set.h"
+#include "flat_map.h"
+
+namespace tinySTL {
+    // Read-only lookup tables in Eytzinger (breadth-first) order: the node at
+    // slot k has its children at 2k and 2k + 1, with slot 0 unused. The top
+    // levels that every search touches share a few cache lines, and the
+    // 2^d descendants d levels below a node are adjacent, so one prefetch
+    // covers them well before the search reaches them.
+
+    enum { __eytzinger_cacheline_size = 64 };
+
+    inline constexpr size_t __eytzinger_floor_pow2(size_t n) {
+        return n < 2 ? 1 : 2 * __eytzinger_floor_pow2(n / 2);
+    }
+
+    // Keys per cache line, rounded down to a power of two: the distance, in
+    // slots of node k, to its descendants that many levels down.
+    template <class Key>
+    inline constexpr size_t __eytzinger_prefetch_stride() {
+        return __eytzinger_floor_pow2(__eytzinger_cacheline_size / sizeof(Key));
+    }
+
+    // Visits the tree rooted at slot k in order, handing each slot the next
+    // element of the sorted input.
+    template <class RandomAccessIterator, class Sink>
+    RandomAccessIterator __eytzinger_fill(RandomAccessIterator sorted, size_t k, size_t n, Sink& sink) {
+        if (k <= n) {
+            sorted = tinySTL::__eytzinger_fill(sorted, 2 * k, n, sink);
+            sink(k, *sorted);
+            ++sorted;
+            sorted = tinySTL::__eytzinger_fill(sorted, 2 * k + 1, n, sink);
+        }
+        return sorted;
+    }
+
+    // Returns the slot of the first key not less than k, or 0 if there is none.
+    // Each step goes left or right by adding the comparison result, so there
+    // is no branch to mispredict; the final right turns are undone by
+    // stripping the trailing one bits of the path.
+    template <class Key, class Compare>
+    size_t __eytzinger_lower_bound(const Key* keys, size_t n, const Key& k, Compare comp) {
+        const size_t stride = __eytzinger_prefetch_stride<Key>();
+        size_t i = 1;
+        while (i <= n) {
+#if defined(__GNUC__)
+            __builtin_prefetch(keys + stride * i);
+#endif
+            i = 2 * i + size_t(comp(keys[i], k));
+        }
+#if defined(__GNUC__)
+        return i >> (__builtin_ctzll(~static_cast<unsigned long long>(i)) + 1);
+#else
+        size_t turns = 1;
+        for (size_t path = i; path & 1; path >>= 1) {
+            ++turns;
+        }
+        return i >> turns;
+#endif
+    }
+
+    template <class Key>
+    struct __eytzinger_key_sink {
+        Key* keys;
+
+        void operator()(size_t k, const Key& x) { keys[k] = x; }
+    };
+
+    template <class Key, class Value>
+    struct __eytzinger_pair_sink {
+        Key* keys;
+        Value* values;
+
+        void operator()(size_t k, const Value& x) {
+            keys[k] = x.first;
+            values[k] = x;
+        }
+    };
+
+    // Set of keys laid out for lookups only. Iteration visits the keys in
+    // layout order, not sorted order. Key must be default constructible.
+    template <class Key, class Compare = less<Key>>
+    class eytzinger_set {
+    public:
+        typedef Key                             key_type;
+        typedef Key                             value_type;
+        typedef Compare                         key_compare;
+        typedef size_t                          size_type;
+        typedef const Key*                      iterator;
+        typedef const Key*                      const_iterator;
+
+    private:
+        vector<Key> keys;
+        Compare comp;
+
+        void build(const flat_set<Key, Compare>& s) {
+            const size_t n = s.size();
+            keys = vector<Key>(n + 1);
+            __eytzinger_key_sink<Key> sink = { keys.begin() };
+            tinySTL::__eytzinger_fill(s.begin(), 1, n, sink);
+        }
+
+    public:
+        eytzinger_set() : keys(size_type(1)), comp() {}
+
+        explicit eytzinger_set(const flat_set<Key, Compare>& s) : keys(), comp(s.key_comp()) { build(s); }
+
+        template <class InputIterator>
+        eytzinger_set(InputIterator first, InputIterator last, const Compare& x = Compare()) : keys(), comp(x) {
+            build(flat_set<Key, Compare>(first, last, x));
+        }
+
+        iterator begin() const { return keys.begin() + 1; }
+        iterator end() const { return keys.end(); }
+        size_type size() const { return keys.size() - 1; }
+        bool empty() const { return size() == 0; }
+
+        // First key not less than k, or end().
+        iterator lower_bound(const key_type& k) const {
+            const size_t i = tinySTL::__eytzinger_lower_bound(keys.begin(), size(), k, comp);
+            return i ? keys.begin() + i : end();
+        }
+
+        iterator find(const key_type& k) const {
+            iterator it = lower_bound(k);
+            return it != end() && !comp(k, *it) ? it : end();
+        }
+
+        size_type count(const key_type& k) const { return find(k) != end() ? 1 : 0; }
+        bool contains(const key_type& k) const { return find(k) != end(); }
+    };
+
+    // Map laid out for lookups only. The keys are searched in their own dense
+    // array so more of them fit per cache line; the key/value pairs sit in a
+    // parallel array at the same slots. Key and T must be default constructible.
+    template <class Key, class T, class Compare = less<Key>>
+    class eytzinger_map {
+    public:
+        typedef Key                             key_type;
+        typedef T                               mapped_type;
+        typedef std::pair<Key, T>               value_type;
+        typedef Compare                         key_compare;
+        typedef size_t                          size_type;
+        typedef const value_type*               iterator;
+        typedef const value_type*               const_iterator;
+
+    private:
+        vector<Key> keys;
+        vector<value_type> values;
+        Compare comp;
+
+        void build(const flat_map<Key, T, Compare>& m) {
+            const size_t n = m.size();
+            keys = vector<Key>(n + 1);
+            values = vector<value_type>(n + 1);
+            __eytzinger_pair_sink<Key, value_type> sink = { keys.begin(), values.begin() };
+            tinySTL::__eytzinger_fill(m.begin(), 1, n, sink);
+        }
+
+    public:
+        eytzinger_map() : keys(size_type(1)), values(size_type(1)), comp() {}
+
+        explicit eytzinger_map(const flat_map<Key, T, Compare>& m) : keys(), values(), comp(m.key_comp()) {
+            build(m);
+        }
+
+        template <class InputIterator>
+        eytzinger_map(InputIterator first, InputIterator last, const Compare& x = Compare())
+            : keys(), values(), comp(x) {
+            build(flat_map<Key, T, Compare>(first, last, x));
+        }
+
+        iterator begin() const { return values.begin() + 1; }
+        iterator end() const { return values.end(); }
+        size_type size() const { return values.size() - 1; }
+        bool empty() const { return size() == 0; }
+
+        // Pair with the first key not less than k, or end().
+        iterator lower_bound(const key_type& k) const {
+            const size_t i = tinySTL::__eytzinger_lower_bound(keys.begin(), size(), k, comp);
+            return i ? values.begin() + i : end();
+        }
+
+        iterator find(const key_type& k) const {
+            const size_t i = tinySTL::__eytzinger_lower_bound(keys.begin(), size(), k, comp);
+            return i && !comp(k, keys[i]) ? values.begin() + i : end();
+        }
+
+        size_type count(const key_type& k) const { return find(k) != end() ? 1 : 0; }
+        bool contains(const key_type& k) const { return find(k) != end(); }
+    };
+}
+
+#endif // _TINY_EYTZINGER_H_
@@ -0,0 +1,114 @@
+#ifndef _TINY_FLAT_MAP_H_
+#define _TINY_FLAT_MAP_H_
+
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include "flat_tree.h"
+#include "functional.h"
+
+namespace tinySTL {
+    // Ordered map over a sorted vector of key/value pairs. Lookups touch
+    // O(log n) elements of one array instead of chasing tree nodes; inserts
+    // shift the tail, so insert in bulk where possible.
+    template <class Key, class T, class Compare = less<Key>>
+    class flat_map {
+    public:
+        typedef Key                     key_type;
+        typedef T                       mapped_type;
+        typedef std::pair<Key, T>       value_type;
+        typedef Compare                 key_compare;
+
+    private:
+        typedef __flat_tree<Key, value_type, select1st<value_type>, Compare> rep_type;
+        rep_type t;
+
+    public:
+        typedef typename rep_type::size_type        size_type;
+        typedef typename rep_type::difference_type  difference_type;
+        typedef typename rep_type::iterator         iterator;
+        typedef typename rep_type::const_iterator   const_iterator;
+
+        flat_map() : t() {}
+        explicit flat_map(const Compare& comp) : t(comp) {}
+
+        // Sorts and deduplicates the range once rather than inserting one by one.
+        template <class InputIterator>
+        flat_map(InputIterator first, InputIterator last, const Compare& comp = Compare()) : t(first, last, comp) {}
+
+        iterator begin() const { return t.begin(); }
+        iterator end() const { return t.end(); }
+        size_type size() const { return t.size(); }
+        size_type capacity() const { return t.capacity(); }
+        bool empty() const { return t.empty(); }
+        key_compare key_comp() const { return t.key_comp(); }
+
+        void reserve(size_type n) { t.reserve(n); }
+        void clear() { t.clear(); }
+
+        iterator find(const key_type& k) const { return t.find(k); }
+        size_type count(const key_type& k) const { return t.count(k); }
+        bool contains(const key_type& k) const { return t.contains(k); }
+        iterator lower_bound(const key_type& k) const { return t.lower_bound(k); }
+        iterator upper_bound(const key_type& k) const { return t.upper_bound(k); }
+
+        std::pair<iterator, iterator> equal_range(const key_type& k) const {
+            return t.equal_range(k);
+        }
+
+        T& at(const key_type& k) {
+            iterator it = t.find(k);
+            if (it == t.end()) {
+                throw std::out_of_range("flat_map::at");
+            }
+            return it->second;
+        }
+
+        const T& at(const key_type& k) const {
+            const_iterator it = t.find(k);
+            if (it == t.end()) {
+                throw std::out_of_range("flat_map::at");
+            }
+            return it->second;
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args) {
+            iterator it = t.lower_bound(k);
+            if (it != t.end() && !key_comp()(k, it->first)) {
+                return std::pair<iterator, bool>(it, false);
+            }
+            it = t.emplace_at(it, std::piecewise_construct, std::forward_as_tuple(k),
+                              std::forward_as_tuple(std::forward<Args>(args)...));
+            return std::pair<iterator, bool>(it, true);
+        }
+
+        T& operator[](const key_type& k) { return try_emplace(k).first->second; }
+
+        std::pair<iterator, bool> insert(const value_type& x) {
+            return t.insert_unique(x);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& x) {
+            return t.insert_unique(std::move(x));
+        }
+
+        template <class InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            t.insert_unique(first, last);
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args&&... args) {
+            return t.emplace_unique(std::forward<Args>(args)...);
+        }
+
+        iterator erase(iterator position) { return t.erase(position); }
+        iterator erase(iterator first, iterator last) { return t.erase(first, last); }
+        size_type erase(const key_type& k) { return t.erase(k); }
+
+        void swap(flat_map& x) { t.swap(x.t); }
+    };
+}
+
+#endif // _TINY_FLAT_MAP_H_
@@ -0,0 +1,87 @@
+#ifndef _TINY_FLAT_SET_H_
+#define _TINY_FLAT_SET_H_
+
+#include <utility>
+#include "flat_tree.h"
+#include "functional.h"
+
+namespace tinySTL {
+    // Ordered set over a sorted vector: contiguous, cheap to iterate and to
+    // search, O(n) to insert into. Best built in bulk and then read.
+    template <class Key, class Compare = less<Key>>
+    class flat_set {
+    private:
+        typedef __flat_tree<Key, Key, identity<Key>, Compare> rep_type;
+        rep_type t;
+
+    public:
+        typedef Key                                 key_type;
+        typedef Key                                 value_type;
+        typedef Compare                             key_compare;
+        typedef Compare                             value_compare;
+        typedef typename rep_type::size_type        size_type;
+        typedef typename rep_type::difference_type  difference_type;
+        typedef typename rep_type::const_iterator   iterator;
+        typedef typename rep_type::const_iterator   const_iterator;
+
+        flat_set() : t() {}
+        explicit flat_set(const Compare& comp) : t(comp) {}
+
+        // Sorts and deduplicates the range once rather than inserting one by one.
+        template <class InputIterator>
+        flat_set(InputIterator first, InputIterator last, const Compare& comp = Compare()) : t(first, last, comp) {}
+
+        iterator begin() const { return t.begin(); }
+        iterator end() const { return t.end(); }
+        size_type size() const { return t.size(); }
+        size_type capacity() const { return t.capacity(); }
+        bool empty() const { return t.empty(); }
+        key_compare key_comp() const { return t.key_comp(); }
+        value_compare value_comp() const { return t.key_comp(); }
+
+        void reserve(size_type n) { t.reserve(n); }
+        void clear() { t.clear(); }
+
+        iterator find(const key_type& k) const { return t.find(k); }
+        size_type count(const key_type& k) const { return t.count(k); }
+        bool contains(const key_type& k) const { return t.contains(k); }
+        iterator lower_bound(const key_type& k) const { return t.lower_bound(k); }
+        iterator upper_bound(const key_type& k) const { return t.upper_bound(k); }
+
+        std::pair<iterator, iterator> equal_range(const key_type& k) const {
+            return t.equal_range(k);
+        }
+
+        std::pair<iterator, bool> insert(const value_type& x) {
+            return t.insert_unique(x);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& x) {
+            return t.insert_unique(std::move(x));
+        }
+
+        template <class InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            t.insert_unique(first, last);
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args&&... args) {
+            return t.emplace_unique(std::forward<Args>(args)...);
+        }
+
+        iterator erase(iterator position) {
+            return t.erase(const_cast<Key*>(position));
+        }
+
+        iterator erase(iterator first, iterator last) {
+            return t.erase(const_cast<Key*>(first), const_cast<Key*>(last));
+        }
+
+        size_type erase(const key_type& k) { return t.erase(k); }
+
+        void swap(flat_set& x) { t.swap(x.t); }
+    };
+}
+
+#endif // _TINY_FLAT_SET_H_
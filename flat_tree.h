@@ -0,0 +1,223 @@
+#ifndef _TINY_FLAT_TREE_H_
+#define _TINY_FLAT_TREE_H_
+
+#include <cstddef>
+#include <utility>
+#include "algorithm.h"
+#include "functional.h"
+#include "vector.h"
+
+namespace tinySTL {
+    template <class Value, class Key, class KeyOfValue, class Compare>
+    struct __flat_lower_compare {
+        Compare comp;
+
+        bool operator()(const Value& x, const Key& k) const { return comp(KeyOfValue()(x), k); }
+    };
+
+    template <class Value, class Key, class KeyOfValue, class Compare>
+    struct __flat_upper_compare {
+        Compare comp;
+
+        bool operator()(const Key& k, const Value& x) const { return comp(k, KeyOfValue()(x)); }
+    };
+
+    template <class Value, class KeyOfValue, class Compare>
+    struct __flat_value_compare {
+        Compare comp;
+
+        bool operator()(const Value& x, const Value& y) const { return comp(KeyOfValue()(x), KeyOfValue()(y)); }
+    };
+
+    // On sorted input, y never orders before x, so x and y are equivalent
+    // exactly when x doesn't order before y.
+    template <class Value, class KeyOfValue, class Compare>
+    struct __flat_sorted_equivalent {
+        Compare comp;
+
+        bool operator()(const Value& x, const Value& y) const { return !comp(KeyOfValue()(x), KeyOfValue()(y)); }
+    };
+
+    // Values kept sorted by key and free of duplicate keys in one contiguous
+    // vector; the representation behind flat_set and flat_map. Lookups are
+    // branchless binary searches, and inserts and erases shift the tail.
+    template <class Key, class Value, class KeyOfValue, class Compare>
+    class __flat_tree {
+    public:
+        typedef Key                                         key_type;
+        typedef Value                                       value_type;
+        typedef Compare                                     key_compare;
+        typedef vector<Value>                               container_type;
+        typedef typename container_type::size_type          size_type;
+        typedef typename container_type::difference_type    difference_type;
+        typedef typename container_type::iterator           iterator;
+        typedef typename container_type::const_iterator     const_iterator;
+
+    protected:
+        typedef __flat_lower_compare<Value, Key, KeyOfValue, Compare>   lower_compare;
+        typedef __flat_upper_compare<Value, Key, KeyOfValue, Compare>   upper_compare;
+        typedef __flat_value_compare<Value, KeyOfValue, Compare>        value_compare;
+        typedef __flat_sorted_equivalent<Value, KeyOfValue, Compare>    sorted_equivalent;
+
+        container_type c;
+        Compare comp;
+
+        const Key& key(const Value& x) const { return KeyOfValue()(x); }
+
+        // Sorts the batch and drops all but one value of each key.
+        void sort_unique(container_type& batch) const {
+            const value_compare vcomp = { comp };
+            const sorted_equivalent equivalent = { comp };
+            tinySTL::sort(batch.begin(), batch.end(), vcomp);
+            batch.erase(tinySTL::unique(batch.begin(), batch.end(), equivalent), batch.end());
+        }
+
+    public:
+        __flat_tree() : c(), comp() {}
+        explicit __flat_tree(const Compare& x) : c(), comp(x) {}
+
+        template <class InputIterator>
+        __flat_tree(InputIterator first, InputIterator last, const Compare& x) : c(), comp(x) {
+            insert_unique(first, last);
+        }
+
+        iterator begin() const { return c.begin(); }
+        iterator end() const { return c.end(); }
+        size_type size() const { return c.size(); }
+        size_type capacity() const { return c.capacity(); }
+        bool empty() const { return c.empty(); }
+        key_compare key_comp() const { return comp; }
+
+        void reserve(size_type n) { c.reserve(n); }
+        void clear() { c.clear(); }
+
+        iterator lower_bound(const Key& k) const {
+            const lower_compare lcomp = { comp };
+            return tinySTL::lower_bound(c.begin(), c.end(), k, lcomp);
+        }
+
+        iterator upper_bound(const Key& k) const {
+            const upper_compare ucomp = { comp };
+            return tinySTL::upper_bound(c.begin(), c.end(), k, ucomp);
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key& k) const {
+            iterator first = lower_bound(k);
+            iterator last = first;
+            if (last != c.end() && !comp(k, key(*last))) {
+                ++last;
+            }
+            return std::pair<iterator, iterator>(first, last);
+        }
+
+        iterator find(const Key& k) const {
+            iterator it = lower_bound(k);
+            return it != c.end() && !comp(k, key(*it)) ? it : c.end();
+        }
+
+        size_type count(const Key& k) const { return find(k) != c.end() ? 1 : 0; }
+        bool contains(const Key& k) const { return find(k) != c.end(); }
+
+        // Inserts a value at `position`, which the caller has found with lower_bound.
+        template <class... Args>
+        iterator emplace_at(iterator position, Args&&... args) {
+            return c.emplace(position, std::forward<Args>(args)...);
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace_unique(Args&&... args) {
+            value_type x(std::forward<Args>(args)...);
+            iterator it = lower_bound(key(x));
+            if (it != c.end() && !comp(key(x), key(*it))) {
+                return std::pair<iterator, bool>(it, false);
+            }
+            return std::pair<iterator, bool>(c.emplace(it, std::move(x)), true);
+        }
+
+        std::pair<iterator, bool> insert_unique(const value_type& x) {
+            iterator it = lower_bound(key(x));
+            if (it != c.end() && !comp(key(x), key(*it))) {
+                return std::pair<iterator, bool>(it, false);
+            }
+            return std::pair<iterator, bool>(c.insert(it, x), true);
+        }
+
+        std::pair<iterator, bool> insert_unique(value_type&& x) {
+            iterator it = lower_bound(key(x));
+            if (it != c.end() && !comp(key(x), key(*it))) {
+                return std::pair<iterator, bool>(it, false);
+            }
+            return std::pair<iterator, bool>(c.insert(it, std::move(x)), true);
+        }
+
+        // Sorts the batch on its own and merges it in one linear pass, instead
+        // of shifting the tail once per element. Keys already present win over
+        // the batch; among equal keys in the batch, which one is kept is
+        // unspecified.
+        template <class InputIterator>
+        void insert_unique(InputIterator first, InputIterator last) {
+            container_type batch;
+            for (; first != last; ++first) {
+                batch.push_back(*first);
+            }
+            if (batch.empty()) {
+                return;
+            }
+            sort_unique(batch);
+            if (c.empty()) {
+                c = std::move(batch);
+                return;
+            }
+            if (comp(key(c.back()), key(batch.front()))) {
+                c.reserve(c.size() + batch.size());
+                for (iterator j = batch.begin(); j != batch.end(); ++j) {
+                    c.push_back(std::move(*j));
+                }
+                return;
+            }
+            container_type merged;
+            merged.reserve(c.size() + batch.size());
+            iterator i = c.begin();
+            iterator j = batch.begin();
+            while (i != c.end() && j != batch.end()) {
+                if (comp(key(*j), key(*i))) {
+                    merged.push_back(std::move(*j));
+                    ++j;
+                }
+                else {
+                    if (!comp(key(*i), key(*j))) {
+                        ++j;
+                    }
+                    merged.push_back(std::move(*i));
+                    ++i;
+                }
+            }
+            for (; i != c.end(); ++i) {
+                merged.push_back(std::move(*i));
+            }
+            for (; j != batch.end(); ++j) {
+                merged.push_back(std::move(*j));
+            }
+            c = std::move(merged);
+        }
+
+        iterator erase(iterator position) { return c.erase(position, position + 1); }
+        iterator erase(iterator first, iterator last) { return c.erase(first, last); }
+
+        size_type erase(const Key& k) {
+            iterator it = find(k);
+            if (it == c.end()) {
+                return 0;
+            }
+            c.erase(it, it + 1);
+            return 1;
+        }
+
+        void swap(__flat_tree& x) {
+            tinySTL::swap(c, x.c);
+            tinySTL::swap(comp, x.comp);
+        }
+    };
+}
+
+#endif // _TINY_FLAT_TREE_H_
@@ -0,0 +1,71 @@
+#ifndef _TINY_FUNCTIONAL_H_
+#define _TINY_FUNCTIONAL_H_
+
+#include <cstddef>
+#include <functional>
+
+namespace tinySTL {
+    template <class T>
+    struct plus {
+        typedef T       first_argument_type;
+        typedef T       second_argument_type;
+        typedef T       result_type;
+
+        T operator()(const T& x, const T& y) const { return x + y; }
+    };
+
+    template <class T>
+    struct less {
+        typedef T       first_argument_type;
+        typedef T       second_argument_type;
+        typedef bool    result_type;
+
+        bool operator()(const T& x, const T& y) const { return x < y; }
+    };
+
+    template <class T>
+    struct greater {
+        typedef T       first_argument_type;
+        typedef T       second_argument_type;
+        typedef bool    result_type;
+
+        bool operator()(const T& x, const T& y) const { return y < x; }
+    };
+
+    template <class T>
+    struct equal_to {
+        typedef T       first_argument_type;
+        typedef T       second_argument_type;
+        typedef bool    result_type;
+
+        bool operator()(const T& x, const T& y) const { return x == y; }
+    };
+
+    // Hash tables mix the result themselves, so hashes only need to be
+    // distinct, not well distributed; the standard ones serve as they are.
+    template <class Key>
+    struct hash {
+        typedef Key     argument_type;
+        typedef size_t  result_type;
+
+        size_t operator()(const Key& x) const { return std::hash<Key>()(x); }
+    };
+
+    template <class T>
+    struct identity {
+        typedef T       argument_type;
+        typedef T       result_type;
+
+        const T& operator()(const T& x) const { return x; }
+    };
+
+    template <class Pair>
+    struct select1st {
+        typedef Pair                        argument_type;
+        typedef typename Pair::first_type   result_type;
+
+        const result_type& operator()(const Pair& x) const { return x.first; }
+    };
+}
+
+#endif // _TINY_FUNCTIONAL_H_
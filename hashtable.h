@@ -0,0 +1,542 @@
+#ifndef _TINY_HASHTABLE_H_
+#define _TINY_HASHTABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include "allocator.h"
+#include "iterator.h"
+#include "algorithm.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace tinySTL {
+    // Open-addressing table in the SwissTable layout. Every slot has a control
+    // byte, kept in an array of its own: a full slot stores the low 7 bits of
+    // its hash, an empty or erased one a negative marker. A lookup scans the
+    // control bytes 16 at a time and only compares keys whose 7 bits match,
+    // so a probe usually touches one control cache line and one slot.
+
+    typedef signed char __hash_ctrl_t;
+
+    enum {
+        __hash_ctrl_empty = -128,
+        __hash_ctrl_deleted = -2,
+        __hash_group_width = 16,
+        __hash_min_capacity = 16
+    };
+
+    inline uint64_t __hash_mix64(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    // murmur3's fmix32.
+    inline uint32_t __hash_mix32(uint32_t h) {
+        h ^= h >> 16;
+        h *= 0x85ebca6bU;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35U;
+        h ^= h >> 16;
+        return h;
+    }
+
+    // Spreads the user's hash over every bit of a size_t, since the low 7
+    // bits go into the control byte and the ones above pick the group.
+    inline size_t __hash_mix(size_t h) {
+        return sizeof(size_t) == 8 ? size_t(tinySTL::__hash_mix64(h)) : size_t(tinySTL::__hash_mix32(uint32_t(h)));
+    }
+
+    inline unsigned __hash_trailing_zeros(unsigned mask) {
+#if defined(__GNUC__)
+        return unsigned(__builtin_ctz(mask));
+#else
+        unsigned n = 0;
+        for (; !(mask & 1); mask >>= 1) {
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    inline unsigned __hash_leading_zeros16(unsigned mask) {
+        unsigned n = 0;
+        for (unsigned bit = 1u << (__hash_group_width - 1); bit && !(mask & bit); bit >>= 1) {
+            ++n;
+        }
+        return n;
+    }
+
+    // 16 control bytes; each match returns a bitmask with bit i set for byte i.
+#if defined(__SSE2__)
+    struct __hash_group {
+        __m128i ctrl;
+
+        explicit __hash_group(const __hash_ctrl_t* p) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+        unsigned match(__hash_ctrl_t h) const {
+            return unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h), ctrl)));
+        }
+
+        unsigned match_empty() const { return match(__hash_ctrl_t(__hash_ctrl_empty)); }
+
+        // Both markers are below -1; full slots are non-negative.
+        unsigned match_empty_or_deleted() const {
+            return unsigned(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl)));
+        }
+    };
+#else
+    struct __hash_group {
+        __hash_ctrl_t ctrl[__hash_group_width];
+
+        explicit __hash_group(const __hash_ctrl_t* p) { memcpy(ctrl, p, sizeof(ctrl)); }
+
+        unsigned match(__hash_ctrl_t h) const {
+            unsigned mask = 0;
+            for (int i = 0; i < __hash_group_width; ++i) {
+                mask |= unsigned(ctrl[i] == h) << i;
+            }
+            return mask;
+        }
+
+        unsigned match_empty() const { return match(__hash_ctrl_t(__hash_ctrl_empty)); }
+
+        unsigned match_empty_or_deleted() const {
+            unsigned mask = 0;
+            for (int i = 0; i < __hash_group_width; ++i) {
+                mask |= unsigned(ctrl[i] < -1) << i;
+            }
+            return mask;
+        }
+    };
+#endif
+
+    template <class T1, class T2>
+    struct __hash_void { typedef void type; };
+
+    // Lookups accept any key type the hash and equality both take when
+    // both declare is_transparent.
+    template <class Hash, class KeyEqual, class = void>
+    struct __hash_is_transparent : std::false_type {};
+
+    template <class Hash, class KeyEqual>
+    struct __hash_is_transparent<Hash, KeyEqual,
+        typename __hash_void<typename Hash::is_transparent, typename KeyEqual::is_transparent>::type>
+        : std::true_type {};
+
+    template <class Value, class Ref, class Ptr>
+    struct __hashtable_iterator {
+        typedef __hashtable_iterator<Value, Value&, Value*>             iterator;
+        typedef __hashtable_iterator<Value, const Value&, const Value*> const_iterator;
+        typedef __hashtable_iterator<Value, Ref, Ptr>                   self;
+
+        typedef forward_iterator_tag    iterator_category;
+        typedef Value                   value_type;
+        typedef Ptr                     pointer;
+        typedef Ref                     reference;
+        typedef ptrdiff_t               difference_type;
+
+        const __hash_ctrl_t* ctrl;
+        const __hash_ctrl_t* last;
+        Value* slot;
+
+        __hashtable_iterator() : ctrl(nullptr), last(nullptr), slot(nullptr) {}
+        __hashtable_iterator(const __hash_ctrl_t* c, const __hash_ctrl_t* l, Value* s) : ctrl(c), last(l), slot(s) {}
+        __hashtable_iterator(const iterator& x) : ctrl(x.ctrl), last(x.last), slot(x.slot) {}
+        self& operator=(const self&) = default;
+
+        // Moves forward to the next full slot, or to the end.
+        void skip_empty() {
+            while (ctrl != last && *ctrl < 0) {
+                ++ctrl;
+                ++slot;
+            }
+        }
+
+        reference operator*() const { return *slot; }
+        pointer operator->() const { return slot; }
+
+        self& operator++() {
+            ++ctrl;
+            ++slot;
+            skip_empty();
+            return *this;
+        }
+
+        self operator++(int) {
+            self tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const self& x) const { return ctrl == x.ctrl; }
+        bool operator!=(const self& x) const { return ctrl != x.ctrl; }
+    };
+
+    // The table behind unordered_set and unordered_map. Capacity is zero or a
+    // power of two of at least one group, and at most 7/8 of the slots are full
+    // or erased. The control array has a group's worth of extra bytes that
+    // mirror the first group, so a 16-byte load at any slot needs no wrap.
+    template <class Value, class Key, class ExtractKey, class Hash, class KeyEqual>
+    class __hashtable {
+    public:
+        typedef Key                                                         key_type;
+        typedef Value                                                       value_type;
+        typedef Hash                                                        hasher;
+        typedef KeyEqual                                                    key_equal;
+        typedef size_t                                                      size_type;
+        typedef ptrdiff_t                                                   difference_type;
+        typedef __hashtable_iterator<Value, Value&, Value*>                 iterator;
+        typedef __hashtable_iterator<Value, const Value&, const Value*>     const_iterator;
+
+    protected:
+        typedef allocator<__hash_ctrl_t>   ctrl_allocator;
+        typedef allocator<Value>           slot_allocator;
+
+        __hash_ctrl_t* ctrl;
+        Value* slots;
+        size_type cap;
+        size_type count;
+        size_type growth_left;
+        Hash hash;
+        KeyEqual equal;
+
+        static size_type max_full(size_type capacity) { return capacity - capacity / 8; }
+
+        void set_ctrl(size_type i, __hash_ctrl_t h) {
+            ctrl[i] = h;
+            if (i < size_type(__hash_group_width)) {
+                ctrl[cap + i] = h;
+            }
+        }
+
+        template <class K>
+        size_type hash_of(const K& k) const { return tinySTL::__hash_mix(hash(k)); }
+
+        // Returns the slot holding k, or cap if there is none.
+        template <class K>
+        size_type find_index(const K& k, size_type h) const {
+            if (cap == 0) {
+                return 0;
+            }
+            const size_type mask = cap - 1;
+            const __hash_ctrl_t h2 = __hash_ctrl_t(h & 0x7f);
+            size_type pos = (h >> 7) & mask;
+            size_type step = 0;
+            while (true) {
+                const __hash_group g(ctrl + pos);
+                for (unsigned m = g.match(h2); m; m &= m - 1) {
+                    const size_type i = (pos + tinySTL::__hash_trailing_zeros(m)) & mask;
+                    if (equal(ExtractKey()(slots[i]), k)) {
+                        return i;
+                    }
+                }
+                if (g.match_empty()) {
+                    return cap;
+                }
+                step += __hash_group_width;
+                pos = (pos + step) & mask;
+            }
+        }
+
+        // The probe moves by 1, 2, 3, ... groups; with a power-of-two number of
+        // groups, that sequence reaches every group.
+        size_type find_first_non_full(size_type h) const {
+            const size_type mask = cap - 1;
+            size_type pos = (h >> 7) & mask;
+            size_type step = 0;
+            while (true) {
+                const unsigned m = __hash_group(ctrl + pos).match_empty_or_deleted();
+                if (m) {
+                    return (pos + tinySTL::__hash_trailing_zeros(m)) & mask;
+                }
+                step += __hash_group_width;
+                pos = (pos + step) & mask;
+            }
+        }
+
+        void resize(size_type new_cap) {
+            __hash_ctrl_t* old_ctrl = ctrl;
+            Value* old_slots = slots;
+            const size_type old_cap = cap;
+
+            ctrl = ctrl_allocator::allocate(new_cap + __hash_group_width);
+            try {
+                slots = slot_allocator::allocate(new_cap);
+            }
+            catch (...) {
+                ctrl_allocator::deallocate(ctrl, new_cap + __hash_group_width);
+                ctrl = old_ctrl;
+                throw;
+            }
+            memset(ctrl, __hash_ctrl_empty, new_cap + __hash_group_width);
+            cap = new_cap;
+            growth_left = max_full(new_cap) - count;
+
+            for (size_type i = 0; i < old_cap; ++i) {
+                if (old_ctrl[i] >= 0) {
+                    const size_type h = hash_of(ExtractKey()(old_slots[i]));
+                    const size_type j = find_first_non_full(h);
+                    set_ctrl(j, __hash_ctrl_t(h & 0x7f));
+                    tinySTL::__relocate(slots + j, old_slots + i);
+                }
+            }
+            if (old_cap) {
+                ctrl_allocator::deallocate(old_ctrl, old_cap + __hash_group_width);
+                slot_allocator::deallocate(old_slots, old_cap);
+            }
+        }
+
+        // Out of room: if tombstones take a good share of the table, rebuilding
+        // at the same size reclaims them; otherwise double.
+        void rehash_and_grow() {
+            if (cap && count <= cap / 2) {
+                resize(cap);
+            }
+            else {
+                resize(cap ? 2 * cap : size_type(__hash_min_capacity));
+            }
+        }
+
+        // Claims a slot for a new value with hash h and returns its index.
+        size_type prepare_insert(size_type h) {
+            size_type i = cap ? find_first_non_full(h) : 0;
+            if (growth_left == 0 && (cap == 0 || ctrl[i] != __hash_ctrl_deleted)) {
+                rehash_and_grow();
+                i = find_first_non_full(h);
+            }
+            ++count;
+            growth_left -= ctrl[i] == __hash_ctrl_empty;
+            set_ctrl(i, __hash_ctrl_t(h & 0x7f));
+            return i;
+        }
+
+        // Marks slot i free. A slot can go back to empty only if no probe ever
+        // passed over it, i.e. if its group was never full from any starting
+        // point; otherwise it becomes a tombstone so later probes keep going.
+        void erase_meta(size_type i) {
+            --count;
+            const size_type before = (i - __hash_group_width) & (cap - 1);
+            const unsigned empty_after = __hash_group(ctrl + i).match_empty();
+            const unsigned empty_before = __hash_group(ctrl + before).match_empty();
+            const bool never_full = empty_before && empty_after &&
+                tinySTL::__hash_trailing_zeros(empty_after) + tinySTL::__hash_leading_zeros16(empty_before) <
+                    unsigned(__hash_group_width);
+            set_ctrl(i, never_full ? __hash_ctrl_t(__hash_ctrl_empty) : __hash_ctrl_t(__hash_ctrl_deleted));
+            growth_left += never_full;
+        }
+
+        void destroy_and_deallocate() {
+            if (cap) {
+                for (size_type i = 0; i < cap; ++i) {
+                    if (ctrl[i] >= 0) {
+                        slot_allocator::destroy(slots + i);
+                    }
+                }
+                ctrl_allocator::deallocate(ctrl, cap + __hash_group_width);
+                slot_allocator::deallocate(slots, cap);
+            }
+        }
+
+        iterator iterator_at(size_type i) const { return iterator(ctrl + i, ctrl + cap, slots + i); }
+
+    public:
+        __hashtable() : ctrl(nullptr), slots(nullptr), cap(0), count(0), growth_left(0), hash(), equal() {}
+
+        __hashtable(size_type n, const Hash& hf, const KeyEqual& eq)
+            : ctrl(nullptr), slots(nullptr), cap(0), count(0), growth_left(0), hash(hf), equal(eq) {
+            reserve(n);
+        }
+
+        __hashtable(const __hashtable& x)
+            : ctrl(nullptr), slots(nullptr), cap(0), count(0), growth_left(0), hash(x.hash), equal(x.equal) {
+            reserve(x.count);
+            try {
+                for (const_iterator it = x.begin(); it != x.end(); ++it) {
+                    const size_type i = prepare_insert(hash_of(ExtractKey()(*it)));
+                    try {
+                        slot_allocator::construct(slots + i, *it);
+                    }
+                    catch (...) {
+                        erase_meta(i);
+                        throw;
+                    }
+                }
+            }
+            catch (...) {
+                destroy_and_deallocate();
+                throw;
+            }
+        }
+
+        __hashtable(__hashtable&& x) noexcept
+            : ctrl(x.ctrl), slots(x.slots), cap(x.cap), count(x.count), growth_left(x.growth_left),
+              hash(x.hash), equal(x.equal) {
+            x.ctrl = nullptr;
+            x.slots = nullptr;
+            x.cap = x.count = x.growth_left = 0;
+        }
+
+        ~__hashtable() { destroy_and_deallocate(); }
+
+        __hashtable& operator=(const __hashtable& x) {
+            if (this != &x) {
+                __hashtable tmp(x);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        __hashtable& operator=(__hashtable&& x) noexcept {
+            if (this != &x) {
+                __hashtable tmp(std::move(x));
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        void swap(__hashtable& x) {
+            tinySTL::swap(ctrl, x.ctrl);
+            tinySTL::swap(slots, x.slots);
+            tinySTL::swap(cap, x.cap);
+            tinySTL::swap(count, x.count);
+            tinySTL::swap(growth_left, x.growth_left);
+            tinySTL::swap(hash, x.hash);
+            tinySTL::swap(equal, x.equal);
+        }
+
+        iterator begin() const {
+            iterator it = iterator_at(0);
+            if (cap) {
+                it.skip_empty();
+            }
+            return it;
+        }
+
+        iterator end() const { return iterator_at(cap); }
+
+        size_type size() const { return count; }
+        bool empty() const { return count == 0; }
+        size_type bucket_count() const { return cap; }
+        float load_factor() const { return cap ? float(count) / float(cap) : 0.0f; }
+        float max_load_factor() const { return 0.875f; }
+        hasher hash_function() const { return hash; }
+        key_equal key_eq() const { return equal; }
+
+        // Makes room for n values without further growth.
+        void reserve(size_type n) {
+            size_type new_cap = cap ? cap : size_type(__hash_min_capacity);
+            while (max_full(new_cap) < n) {
+                new_cap *= 2;
+            }
+            if (new_cap > cap) {
+                resize(new_cap);
+            }
+        }
+
+        void rehash(size_type n) {
+            reserve(max_full(n) > count ? max_full(n) : count);
+        }
+
+        void clear() {
+            if (cap) {
+                for (size_type i = 0; i < cap; ++i) {
+                    if (ctrl[i] >= 0) {
+                        slot_allocator::destroy(slots + i);
+                    }
+                }
+                memset(ctrl, __hash_ctrl_empty, cap + __hash_group_width);
+                count = 0;
+                growth_left = max_full(cap);
+            }
+        }
+
+        template <class K>
+        iterator find(const K& k) const { return iterator_at(find_index(k, hash_of(k))); }
+
+        template <class K>
+        size_type count_of(const K& k) const { return find_index(k, hash_of(k)) != cap ? 1 : 0; }
+
+        template <class K>
+        std::pair<iterator, iterator> equal_range(const K& k) const {
+            iterator it = find(k);
+            iterator last = it;
+            if (it != end()) {
+                ++last;
+            }
+            return std::pair<iterator, iterator>(it, last);
+        }
+
+        // Inserts Value(args...) unless a value with key k is present; the value
+        // is only constructed once its slot is known.
+        template <class K, class... Args>
+        std::pair<iterator, bool> emplace_key(const K& k, Args&&... args) {
+            const size_type h = hash_of(k);
+            size_type i = find_index(k, h);
+            if (i != cap) {
+                return std::pair<iterator, bool>(iterator_at(i), false);
+            }
+            i = prepare_insert(h);
+            try {
+                ::new (static_cast<void*>(slots + i)) Value(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                erase_meta(i);
+                throw;
+            }
+            return std::pair<iterator, bool>(iterator_at(i), true);
+        }
+
+        // The key is only known once the value exists, so the value is built in
+        // scratch storage first and relocated into its slot.
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args&&... args) {
+            alignas(Value) unsigned char buffer[sizeof(Value)];
+            Value* x = ::new (static_cast<void*>(buffer)) Value(std::forward<Args>(args)...);
+            size_type i;
+            try {
+                const size_type h = hash_of(ExtractKey()(*x));
+                i = find_index(ExtractKey()(*x), h);
+                if (i != cap) {
+                    tinySTL::destroy(x);
+                    return std::pair<iterator, bool>(iterator_at(i), false);
+                }
+                i = prepare_insert(h);
+            }
+            catch (...) {
+                tinySTL::destroy(x);
+                throw;
+            }
+            tinySTL::__relocate(slots + i, x);
+            return std::pair<iterator, bool>(iterator_at(i), true);
+        }
+
+        iterator erase(const_iterator position) {
+            const size_type i = size_type(position.ctrl - ctrl);
+            slot_allocator::destroy(slots + i);
+            erase_meta(i);
+            iterator next = iterator_at(i);
+            ++next;
+            return next;
+        }
+
+        template <class K>
+        size_type erase_key(const K& k) {
+            const size_type i = find_index(k, hash_of(k));
+            if (i == cap) {
+                return 0;
+            }
+            slot_allocator::destroy(slots + i);
+            erase_meta(i);
+            return 1;
+        }
+    };
+}
+
+#endif // _TINY_HASHTABLE_H_
@@ -0,0 +1,150 @@
+#ifndef _TINY_HEAP_H_
+#define _TINY_HEAP_H_
+
+#include <cstddef>
+#include <utility>
+#include "iterator.h"
+#include "functional.h"
+
+namespace tinySTL {
+    // Heaps are stored level by level with the children of node i at
+    // Arity * i + 1 ... Arity * i + Arity. Arity 2 is the usual binary heap;
+    // wider heaps are shallower and keep each node's children on one cache line.
+
+    template <size_t Arity, class RandomAccessIterator, class Distance, class T, class Compare>
+    void __sift_up(RandomAccessIterator first, Distance hole, Distance top, T value, Compare comp) {
+        Distance parent = (hole - 1) / Distance(Arity);
+        while (hole > top && comp(*(first + parent), value)) {
+            *(first + hole) = std::move(*(first + parent));
+            hole = parent;
+            parent = (hole - 1) / Distance(Arity);
+        }
+        *(first + hole) = std::move(value);
+    }
+
+    // Moves the hole at `hole` down to a leaf along the path of larger children,
+    // then sifts value up from there. Values placed here usually come from the
+    // bottom of the heap, so this takes fewer comparisons than stopping early.
+    template <size_t Arity, class RandomAccessIterator, class Distance, class T, class Compare>
+    void __sift_down(RandomAccessIterator first, Distance hole, Distance len, T value, Compare comp) {
+        const Distance top = hole;
+        Distance child = Distance(Arity) * hole + 1;
+        while (child + Distance(Arity) <= len) {
+            Distance best = child;
+            for (Distance k = 1; k < Distance(Arity); ++k) {
+                if (comp(*(first + best), *(first + (child + k)))) {
+                    best = child + k;
+                }
+            }
+            *(first + hole) = std::move(*(first + best));
+            hole = best;
+            child = Distance(Arity) * hole + 1;
+        }
+        if (child < len) {
+            Distance best = child;
+            for (Distance k = child + 1; k < len; ++k) {
+                if (comp(*(first + best), *(first + k))) {
+                    best = k;
+                }
+            }
+            *(first + hole) = std::move(*(first + best));
+            hole = best;
+        }
+        tinySTL::__sift_up<Arity>(first, hole, top, std::move(value), comp);
+    }
+
+    template <size_t Arity, class RandomAccessIterator, class Compare>
+    void push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type      T;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        const Distance len = last - first;
+        if (len < 2) {
+            return;
+        }
+        T value = std::move(*(last - 1));
+        tinySTL::__sift_up<Arity>(first, len - 1, Distance(0), std::move(value), comp);
+    }
+
+    template <size_t Arity, class RandomAccessIterator, class Compare>
+    void pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type      T;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        const Distance len = last - first;
+        if (len < 2) {
+            return;
+        }
+        T value = std::move(*(last - 1));
+        *(last - 1) = std::move(*first);
+        tinySTL::__sift_down<Arity>(first, Distance(0), len - 1, std::move(value), comp);
+    }
+
+    template <size_t Arity, class RandomAccessIterator, class Compare>
+    void make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type      T;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        const Distance len = last - first;
+        if (len < 2) {
+            return;
+        }
+        for (Distance parent = (len - 2) / Distance(Arity); ; --parent) {
+            T value = std::move(*(first + parent));
+            tinySTL::__sift_down<Arity>(first, parent, len, std::move(value), comp);
+            if (parent == 0) {
+                break;
+            }
+        }
+    }
+
+    template <size_t Arity, class RandomAccessIterator, class Compare>
+    void sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        for (; last - first > 1; --last) {
+            tinySTL::pop_heap<Arity>(first, last, comp);
+        }
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    inline void push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        tinySTL::push_heap<2>(first, last, comp);
+    }
+
+    template <class RandomAccessIterator>
+    inline void push_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        tinySTL::push_heap<2>(first, last, less<T>());
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    inline void pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        tinySTL::pop_heap<2>(first, last, comp);
+    }
+
+    template <class RandomAccessIterator>
+    inline void pop_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        tinySTL::pop_heap<2>(first, last, less<T>());
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    inline void make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        tinySTL::make_heap<2>(first, last, comp);
+    }
+
+    template <class RandomAccessIterator>
+    inline void make_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        tinySTL::make_heap<2>(first, last, less<T>());
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    inline void sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        tinySTL::sort_heap<2>(first, last, comp);
+    }
+
+    template <class RandomAccessIterator>
+    inline void sort_heap(RandomAccessIterator first, RandomAccessIterator last) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        tinySTL::sort_heap<2>(first, last, less<T>());
+    }
+}
+
+#endif // _TINY_HEAP_H_
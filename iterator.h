@@ -2,6 +2,9 @@
 #define _TINY_ITERATOR_H_
 
 #include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 #include "allocator.h"
 #include "construct.h"
 
@@ -128,27 +131,107 @@ namespace tinySTL {
         ForwardIterator cur = result;
         try {
             while (first != last) {
-                construct(&*cur, *first);
+                tinySTL::construct(&*cur, *first);
                 ++first;
                 ++cur;
             }
         } catch (...) {
-            destroy(result, cur);
+            tinySTL::destroy(result, cur);
             throw;
         }
         return cur;
     }
 
+    template <class T>
+    inline T* __uninitialized_copy_t(const T* first, const T* last, T* result, std::true_type) {
+        const ptrdiff_t n = last - first;
+        if (n > 0) {
+            memmove(result, first, sizeof(T) * n);
+        }
+        return result + n;
+    }
+
+    template <class T>
+    T* __uninitialized_copy_t(const T* first, const T* last, T* result, std::false_type) {
+        T* cur = result;
+        try {
+            for (; first != last; ++first, ++cur) {
+                tinySTL::construct(cur, *first);
+            }
+        } catch (...) {
+            tinySTL::destroy(result, cur);
+            throw;
+        }
+        return cur;
+    }
+
+    template <class T>
+    inline T* uninitialized_copy(const T* first, const T* last, T* result) {
+        return tinySTL::__uninitialized_copy_t(first, last, result, std::is_trivially_copyable<T>());
+    }
+
+    template <class T>
+    inline T* uninitialized_copy(T* first, T* last, T* result) {
+        return tinySTL::__uninitialized_copy_t(static_cast<const T*>(first), static_cast<const T*>(last), result, std::is_trivially_copyable<T>());
+    }
+
+    // Relocates into raw storage, moving when that cannot throw and copying otherwise.
+    template <class T>
+    inline T* __uninitialized_move_if_noexcept(T* first, T* last, T* result, std::true_type) {
+        return tinySTL::uninitialized_copy(first, last, result);
+    }
+
+    template <class T>
+    T* __uninitialized_move_if_noexcept(T* first, T* last, T* result, std::false_type) {
+        T* cur = result;
+        try {
+            for (; first != last; ++first, ++cur) {
+                tinySTL::construct(cur, std::move_if_noexcept(*first));
+            }
+        } catch (...) {
+            tinySTL::destroy(result, cur);
+            throw;
+        }
+        return cur;
+    }
+
+    template <class T>
+    inline T* __uninitialized_move_if_noexcept(T* first, T* last, T* result) {
+        return tinySTL::__uninitialized_move_if_noexcept(first, last, result, std::is_trivially_copyable<T>());
+    }
+
+    // Like __uninitialized_move_if_noexcept, for a buffer that is about to be
+    // released: relocatable types are copied bytewise, and the sources must
+    // then be released through __destroy_relocated, which skips their
+    // destructors.
+    template <class T>
+    inline T* __uninitialized_relocate(T* first, T* last, T* result) {
+        if (__is_relocatable<T>::value && !std::is_trivially_copyable<T>::value) {
+            if (first != last) {
+                std::memcpy(static_cast<void*>(result), static_cast<const void*>(first), size_t(last - first) * sizeof(T));
+            }
+            return result + (last - first);
+        }
+        return tinySTL::__uninitialized_move_if_noexcept(first, last, result);
+    }
+
+    template <class T>
+    inline void __destroy_relocated(T* first, T* last) {
+        if (!__is_relocatable<T>::value) {
+            tinySTL::destroy(first, last);
+        }
+    }
+
     template <class ForwardIterator, class T>
     void uninitialized_fill(ForwardIterator first, ForwardIterator last, const T& x) {
         ForwardIterator cur = first;
         try {
             while (cur != last) {
-                construct(&*cur, x);
+                tinySTL::construct(&*cur, x);
                 ++cur;
             }
         } catch (...) {
-            destroy(first, cur);
+            tinySTL::destroy(first, cur);
             throw;
         }
     }
@@ -158,11 +241,11 @@ namespace tinySTL {
         ForwardIterator cur = first;
         try {
             while (n--) {
-                construct(&*cur, x);
+                tinySTL::construct(&*cur, x);
                 ++cur;
             }
         } catch (...) {
-            destroy(first, cur);
+            tinySTL::destroy(first, cur);
             throw;
         }
         return cur;
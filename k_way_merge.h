@@ -0,0 +1,141 @@
+#ifndef _TINY_K_WAY_MERGE_H_
+#define _TINY_K_WAY_MERGE_H_
+
+#include <cstddef>
+#include <utility>
+#include "iterator.h"
+#include "functional.h"
+#include "algorithm.h"
+#include "vector.h"
+
+namespace tinySTL {
+    // Tournament tree over k sorted sources. Each internal node remembers the
+    // loser of the match played there and slot 0 holds the overall winner, so
+    // replacing the winner's head replays only the matches on its path to the
+    // root: log2(k) comparisons per element, against each node's stored loser.
+    //
+    // A Source provides empty(), front() and pop(); an empty source loses to
+    // everything. On equal heads the lower-numbered source wins, which keeps
+    // the merge stable.
+    template <class Source, class Compare>
+    class __loser_tree {
+    private:
+        Source* sources;
+        size_t k;
+        vector<size_t> tree;
+        Compare comp;
+
+        // Whether source a's head goes out before source b's.
+        bool beats(size_t a, size_t b) const {
+            if (sources[a].empty()) {
+                return false;
+            }
+            if (sources[b].empty()) {
+                return true;
+            }
+            return comp(sources[a].front(), sources[b].front())
+                || (a < b && !comp(sources[b].front(), sources[a].front()));
+        }
+
+        // Plays the matches below node; leaves k ... 2k - 1 stand for the sources.
+        size_t build(size_t node) {
+            if (node >= k) {
+                return node - k;
+            }
+            const size_t left = build(2 * node);
+            const size_t right = build(2 * node + 1);
+            if (beats(right, left)) {
+                tree[node] = left;
+                return right;
+            }
+            tree[node] = right;
+            return left;
+        }
+
+    public:
+        __loser_tree(Source* s, size_t n, Compare c) : sources(s), k(n), tree(n ? n : 1, size_t(0)), comp(c) {
+            if (k) {
+                tree[0] = build(1);
+            }
+        }
+
+        bool empty() const { return k == 0 || sources[tree[0]].empty(); }
+        size_t top() const { return tree[0]; }
+
+        // Call after the winner's source has been popped.
+        void replay() {
+            size_t winner = tree[0];
+            for (size_t node = (winner + k) / 2; node > 0; node /= 2) {
+                if (beats(tree[node], winner)) {
+                    tinySTL::swap(tree[node], winner);
+                }
+            }
+            tree[0] = winner;
+        }
+    };
+
+    template <class InputIterator>
+    struct __range_source {
+        InputIterator cur;
+        InputIterator last;
+
+        bool empty() const { return cur == last; }
+        typename iterator_traits<InputIterator>::reference front() const { return *cur; }
+        void pop() { ++cur; }
+    };
+
+    template <class Range>
+    inline auto __range_begin(Range& r) -> decltype(r.begin()) { return r.begin(); }
+
+    template <class Range>
+    inline auto __range_end(Range& r) -> decltype(r.end()) { return r.end(); }
+
+    template <class InputIterator>
+    inline InputIterator __range_begin(const std::pair<InputIterator, InputIterator>& r) { return r.first; }
+
+    template <class InputIterator>
+    inline InputIterator __range_end(const std::pair<InputIterator, InputIterator>& r) { return r.second; }
+
+    template <class RangeIterator>
+    struct __merge_range_traits {
+        typedef decltype(tinySTL::__range_begin(*RangeIterator())) iterator;
+        typedef typename iterator_traits<iterator>::value_type     value_type;
+    };
+
+    // Merges the sorted ranges in [first, last) into result in one pass and
+    // returns the end of the output. Each range is a container such as vector
+    // or list, or a std::pair of iterators. The merge is stable: equal elements
+    // keep their order within a range, and earlier ranges go first.
+    template <class RangeIterator, class OutputIterator, class Compare>
+    OutputIterator k_way_merge(RangeIterator first, RangeIterator last, OutputIterator result, Compare comp) {
+        typedef typename __merge_range_traits<RangeIterator>::iterator  InputIterator;
+        typedef __range_source<InputIterator>                           Source;
+        vector<Source> sources;
+        for (; first != last; ++first) {
+            Source s = { tinySTL::__range_begin(*first), tinySTL::__range_end(*first) };
+            sources.push_back(s);
+        }
+        if (sources.size() == 1) {
+            for (Source& s = sources[0]; !s.empty(); s.pop(), ++result) {
+                *result = s.front();
+            }
+            return result;
+        }
+        __loser_tree<Source, Compare> tree(sources.begin(), sources.size(), comp);
+        for (; !tree.empty(); ++result) {
+            Source& s = sources[tree.top()];
+            *result = s.front();
+            s.pop();
+            tree.replay();
+        }
+        return result;
+    }
+
+    template <class RangeIterator, class OutputIterator>
+    inline OutputIterator k_way_merge(RangeIterator first, RangeIterator last, OutputIterator result) {
+        typedef typename __merge_range_traits<RangeIterator>::value_type T;
+        return tinySTL::k_way_merge(first, last, result, less<T>());
+    }
+}
+
+#endif // _TINY_K_WAY_MERGE_H_
@@ -31,6 +31,7 @@ namespace tinySTL {
         __list_iterator(link_type x) : node(x) {}
         __list_iterator() {}
         __list_iterator(const iterator& x) : node(x.node) {}
+        self& operator=(const self&) = default;
 
         bool operator==(const self& x) const { return node == x.node; }
         bool operator!=(const self& x) const { return node != x.node; }
@@ -51,7 +52,7 @@ namespace tinySTL {
         }
 
         self& operator--() {
-            node = &((*node)->prev);
+            node = (link_type)(node -> prev);
             return *this;
         }
 
@@ -82,12 +83,12 @@ namespace tinySTL {
 
         link_type create_node(const T& x) {
             link_type p = get_node();
-            construct(&(p -> data), x);
+            tinySTL::construct(&(p -> data), x);
             return p;
         }
 
         void destroy_node(link_type p) {
-            destroy(&(p -> data));
+            tinySTL::destroy(&(p -> data));
             put_node(p);
         }
 
@@ -124,6 +125,46 @@ namespace tinySTL {
 
         list() { empty_initialize(); }
 
+        list(const list& x) {
+            empty_initialize();
+            try {
+                for (link_type cur = x.node -> next; cur != x.node; cur = cur -> next) {
+                    push_back(cur -> data);
+                }
+            }
+            catch (...) {
+                clear();
+                put_node(node);
+                throw;
+            }
+        }
+
+        list(list&& x) {
+            empty_initialize();
+            swap(x);
+        }
+
+        ~list() {
+            clear();
+            put_node(node);
+        }
+
+        list& operator=(const list& x) {
+            if (this != &x) {
+                list tmp(x);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        list& operator=(list&& x) {
+            if (this != &x) {
+                clear();
+                swap(x);
+            }
+            return *this;
+        }
+
         iterator insert(iterator position, const T& x) {
             link_type tmp = create_node(x);
             tmp -> next = position.node;
@@ -0,0 +1,397 @@
+#ifndef _TINY_PACKED_VECTOR_H_
+#define _TINY_PACKED_VECTOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "algorithm.h"
+#include "iterator.h"
+#include "simd.h"
+#include "vector.h"
+
+namespace tinySTL {
+    // Bits needed to write x; 0 needs none.
+    inline unsigned __packed_bit_width(uint64_t x) {
+#if defined(__GNUC__)
+        return x ? 64 - unsigned(__builtin_clzll(x)) : 0;
+#else
+        unsigned n = 0;
+        for (; x; x >>= 1) {
+            ++n;
+        }
+        return n;
+#endif
+    }
+
+    inline uint64_t __packed_mask(unsigned width) { return width >= 64 ? ~uint64_t(0) : (uint64_t(1) << width) - 1; }
+
+    // Values are packed 128 to a block. Value i goes to stream i % 4 at
+    // position i / 4, and the four streams' words are interleaved, so word j
+    // of every stream sits in one 32-byte row. Decoding shifts all four lanes
+    // by the same amount and writes four consecutive values per step.
+    enum {
+        __packed_block = 128,
+        __packed_streams = 4,
+        __packed_per_stream = __packed_block / __packed_streams
+    };
+
+    inline size_t __packed_block_words(unsigned width) {
+        return size_t(__packed_streams) * ((size_t(__packed_per_stream) * width + 63) / 64);
+    }
+
+    // Field i of a block; width must be at least 1.
+    inline uint64_t __packed_get(const uint64_t* words, unsigned width, size_t i) {
+        const size_t pos = (i / __packed_streams) * width;
+        const size_t j = pos >> 6;
+        const unsigned o = unsigned(pos & 63);
+        const size_t s = i % __packed_streams;
+        uint64_t x = words[j * __packed_streams + s] >> o;
+        if (o + width > 64) {
+            x |= words[(j + 1) * __packed_streams + s] << (64 - o);
+        }
+        return x & tinySTL::__packed_mask(width);
+    }
+
+    inline void __packed_set(uint64_t* words, unsigned width, size_t i, uint64_t x) {
+        const uint64_t mask = tinySTL::__packed_mask(width);
+        const size_t pos = (i / __packed_streams) * width;
+        const size_t j = pos >> 6;
+        const unsigned o = unsigned(pos & 63);
+        const size_t s = i % __packed_streams;
+        uint64_t& lo = words[j * __packed_streams + s];
+        lo = (lo & ~(mask << o)) | (x << o);
+        if (o + width > 64) {
+            uint64_t& hi = words[(j + 1) * __packed_streams + s];
+            hi = (hi & ~(mask >> (64 - o))) | (x >> (64 - o));
+        }
+    }
+
+    // Packs 128 values as offsets from base. Width 0 means every value is
+    // base, and the block has no words.
+    inline void __packed_pack(const uint64_t* values, unsigned width, uint64_t base, uint64_t* words) {
+        if (width == 0) {
+            return;
+        }
+        memset(words, 0, tinySTL::__packed_block_words(width) * sizeof(uint64_t));
+        for (size_t i = 0; i < size_t(__packed_block); ++i) {
+            const size_t pos = (i / __packed_streams) * width;
+            const size_t j = pos >> 6;
+            const unsigned o = unsigned(pos & 63);
+            const size_t s = i % __packed_streams;
+            const uint64_t x = values[i] - base;
+            words[j * __packed_streams + s] |= x << o;
+            if (o + width > 64) {
+                words[(j + 1) * __packed_streams + s] |= x >> (64 - o);
+            }
+        }
+    }
+
+    inline void __packed_unpack_scalar(const uint64_t* words, unsigned width, uint64_t base, uint64_t* out) {
+        for (size_t i = 0; i < size_t(__packed_block); ++i) {
+            out[i] = width ? base + tinySTL::__packed_get(words, width, i) : base;
+        }
+    }
+
+#ifdef _TINY_SIMD_X86
+    // One step decodes value k of each stream. The field may run into the
+    // next row, which is loaded only then.
+    _TINY_SIMD_INLINE void __packed_unpack_kernel(const uint64_t* words, unsigned width, uint64_t base, uint64_t* out) {
+        typedef __simd_vector<unsigned long long, 32>::type vec;
+        const vec b = vec() + (unsigned long long)base;
+        if (width == 0) {
+            for (int k = 0; k < __packed_per_stream; ++k) {
+                memcpy(out + __packed_streams * k, &b, sizeof(vec));
+            }
+            return;
+        }
+        const vec mask = vec() + (unsigned long long)tinySTL::__packed_mask(width);
+        vec row;
+        memcpy(&row, words, sizeof(vec));
+        words += __packed_streams;
+        unsigned o = 0;
+        for (int k = 0; k < __packed_per_stream; ++k) {
+            vec x = row >> o;
+            o += width;
+            if (o >= 64) {
+                o -= 64;
+                if (o || k + 1 < __packed_per_stream) {
+                    memcpy(&row, words, sizeof(vec));
+                    words += __packed_streams;
+                    if (o) {
+                        x |= row << (width - o);
+                    }
+                }
+            }
+            x = (x & mask) + b;
+            memcpy(out + __packed_streams * k, &x, sizeof(vec));
+        }
+    }
+
+    __attribute__((target("avx2")))
+    inline void __packed_unpack_avx2(const uint64_t* words, unsigned width, uint64_t base, uint64_t* out) {
+        tinySTL::__packed_unpack_kernel(words, width, base, out);
+    }
+
+    __attribute__((target("sse4.2")))
+    inline void __packed_unpack_sse42(const uint64_t* words, unsigned width, uint64_t base, uint64_t* out) {
+        tinySTL::__packed_unpack_kernel(words, width, base, out);
+    }
+#endif
+
+    // Writes a block's 128 values, each plus base, to out.
+    inline void __packed_unpack(const uint64_t* words, unsigned width, uint64_t base, uint64_t* out) {
+#ifdef _TINY_SIMD_X86
+        switch (tinySTL::__simd_level_supported()) {
+        case __simd_avx2:  tinySTL::__packed_unpack_avx2(words, width, base, out); return;
+        case __simd_sse42: tinySTL::__packed_unpack_sse42(words, width, base, out); return;
+        }
+#endif
+        tinySTL::__packed_unpack_scalar(words, width, base, out);
+    }
+
+    // The const_iterator of packed_vector and delta_vector, over any
+    // Container with decode_block. It decodes a block at a time into a buffer
+    // it carries, so copies of it are not cheap; prefer ++it to it++. *it
+    // refers into that buffer, not into the container, so equal iterators
+    // yield different objects and this is only an input iterator.
+    template <class Container>
+    class __packed_decode_iterator {
+    public:
+        typedef input_iterator_tag      iterator_category;
+        typedef uint64_t                value_type;
+        typedef ptrdiff_t               difference_type;
+        typedef const uint64_t*         pointer;
+        typedef const uint64_t&         reference;
+
+    private:
+        const Container* v;
+        size_t i;
+        mutable size_t decoded;     // the block in buf, or none
+        mutable uint64_t buf[__packed_block];
+
+    public:
+        __packed_decode_iterator() : v(nullptr), i(0), decoded(~size_t(0)) {}
+        __packed_decode_iterator(const Container* c, size_t index) : v(c), i(index), decoded(~size_t(0)) {}
+
+        const uint64_t& operator*() const {
+            const size_t b = i / __packed_block;
+            if (b != decoded) {
+                v->decode_block(b, buf);
+                decoded = b;
+            }
+            return buf[i % __packed_block];
+        }
+
+        __packed_decode_iterator& operator++() {
+            ++i;
+            return *this;
+        }
+
+        __packed_decode_iterator operator++(int) {
+            __packed_decode_iterator tmp = *this;
+            ++i;
+            return tmp;
+        }
+
+        bool operator==(const __packed_decode_iterator& x) const { return i == x.i; }
+        bool operator!=(const __packed_decode_iterator& x) const { return i != x.i; }
+    };
+
+    // Unsigned integers of a fixed number of bits, chosen at run time, packed
+    // into 64-bit words: a million 20-bit ids take 2.5 MB rather than 8, and
+    // an odd width wastes at most one bit per value in rounding. Element i is
+    // field i % 128 of block i / 128, so access is O(1) and touches at most
+    // two words, while scans decode a block at a time with SIMD. Storing a
+    // value wider than the current width repacks everything at the new width.
+    class packed_vector {
+    public:
+        typedef uint64_t        value_type;
+        typedef size_t          size_type;
+        typedef ptrdiff_t       difference_type;
+
+        typedef __packed_decode_iterator<packed_vector> const_iterator;
+        typedef const_iterator iterator;
+
+    private:
+        vector<uint64_t> words;     // one block of words per 128 elements or part
+        size_type count;
+        unsigned width;
+        size_type block_words;
+
+        const uint64_t* block_of(size_type n) const { return words.begin() + (n / __packed_block) * block_words; }
+        uint64_t* block_of(size_type n) { return words.begin() + (n / __packed_block) * block_words; }
+
+        static size_type blocks_for(size_type n) { return (n + __packed_block - 1) / __packed_block; }
+
+        void append_blocks(size_type n) {
+            for (size_type i = n * block_words; i; --i) {
+                words.push_back(0);
+            }
+        }
+
+        // Fields past count hold zeros or popped values, which fit in any
+        // wider width too.
+        void repack(unsigned bits) {
+            packed_vector wider(bits);
+            const size_type blocks = blocks_for(count);
+            wider.words.reserve(blocks * wider.block_words);
+            wider.append_blocks(blocks);
+            uint64_t buf[__packed_block];
+            for (size_type b = 0; b < blocks; ++b) {
+                tinySTL::__packed_unpack(words.begin() + b * block_words, width, 0, buf);
+                tinySTL::__packed_pack(buf, bits, 0, wider.words.begin() + b * wider.block_words);
+            }
+            wider.count = count;
+            swap(wider);
+        }
+
+        void fit(uint64_t x) {
+            const unsigned bits = tinySTL::__packed_bit_width(x);
+            if (bits > width) {
+                repack(bits);
+            }
+        }
+
+    public:
+        explicit packed_vector(unsigned bits = 1) : count(0), width(bits), block_words(tinySTL::__packed_block_words(bits)) {
+            if (bits == 0 || bits > 64) {
+                throw std::out_of_range("packed_vector: width must be 1 to 64");
+            }
+        }
+
+        packed_vector(size_type n, unsigned bits) : packed_vector(bits) {
+            words.reserve(blocks_for(n) * block_words);
+            append_blocks(blocks_for(n));
+            count = n;
+        }
+
+        // Packs v at the given width, or at the narrowest one that holds its
+        // largest element if bits is 0.
+        explicit packed_vector(const vector<uint64_t>& v, unsigned bits = 0) : packed_vector(bits ? bits : 1) {
+            if (!bits) {
+                uint64_t all = 0;
+                for (size_type i = 0; i < v.size(); ++i) {
+                    all |= v[i];
+                }
+                if (tinySTL::__packed_bit_width(all) > width) {
+                    width = tinySTL::__packed_bit_width(all);
+                    block_words = tinySTL::__packed_block_words(width);
+                }
+            }
+            else {
+                const uint64_t mask = tinySTL::__packed_mask(width);
+                for (size_type i = 0; i < v.size(); ++i) {
+                    if (v[i] & ~mask) {
+                        throw std::out_of_range("packed_vector: value wider than width");
+                    }
+                }
+            }
+            const size_type blocks = blocks_for(v.size());
+            words.reserve(blocks * block_words);
+            append_blocks(blocks);
+            size_type i = 0;
+            for (; i + __packed_block <= v.size(); i += __packed_block) {
+                tinySTL::__packed_pack(v.begin() + i, width, 0, block_of(i));
+            }
+            if (i < v.size()) {
+                uint64_t last[__packed_block] = {};
+                memcpy(last, v.begin() + i, (v.size() - i) * sizeof(uint64_t));
+                tinySTL::__packed_pack(last, width, 0, block_of(i));
+            }
+            count = v.size();
+        }
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, count); }
+        size_type size() const { return count; }
+        bool empty() const { return count == 0; }
+        unsigned bit_width() const { return width; }
+
+        // Bytes of packed storage in use.
+        size_type bytes() const { return words.size() * sizeof(uint64_t); }
+
+        uint64_t operator[](size_type n) const { return tinySTL::__packed_get(block_of(n), width, n % __packed_block); }
+
+        uint64_t at(size_type n) const {
+            if (n >= count) {
+                throw std::out_of_range("packed_vector::at");
+            }
+            return (*this)[n];
+        }
+
+        uint64_t front() const { return (*this)[0]; }
+        uint64_t back() const { return (*this)[count - 1]; }
+
+        void set(size_type n, uint64_t x) {
+            fit(x);
+            tinySTL::__packed_set(block_of(n), width, n % __packed_block, x);
+        }
+
+        void reserve(size_type n) { words.reserve(blocks_for(n) * block_words); }
+
+        void push_back(uint64_t x) {
+            fit(x);
+            if (count % __packed_block == 0) {
+                append_blocks(1);
+            }
+            tinySTL::__packed_set(block_of(count), width, count % __packed_block, x);
+            ++count;
+        }
+
+        void pop_back() {
+            --count;
+            if (count % __packed_block == 0) {
+                for (size_type i = 0; i < block_words; ++i) {
+                    words.pop_back();
+                }
+            }
+        }
+
+        void clear() {
+            words.clear();
+            count = 0;
+        }
+
+        // Writes block b's values to out: 128 of them, the last block's
+        // padded with whatever its unused fields hold.
+        void decode_block(size_type b, uint64_t* out) const {
+            tinySTL::__packed_unpack(words.begin() + b * block_words, width, 0, out);
+        }
+
+        // Writes all size() values to out.
+        void decode(uint64_t* out) const {
+            const size_type full = count / __packed_block;
+            for (size_type b = 0; b < full; ++b, out += __packed_block) {
+                decode_block(b, out);
+            }
+            if (count % __packed_block) {
+                uint64_t buf[__packed_block];
+                decode_block(full, buf);
+                memcpy(out, buf, (count % __packed_block) * sizeof(uint64_t));
+            }
+        }
+
+        // Calls f(value) on every element in order; the fastest full scan.
+        template <class F>
+        void for_each(F f) const {
+            uint64_t buf[__packed_block];
+            for (size_type i = 0; i < count; i += __packed_block) {
+                decode_block(i / __packed_block, buf);
+                const size_type n = count - i < size_type(__packed_block) ? count - i : size_type(__packed_block);
+                for (size_type k = 0; k < n; ++k) {
+                    f(buf[k]);
+                }
+            }
+        }
+
+        void swap(packed_vector& x) {
+            tinySTL::swap(words, x.words);
+            tinySTL::swap(count, x.count);
+            tinySTL::swap(width, x.width);
+            tinySTL::swap(block_words, x.block_words);
+        }
+    };
+}
+
+#endif // _TINY_PACKED_VECTOR_H_
@@ -0,0 +1,532 @@
+#ifndef _TINY_PARALLEL_H_
+#define _TINY_PARALLEL_H_
+
+#include <type_traits>
+#include "allocator.h"
+#include "construct.h"
+#include "iterator.h"
+#include "algorithm.h"
+#include "vector.h"
+#include "deque.h"
+#include "execution.h"
+
+namespace tinySTL {
+    enum {
+        __parallel_sort_cutoff = 1 << 15,
+        __parallel_grain = 1 << 12,
+        __parallel_chunks_per_thread = 4
+    };
+
+    template <class Iterator>
+    struct __is_random_access : std::is_convertible<typename iterator_traits<Iterator>::iterator_category,
+                                                    random_access_iterator_tag> {};
+
+    template <class Iterator1, class Iterator2>
+    struct __both_random_access : std::integral_constant<bool,
+        __is_random_access<Iterator1>::value && __is_random_access<Iterator2>::value> {};
+
+    template <class RandomAccessIterator, class Distance>
+    inline Distance __chunk_boundary(RandomAccessIterator, Distance offset) {
+        return offset;
+    }
+
+    // Deque chunks are rounded up to block boundaries so neighbouring chunks never share a block.
+    template <class T, class Ref, class Ptr, size_t BufSize, class Distance>
+    inline Distance __chunk_boundary(__deque_iterator<T, Ref, Ptr, BufSize> first, Distance offset) {
+        const Distance buf = Distance(__deque_iterator<T, Ref, Ptr, BufSize>::buffer_size());
+        const Distance skip = Distance(first.cur - first.first);
+        return (offset + skip + buf - 1) / buf * buf - skip;
+    }
+
+    // Splits [first, first + n) into chunks of at least __parallel_grain elements,
+    // a few per thread for load balance. Chunk i is [bounds[i], bounds[i + 1]).
+    template <class RandomAccessIterator, class Distance>
+    size_t __partition_chunks(RandomAccessIterator first, Distance n, unsigned threads, vector<Distance>& bounds) {
+        size_t chunks = threads < 2 ? 1 : size_t(threads) * __parallel_chunks_per_thread;
+        if (chunks > size_t(n / __parallel_grain)) {
+            chunks = size_t(n / __parallel_grain);
+        }
+        bounds.clear();
+        bounds.push_back(Distance(0));
+        for (size_t k = 1; k < chunks; ++k) {
+            const Distance b = tinySTL::__chunk_boundary(first, Distance(n * Distance(k) / Distance(chunks)));
+            if (b > bounds.back() && b < n) {
+                bounds.push_back(b);
+            }
+        }
+        bounds.push_back(n);
+        return bounds.size() - 1;
+    }
+
+    // Number of elements of a that land among the first `diag` outputs of a
+    // stable merge of a and b.
+    template <class Iterator1, class Iterator2, class Distance, class Compare>
+    Distance __merge_path(Iterator1 a, Distance na, Iterator2 b, Distance nb, Distance diag, Compare comp) {
+        Distance lo = diag > nb ? diag - nb : 0;
+        Distance hi = diag < na ? diag : na;
+        while (lo < hi) {
+            const Distance mid = lo + (hi - lo) / 2;
+            if (comp(*(b + (diag - mid - 1)), *(a + mid))) {
+                hi = mid;
+            }
+            else {
+                lo = mid + 1;
+            }
+        }
+        return lo;
+    }
+
+    template <class InputIterator, class OutputIterator>
+    inline void __merge_put(InputIterator in, OutputIterator out, std::true_type) {
+        tinySTL::construct(&*out, tinySTL::move(*in));
+    }
+
+    template <class InputIterator, class OutputIterator>
+    inline void __merge_put(InputIterator in, OutputIterator out, std::false_type) {
+        *out = tinySTL::move(*in);
+    }
+
+    // Stable merge of [a, a_end) and [b, b_end) into out. With Construct set,
+    // out is raw storage and elements are move-constructed instead of assigned.
+    template <bool Construct, class InputIterator, class OutputIterator, class Compare>
+    void __move_merge(InputIterator a, InputIterator a_end, InputIterator b, InputIterator b_end,
+                      OutputIterator out, Compare comp) {
+        const std::integral_constant<bool, Construct> mode;
+        while (a != a_end && b != b_end) {
+            if (comp(*b, *a)) {
+                tinySTL::__merge_put(b, out, mode);
+                ++b;
+            }
+            else {
+                tinySTL::__merge_put(a, out, mode);
+                ++a;
+            }
+            ++out;
+        }
+        for (; a != a_end; ++a, ++out) {
+            tinySTL::__merge_put(a, out, mode);
+        }
+        for (; b != b_end; ++b, ++out) {
+            tinySTL::__merge_put(b, out, mode);
+        }
+    }
+
+    template <class Distance>
+    struct __merge_task {
+        Distance a_first;
+        Distance a_last;
+        Distance b_first;
+        Distance b_last;
+        Distance out;
+    };
+
+    // One merge round: adjacent runs bounds[2k]..bounds[2k+2] of src are merged into
+    // dst, each pair split along its merge path so every thread gets a share.
+    template <bool Construct, class InputIterator, class OutputIterator, class Distance, class Compare>
+    void __parallel_merge_round(InputIterator src, OutputIterator dst, const vector<Distance>& bounds,
+                                size_t runs, unsigned threads, Compare comp) {
+        typedef __merge_task<Distance> task;
+        const size_t pairs = (runs + 1) / 2;
+        const size_t parts = threads > pairs ? threads / pairs : 1;
+        vector<task> tasks;
+        for (size_t p = 0; p < pairs; ++p) {
+            const Distance a_first = bounds[2 * p];
+            const Distance a_last = bounds[2 * p + 1];
+            const Distance b_last = 2 * p + 2 <= runs ? bounds[2 * p + 2] : a_last;
+            const Distance na = a_last - a_first;
+            const Distance nb = b_last - a_last;
+            Distance prev_i = 0;
+            Distance prev_diag = 0;
+            for (size_t k = 1; k <= parts; ++k) {
+                const Distance diag = k == parts ? na + nb : Distance((na + nb) * k / parts);
+                const Distance i = tinySTL::__merge_path(src + a_first, na, src + a_last, nb, diag, comp);
+                task t = { a_first + prev_i, a_first + i,
+                           a_last + (prev_diag - prev_i), a_last + (diag - i),
+                           a_first + prev_diag };
+                tasks.push_back(t);
+                prev_i = i;
+                prev_diag = diag;
+            }
+        }
+        tinySTL::__parallel_for(tasks.size(), threads, [&](size_t i) {
+            const task& t = tasks[i];
+            tinySTL::__move_merge<Construct>(src + t.a_first, src + t.a_last, src + t.b_first, src + t.b_last,
+                                             dst + t.out, comp);
+        });
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    void parallel_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp, unsigned threads) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type      T;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+
+        const Distance n = last - first;
+        if (threads == 0) {
+            threads = hardware_concurrency();
+        }
+        if (threads > n / __parallel_sort_cutoff) {
+            threads = unsigned(n / __parallel_sort_cutoff);
+        }
+        if (threads < 2) {
+            tinySTL::sort(first, last, comp);
+            return;
+        }
+
+        size_t runs = threads;
+        vector<Distance> bounds(runs + 1, Distance(0));
+        for (size_t i = 0; i <= runs; ++i) {
+            bounds[i] = Distance(n * i / runs);
+        }
+        tinySTL::__parallel_for(runs, threads, [&](size_t i) {
+            tinySTL::sort(first + bounds[i], first + bounds[i + 1], comp);
+        });
+
+        T* buffer = allocator<T>::allocate(size_t(n));
+        bool in_buffer = false;
+        bool constructed = false;
+        while (runs > 1) {
+            if (!in_buffer) {
+                if (constructed) {
+                    tinySTL::__parallel_merge_round<false>(first, buffer, bounds, runs, threads, comp);
+                }
+                else {
+                    tinySTL::__parallel_merge_round<true>(first, buffer, bounds, runs, threads, comp);
+                    constructed = true;
+                }
+            }
+            else {
+                tinySTL::__parallel_merge_round<false>(buffer, first, bounds, runs, threads, comp);
+            }
+            in_buffer = !in_buffer;
+            const size_t merged = (runs + 1) / 2;
+            for (size_t i = 0; i < merged; ++i) {
+                bounds[i] = bounds[2 * i];
+            }
+            bounds[merged] = n;
+            runs = merged;
+        }
+        if (in_buffer) {
+            const Distance chunk = (n + threads - 1) / threads;
+            tinySTL::__parallel_for(threads, threads, [&](size_t i) {
+                const Distance lo = tinySTL::min(n, Distance(i * chunk));
+                const Distance hi = tinySTL::min(n, lo + chunk);
+                for (Distance j = lo; j < hi; ++j) {
+                    *(first + j) = tinySTL::move(buffer[j]);
+                }
+            });
+        }
+        tinySTL::destroy(buffer, buffer + n);
+        allocator<T>::deallocate(buffer, size_t(n));
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    inline void parallel_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        tinySTL::parallel_sort(first, last, comp, hardware_concurrency());
+    }
+
+    template <class RandomAccessIterator>
+    inline void parallel_sort(RandomAccessIterator first, RandomAccessIterator last) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        tinySTL::parallel_sort(first, last, less<T>(), hardware_concurrency());
+    }
+
+    template <class ExecutionPolicy, class RandomAccessIterator, class Compare>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value>::type
+    sort(const ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last, Compare comp) {
+        tinySTL::parallel_sort(first, last, comp, tinySTL::__policy_threads(policy));
+    }
+
+    template <class ExecutionPolicy, class RandomAccessIterator>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value>::type
+    sort(const ExecutionPolicy& policy, RandomAccessIterator first, RandomAccessIterator last) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        tinySTL::parallel_sort(first, last, less<T>(), tinySTL::__policy_threads(policy));
+    }
+
+    template <class InputIterator, class Function>
+    inline void __parallel_for_each(InputIterator first, InputIterator last, Function f, unsigned, std::false_type) {
+        tinySTL::for_each(first, last, f);
+    }
+
+    template <class RandomAccessIterator, class Function>
+    void __parallel_for_each(RandomAccessIterator first, RandomAccessIterator last, Function f, unsigned threads,
+                             std::true_type) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        vector<Distance> bounds;
+        const size_t chunks = tinySTL::__partition_chunks(first, Distance(last - first), threads, bounds);
+        if (chunks < 2) {
+            tinySTL::for_each(first, last, f);
+            return;
+        }
+        tinySTL::__parallel_for(chunks, threads, [&](size_t i) {
+            tinySTL::for_each(first + bounds[i], first + bounds[i + 1], f);
+        });
+    }
+
+    template <class ExecutionPolicy, class InputIterator, class Function>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value>::type
+    for_each(const ExecutionPolicy& policy, InputIterator first, InputIterator last, Function f) {
+        tinySTL::__parallel_for_each(first, last, f, tinySTL::__policy_threads(policy),
+                                     __is_random_access<InputIterator>());
+    }
+
+    template <class ForwardIterator, class T>
+    inline void __parallel_fill(ForwardIterator first, ForwardIterator last, const T& value, unsigned,
+                                std::false_type) {
+        tinySTL::fill(first, last, value);
+    }
+
+    template <class RandomAccessIterator, class T>
+    void __parallel_fill(RandomAccessIterator first, RandomAccessIterator last, const T& value, unsigned threads,
+                         std::true_type) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        vector<Distance> bounds;
+        const size_t chunks = tinySTL::__partition_chunks(first, Distance(last - first), threads, bounds);
+        if (chunks < 2) {
+            tinySTL::fill(first, last, value);
+            return;
+        }
+        tinySTL::__parallel_for(chunks, threads, [&](size_t i) {
+            tinySTL::fill(first + bounds[i], first + bounds[i + 1], value);
+        });
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator, class T>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value>::type
+    fill(const ExecutionPolicy& policy, ForwardIterator first, ForwardIterator last, const T& value) {
+        tinySTL::__parallel_fill(first, last, value, tinySTL::__policy_threads(policy),
+                                 __is_random_access<ForwardIterator>());
+    }
+
+    template <class InputIterator, class OutputIterator, class UnaryOperation>
+    inline OutputIterator __parallel_transform(InputIterator first, InputIterator last, OutputIterator result,
+                                               UnaryOperation op, unsigned, std::false_type) {
+        return tinySTL::transform(first, last, result, op);
+    }
+
+    template <class RandomAccessIterator1, class RandomAccessIterator2, class UnaryOperation>
+    RandomAccessIterator2 __parallel_transform(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                               RandomAccessIterator2 result, UnaryOperation op, unsigned threads,
+                                               std::true_type) {
+        typedef typename iterator_traits<RandomAccessIterator1>::difference_type Distance;
+        const Distance n = last - first;
+        vector<Distance> bounds;
+        const size_t chunks = tinySTL::__partition_chunks(first, n, threads, bounds);
+        if (chunks < 2) {
+            return tinySTL::transform(first, last, result, op);
+        }
+        tinySTL::__parallel_for(chunks, threads, [&](size_t i) {
+            tinySTL::transform(first + bounds[i], first + bounds[i + 1], result + bounds[i], op);
+        });
+        return result + n;
+    }
+
+    template <class ExecutionPolicy, class InputIterator, class OutputIterator, class UnaryOperation>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value, OutputIterator>::type
+    transform(const ExecutionPolicy& policy, InputIterator first, InputIterator last, OutputIterator result,
+              UnaryOperation op) {
+        return tinySTL::__parallel_transform(first, last, result, op, tinySTL::__policy_threads(policy),
+                                             __both_random_access<InputIterator, OutputIterator>());
+    }
+
+    template <class InputIterator1, class InputIterator2, class OutputIterator, class BinaryOperation>
+    inline OutputIterator __parallel_transform(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2,
+                                               OutputIterator result, BinaryOperation op, unsigned, std::false_type) {
+        return tinySTL::transform(first1, last1, first2, result, op);
+    }
+
+    template <class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3,
+              class BinaryOperation>
+    RandomAccessIterator3 __parallel_transform(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                                               RandomAccessIterator2 first2, RandomAccessIterator3 result,
+                                               BinaryOperation op, unsigned threads, std::true_type) {
+        typedef typename iterator_traits<RandomAccessIterator1>::difference_type Distance;
+        const Distance n = last1 - first1;
+        vector<Distance> bounds;
+        const size_t chunks = tinySTL::__partition_chunks(first1, n, threads, bounds);
+        if (chunks < 2) {
+            return tinySTL::transform(first1, last1, first2, result, op);
+        }
+        tinySTL::__parallel_for(chunks, threads, [&](size_t i) {
+            tinySTL::transform(first1 + bounds[i], first1 + bounds[i + 1], first2 + bounds[i], result + bounds[i], op);
+        });
+        return result + n;
+    }
+
+    template <class ExecutionPolicy, class InputIterator1, class InputIterator2, class OutputIterator,
+              class BinaryOperation>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value, OutputIterator>::type
+    transform(const ExecutionPolicy& policy, InputIterator1 first1, InputIterator1 last1, InputIterator2 first2,
+              OutputIterator result, BinaryOperation op) {
+        return tinySTL::__parallel_transform(first1, last1, first2, result, op, tinySTL::__policy_threads(policy),
+                                             std::integral_constant<bool,
+                                                 __both_random_access<InputIterator1, InputIterator2>::value &&
+                                                 __is_random_access<OutputIterator>::value>());
+    }
+
+    template <class InputIterator, class T, class BinaryOperation>
+    inline T __parallel_reduce(InputIterator first, InputIterator last, T init, BinaryOperation op, unsigned,
+                               std::false_type) {
+        return tinySTL::reduce(first, last, tinySTL::move(init), op);
+    }
+
+    // Chunks are reduced independently and the partial results combined in
+    // order, so op must be associative and commutative as for std::reduce.
+    template <class RandomAccessIterator, class T, class BinaryOperation>
+    T __parallel_reduce(RandomAccessIterator first, RandomAccessIterator last, T init, BinaryOperation op,
+                        unsigned threads, std::true_type) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        vector<Distance> bounds;
+        const size_t chunks = tinySTL::__partition_chunks(first, Distance(last - first), threads, bounds);
+        if (chunks < 2) {
+            return tinySTL::reduce(first, last, tinySTL::move(init), op);
+        }
+        vector<T> partials(chunks, init);
+        tinySTL::__parallel_for(chunks, threads, [&](size_t i) {
+            partials[i] = tinySTL::reduce(first + bounds[i] + 1, first + bounds[i + 1], T(*(first + bounds[i])), op);
+        });
+        for (size_t i = 0; i < chunks; ++i) {
+            init = op(tinySTL::move(init), partials[i]);
+        }
+        return init;
+    }
+
+    template <class ExecutionPolicy, class InputIterator, class T, class BinaryOperation>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value, T>::type
+    reduce(const ExecutionPolicy& policy, InputIterator first, InputIterator last, T init, BinaryOperation op) {
+        return tinySTL::__parallel_reduce(first, last, tinySTL::move(init), op, tinySTL::__policy_threads(policy),
+                                          __is_random_access<InputIterator>());
+    }
+
+    template <class ExecutionPolicy, class InputIterator, class T>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value, T>::type
+    reduce(const ExecutionPolicy& policy, InputIterator first, InputIterator last, T init) {
+        return tinySTL::reduce(policy, first, last, tinySTL::move(init), plus<T>());
+    }
+
+    template <class ExecutionPolicy, class InputIterator>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value,
+                                   typename iterator_traits<InputIterator>::value_type>::type
+    reduce(const ExecutionPolicy& policy, InputIterator first, InputIterator last) {
+        typedef typename iterator_traits<InputIterator>::value_type T;
+        return tinySTL::reduce(policy, first, last, T(), plus<T>());
+    }
+
+    template <class InputIterator, class Predicate>
+    inline typename iterator_traits<InputIterator>::difference_type
+    __parallel_count_if(InputIterator first, InputIterator last, Predicate pred, unsigned, std::false_type) {
+        return tinySTL::count_if(first, last, pred);
+    }
+
+    template <class RandomAccessIterator, class Predicate>
+    typename iterator_traits<RandomAccessIterator>::difference_type
+    __parallel_count_if(RandomAccessIterator first, RandomAccessIterator last, Predicate pred, unsigned threads,
+                        std::true_type) {
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+        vector<Distance> bounds;
+        const size_t chunks = tinySTL::__partition_chunks(first, Distance(last - first), threads, bounds);
+        if (chunks < 2) {
+            return tinySTL::count_if(first, last, pred);
+        }
+        vector<Distance> counts(chunks, Distance(0));
+        tinySTL::__parallel_for(chunks, threads, [&](size_t i) {
+            counts[i] = tinySTL::count_if(first + bounds[i], first + bounds[i + 1], pred);
+        });
+        return tinySTL::accumulate(counts.begin(), counts.end(), Distance(0));
+    }
+
+    template <class ExecutionPolicy, class InputIterator, class Predicate>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value,
+                                   typename iterator_traits<InputIterator>::difference_type>::type
+    count_if(const ExecutionPolicy& policy, InputIterator first, InputIterator last, Predicate pred) {
+        return tinySTL::__parallel_count_if(first, last, pred, tinySTL::__policy_threads(policy),
+                                            __is_random_access<InputIterator>());
+    }
+
+    template <bool Inclusive, class InputIterator, class OutputIterator, class BinaryOperation, class T>
+    inline OutputIterator __sequential_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                            BinaryOperation op, T init) {
+        return Inclusive ? tinySTL::inclusive_scan(first, last, result, op, tinySTL::move(init))
+                         : tinySTL::exclusive_scan(first, last, result, tinySTL::move(init), op);
+    }
+
+    template <bool Inclusive, class InputIterator, class OutputIterator, class BinaryOperation, class T>
+    inline OutputIterator __parallel_scan(InputIterator first, InputIterator last, OutputIterator result,
+                                          BinaryOperation op, T init, unsigned, std::false_type) {
+        return tinySTL::__sequential_scan<Inclusive>(first, last, result, op, tinySTL::move(init));
+    }
+
+    // Two passes: reduce every chunk but the last, turn the partial sums into
+    // each chunk's carry-in, then scan all chunks independently from their carry.
+    // Each chunk only touches its own slice of the output, so in-place scans work.
+    template <bool Inclusive, class RandomAccessIterator1, class RandomAccessIterator2, class BinaryOperation, class T>
+    RandomAccessIterator2 __parallel_scan(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                          RandomAccessIterator2 result, BinaryOperation op, T init,
+                                          unsigned threads, std::true_type) {
+        typedef typename iterator_traits<RandomAccessIterator1>::difference_type Distance;
+        const Distance n = last - first;
+        vector<Distance> bounds;
+        const size_t chunks = tinySTL::__partition_chunks(first, n, threads, bounds);
+        if (chunks < 2) {
+            return tinySTL::__sequential_scan<Inclusive>(first, last, result, op, tinySTL::move(init));
+        }
+        vector<T> carry(chunks, init);
+        tinySTL::__parallel_for(chunks - 1, threads, [&](size_t i) {
+            carry[i + 1] = tinySTL::reduce(first + bounds[i] + 1, first + bounds[i + 1], T(*(first + bounds[i])), op);
+        });
+        for (size_t i = 1; i < chunks; ++i) {
+            carry[i] = op(carry[i - 1], carry[i]);
+        }
+        tinySTL::__parallel_for(chunks, threads, [&](size_t i) {
+            tinySTL::__sequential_scan<Inclusive>(first + bounds[i], first + bounds[i + 1], result + bounds[i], op,
+                                                  carry[i]);
+        });
+        return result + n;
+    }
+
+    template <class ExecutionPolicy, class InputIterator, class OutputIterator, class BinaryOperation, class T>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value, OutputIterator>::type
+    inclusive_scan(const ExecutionPolicy& policy, InputIterator first, InputIterator last, OutputIterator result,
+                   BinaryOperation op, T init) {
+        return tinySTL::__parallel_scan<true>(first, last, result, op, tinySTL::move(init),
+                                              tinySTL::__policy_threads(policy),
+                                              __both_random_access<InputIterator, OutputIterator>());
+    }
+
+    template <class ExecutionPolicy, class InputIterator, class OutputIterator, class BinaryOperation>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value, OutputIterator>::type
+    inclusive_scan(const ExecutionPolicy& policy, InputIterator first, InputIterator last, OutputIterator result,
+                   BinaryOperation op) {
+        if (first == last) {
+            return result;
+        }
+        typename iterator_traits<InputIterator>::value_type sum = *first;
+        *result = sum;
+        return tinySTL::inclusive_scan(policy, ++first, last, ++result, op, tinySTL::move(sum));
+    }
+
+    template <class ExecutionPolicy, class InputIterator, class OutputIterator>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value, OutputIterator>::type
+    inclusive_scan(const ExecutionPolicy& policy, InputIterator first, InputIterator last, OutputIterator result) {
+        typedef typename iterator_traits<InputIterator>::value_type T;
+        return tinySTL::inclusive_scan(policy, first, last, result, plus<T>());
+    }
+
+    template <class ExecutionPolicy, class InputIterator, class OutputIterator, class T, class BinaryOperation>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value, OutputIterator>::type
+    exclusive_scan(const ExecutionPolicy& policy, InputIterator first, InputIterator last, OutputIterator result,
+                   T init, BinaryOperation op) {
+        return tinySTL::__parallel_scan<false>(first, last, result, op, tinySTL::move(init),
+                                               tinySTL::__policy_threads(policy),
+                                               __both_random_access<InputIterator, OutputIterator>());
+    }
+
+    template <class ExecutionPolicy, class InputIterator, class OutputIterator, class T>
+    inline typename std::enable_if<is_execution_policy<ExecutionPolicy>::value, OutputIterator>::type
+    exclusive_scan(const ExecutionPolicy& policy, InputIterator first, InputIterator last, OutputIterator result,
+                   T init) {
+        return tinySTL::exclusive_scan(policy, first, last, result, tinySTL::move(init), plus<T>());
+    }
+}
+
+#endif // _TINY_PARALLEL_H_
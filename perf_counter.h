@@ -0,0 +1,258 @@
+#ifndef _TINY_PERF_COUNTER_H_
+#define _TINY_PERF_COUNTER_H_
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace tinySTL {
+    enum perf_event {
+        perf_cycles,
+        perf_instructions,
+        perf_l1d_misses,
+        perf_llc_misses,
+        perf_branch_misses,
+        perf_dtlb_misses,
+        perf_event_count
+    };
+
+    inline const char* perf_event_name(perf_event e) {
+        static const char* const names[perf_event_count] = {
+            "cycles", "instructions", "L1d-misses", "LLC-misses", "branch-misses", "dTLB-misses"
+        };
+        return names[e];
+    }
+
+    // Counter totals over one or more measured regions. A counter that could
+    // not be opened, or that the kernel never got to schedule, is not valid()
+    // and reads as zero. Values are scaled up when the kernel multiplexed the
+    // counter with others, so they are estimates in that case.
+    struct perf_sample {
+        uint64_t value[perf_event_count];
+        bool counted[perf_event_count];
+        uint64_t elapsed_ns;
+        uint64_t regions;
+
+        perf_sample() : elapsed_ns(0), regions(0) {
+            for (int i = 0; i < perf_event_count; ++i) {
+                value[i] = 0;
+                counted[i] = false;
+            }
+        }
+
+        bool valid(perf_event e) const { return counted[e]; }
+        uint64_t operator[](perf_event e) const { return value[e]; }
+
+        // Per operation, for a region that did ops operations in total.
+        double per_op(perf_event e, uint64_t ops) const { return ops ? double(value[e]) / double(ops) : 0.0; }
+        double ns_per_op(uint64_t ops) const { return ops ? double(elapsed_ns) / double(ops) : 0.0; }
+
+        // Instructions per cycle; 0 unless both were counted.
+        double ipc() const {
+            return counted[perf_cycles] && counted[perf_instructions] && value[perf_cycles]
+                ? double(value[perf_instructions]) / double(value[perf_cycles]) : 0.0;
+        }
+
+        perf_sample& operator+=(const perf_sample& x) {
+            for (int i = 0; i < perf_event_count; ++i) {
+                value[i] += x.value[i];
+                counted[i] = counted[i] || x.counted[i];
+            }
+            elapsed_ns += x.elapsed_ns;
+            regions += x.regions;
+            return *this;
+        }
+    };
+
+    // Hardware counters for the calling thread, user space only, opened
+    // through perf_event_open. Each event gets its own descriptor rather than
+    // one group, so a PMU with fewer counters than events still counts all of
+    // them by time-sharing instead of refusing the whole group.
+    //
+    // Opening fails quietly: on other systems, in containers and VMs without
+    // a PMU, or when kernel.perf_event_paranoid forbids it, the events that
+    // couldn't be opened are simply not valid() in the samples and error()
+    // says why. start() and stop() still time the region, so callers need
+    // no separate fallback path.
+    class perf_counters {
+    private:
+        int fd[perf_event_count];
+        int open_error;
+        std::chrono::steady_clock::time_point started;
+
+        perf_counters(const perf_counters&);
+        perf_counters& operator=(const perf_counters&);
+
+#if defined(__linux__)
+        static int open_event(uint32_t type, uint64_t config) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+        }
+
+        static uint64_t cache_event(uint64_t cache, uint64_t result) {
+            return cache | (uint64_t(PERF_COUNT_HW_CACHE_OP_READ) << 8) | (result << 16);
+        }
+#endif
+
+    public:
+        perf_counters() : open_error(0) {
+            for (int i = 0; i < perf_event_count; ++i) {
+                fd[i] = -1;
+            }
+#if defined(__linux__)
+            const uint32_t type[perf_event_count] = {
+                PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+                PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE
+            };
+            const uint64_t config[perf_event_count] = {
+                PERF_COUNT_HW_CPU_CYCLES,
+                PERF_COUNT_HW_INSTRUCTIONS,
+                cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS),
+                cache_event(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_RESULT_MISS),
+                PERF_COUNT_HW_BRANCH_MISSES,
+                cache_event(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_RESULT_MISS)
+            };
+            for (int i = 0; i < perf_event_count; ++i) {
+                fd[i] = open_event(type[i], config[i]);
+                if (fd[i] < 0 && open_error == 0) {
+                    open_error = errno;
+                }
+            }
+#else
+            open_error = ENOSYS;
+#endif
+        }
+
+        ~perf_counters() {
+#if defined(__linux__)
+            for (int i = 0; i < perf_event_count; ++i) {
+                if (fd[i] >= 0) {
+                    close(fd[i]);
+                }
+            }
+#endif
+        }
+
+        bool available(perf_event e) const { return fd[e] >= 0; }
+
+        bool available() const {
+            for (int i = 0; i < perf_event_count; ++i) {
+                if (fd[i] >= 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // The errno of the first event that failed to open, 0 if all opened.
+        int error() const { return open_error; }
+
+        // ENOENT means the hardware has no such event, as under most
+        // hypervisors; EACCES and EPERM mean perf_event_paranoid forbids it.
+        const char* error_message() const {
+            switch (open_error) {
+            case 0:
+                return "all counters available";
+            case ENOENT:
+            case EOPNOTSUPP:
+                return "no hardware counters for this event (no PMU, or a VM that hides it)";
+            case EACCES:
+            case EPERM:
+                return "not permitted; lower kernel.perf_event_paranoid or grant CAP_PERFMON";
+            case ENOSYS:
+                return "perf_event_open is not supported on this system";
+            default:
+                return std::strerror(open_error);
+            }
+        }
+
+        void start() {
+#if defined(__linux__)
+            for (int i = 0; i < perf_event_count; ++i) {
+                if (fd[i] >= 0) {
+                    ioctl(fd[i], PERF_EVENT_IOC_RESET, 0);
+                }
+            }
+#endif
+            started = std::chrono::steady_clock::now();
+#if defined(__linux__)
+            for (int i = 0; i < perf_event_count; ++i) {
+                if (fd[i] >= 0) {
+                    ioctl(fd[i], PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        // Counts since the matching start(), as one region.
+        perf_sample stop() {
+            perf_sample s;
+#if defined(__linux__)
+            for (int i = 0; i < perf_event_count; ++i) {
+                if (fd[i] >= 0) {
+                    ioctl(fd[i], PERF_EVENT_IOC_DISABLE, 0);
+                }
+            }
+#endif
+            s.elapsed_ns = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - started).count());
+            s.regions = 1;
+#if defined(__linux__)
+            for (int i = 0; i < perf_event_count; ++i) {
+                // value, time enabled, time running
+                uint64_t buf[3];
+                if (fd[i] < 0 || read(fd[i], buf, sizeof(buf)) != ssize_t(sizeof(buf)) || buf[2] == 0) {
+                    continue;
+                }
+                s.value[i] = buf[2] < buf[1] ? uint64_t(double(buf[0]) * double(buf[1]) / double(buf[2])) : buf[0];
+                s.counted[i] = true;
+            }
+#endif
+            return s;
+        }
+    };
+
+    // Counts the enclosing scope and adds the result to a sample, so a probe
+    // can sit around a hot path that runs many times:
+    //
+    //     tinySTL::perf_counters counters;
+    //     tinySTL::perf_sample total;
+    //     for (...) {
+    //         tinySTL::perf_probe probe(counters, total);
+    //         hot_path();
+    //     }
+    //
+    // Each probe costs a few system calls at entry and exit, so the region
+    // should do much more work than that. Probes sharing one perf_counters
+    // must not nest.
+    class perf_probe {
+    private:
+        perf_counters& counters;
+        perf_sample& total;
+
+        perf_probe(const perf_probe&);
+        perf_probe& operator=(const perf_probe&);
+
+    public:
+        perf_probe(perf_counters& c, perf_sample& s) : counters(c), total(s) { counters.start(); }
+        ~perf_probe() { total += counters.stop(); }
+    };
+}
+
+#endif // _TINY_PERF_COUNTER_H_
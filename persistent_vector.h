@@ -0,0 +1,675 @@
+#ifndef _TINY_PERSISTENT_VECTOR_H_
+#define _TINY_PERSISTENT_VECTOR_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "algorithm.h"
+#include "allocator.h"
+#include "construct.h"
+#include "iterator.h"
+
+namespace tinySTL {
+    enum {
+        __pvec_bits = 5,
+        __pvec_width = 1 << __pvec_bits,
+        __pvec_mask = __pvec_width - 1
+    };
+
+    // Every node counts the pointers to it, atomically, so vectors sharing
+    // nodes can be copied and destroyed on different threads. edit is the
+    // token of the transient that created the node and may still change it
+    // in place, or 0 once the node is frozen.
+    struct __pvec_node {
+        std::atomic<size_t> refs;
+        uint64_t edit;
+    };
+
+    struct __pvec_inner : __pvec_node {
+        __pvec_node* child[__pvec_width];
+    };
+
+    template <class T>
+    struct __pvec_leaf : __pvec_node {
+        size_t count;
+        alignas(T) unsigned char storage[__pvec_width * sizeof(T)];
+
+        T* values() { return reinterpret_cast<T*>(storage); }
+    };
+
+    // Transient tokens are never reused, so a frozen node can't be mistaken
+    // for one a later transient owns.
+    inline uint64_t __pvec_next_edit() {
+        static std::atomic<uint64_t> last(0);
+        return last.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    // The trie shared by persistent_vector and transient_vector, after
+    // Clojure's PersistentVector: elements live in leaves of 32 under inner
+    // nodes of 32 children, so the tree is log32(n) deep, and the last 1 to
+    // 32 elements sit in a separate tail leaf, so appends rarely touch the
+    // tree at all.
+    //
+    // The edit functions take a transient token. Nodes carrying that token
+    // are changed in place; any other node on the path is copied first and
+    // the copy replaces it, leaving the original to whoever else shares it.
+    // With token 0 every node on the path is copied, which is the persistent
+    // update. Helpers that return a node return a reference the caller owns
+    // and never consume their arguments' references.
+    template <class T>
+    class __pvec_base {
+    protected:
+        typedef __pvec_node                     node;
+        typedef __pvec_inner                    inner;
+        typedef __pvec_leaf<T>                  leaf;
+        typedef allocator<inner>                inner_allocator;
+        typedef allocator<leaf>                 leaf_allocator;
+
+        size_t cnt;
+        unsigned shift;
+        inner* root;
+        leaf* tail;
+
+        static void acquire(node* n) { n->refs.fetch_add(1, std::memory_order_relaxed); }
+
+        static void release(node* n, unsigned level) {
+            if (n->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+            if (level == 0) {
+                leaf* l = static_cast<leaf*>(n);
+                tinySTL::destroy(l->values(), l->values() + l->count);
+                l->~leaf();
+                leaf_allocator::deallocate(l, 1);
+                return;
+            }
+            inner* in = static_cast<inner*>(n);
+            for (int i = 0; i < __pvec_width; ++i) {
+                if (in->child[i]) {
+                    release(in->child[i], level - __pvec_bits);
+                }
+            }
+            in->~inner();
+            inner_allocator::deallocate(in, 1);
+        }
+
+        static inner* new_inner(uint64_t edit) {
+            inner* n = ::new (static_cast<void*>(inner_allocator::allocate(1))) inner;
+            n->refs.store(1, std::memory_order_relaxed);
+            n->edit = edit;
+            for (int i = 0; i < __pvec_width; ++i) {
+                n->child[i] = nullptr;
+            }
+            return n;
+        }
+
+        static leaf* new_leaf(uint64_t edit) {
+            leaf* n = ::new (static_cast<void*>(leaf_allocator::allocate(1))) leaf;
+            n->refs.store(1, std::memory_order_relaxed);
+            n->edit = edit;
+            n->count = 0;
+            return n;
+        }
+
+        static inner* editable(inner* n, uint64_t edit) {
+            if (edit != 0 && n->edit == edit) {
+                acquire(n);
+                return n;
+            }
+            inner* c = new_inner(edit);
+            for (int i = 0; i < __pvec_width; ++i) {
+                if ((c->child[i] = n->child[i]) != nullptr) {
+                    acquire(c->child[i]);
+                }
+            }
+            return c;
+        }
+
+        static leaf* editable(leaf* n, uint64_t edit) {
+            if (edit != 0 && n->edit == edit) {
+                acquire(n);
+                return n;
+            }
+            leaf* c = new_leaf(edit);
+            try {
+                for (; c->count < n->count; ++c->count) {
+                    tinySTL::construct(c->values() + c->count, n->values()[c->count]);
+                }
+            }
+            catch (...) {
+                release(c, 0);
+                throw;
+            }
+            return c;
+        }
+
+        size_t tail_offset() const { return cnt < size_t(__pvec_width) ? 0 : ((cnt - 1) >> __pvec_bits) << __pvec_bits; }
+
+        leaf* leaf_for(size_t i) const {
+            if (i >= tail_offset()) {
+                return tail;
+            }
+            node* n = root;
+            for (unsigned level = shift; level > 0; level -= __pvec_bits) {
+                n = static_cast<inner*>(n)->child[(i >> level) & __pvec_mask];
+            }
+            return static_cast<leaf*>(n);
+        }
+
+        // A chain of fresh inner nodes from level down to l.
+        static node* new_path(unsigned level, leaf* l, uint64_t edit) {
+            if (level == 0) {
+                acquire(l);
+                return l;
+            }
+            inner* n = new_inner(edit);
+            try {
+                n->child[0] = new_path(level - __pvec_bits, l, edit);
+            }
+            catch (...) {
+                release(n, level);
+                throw;
+            }
+            return n;
+        }
+
+        // Hangs the full leaf l at position cnt - 1 below parent, which may be null.
+        inner* push_tail(unsigned level, inner* parent, leaf* l, uint64_t edit) {
+            inner* ret = parent ? editable(parent, edit) : new_inner(edit);
+            const size_t sub = ((cnt - 1) >> level) & __pvec_mask;
+            try {
+                node* nc;
+                if (level == __pvec_bits) {
+                    acquire(l);
+                    nc = l;
+                }
+                else if (ret->child[sub]) {
+                    nc = push_tail(level - __pvec_bits, static_cast<inner*>(ret->child[sub]), l, edit);
+                }
+                else {
+                    nc = new_path(level - __pvec_bits, l, edit);
+                }
+                if (ret->child[sub]) {
+                    release(ret->child[sub], level - __pvec_bits);
+                }
+                ret->child[sub] = nc;
+            }
+            catch (...) {
+                release(ret, level);
+                throw;
+            }
+            return ret;
+        }
+
+        // The subtree at level with element cnt - 2's leaf removed, or null
+        // when nothing is left in it.
+        inner* pop_tail(unsigned level, inner* n, uint64_t edit) {
+            const size_t sub = ((cnt - 2) >> level) & __pvec_mask;
+            node* nc = nullptr;
+            if (level > __pvec_bits) {
+                nc = pop_tail(level - __pvec_bits, static_cast<inner*>(n->child[sub]), edit);
+            }
+            if (!nc && sub == 0) {
+                return nullptr;
+            }
+            inner* ret;
+            try {
+                ret = editable(n, edit);
+            }
+            catch (...) {
+                if (nc) {
+                    release(nc, level - __pvec_bits);
+                }
+                throw;
+            }
+            release(ret->child[sub], level - __pvec_bits);
+            ret->child[sub] = nc;
+            return ret;
+        }
+
+        template <class U>
+        node* set_in(unsigned level, node* n, size_t i, U&& x, uint64_t edit) {
+            if (level == 0) {
+                leaf* l = editable(static_cast<leaf*>(n), edit);
+                try {
+                    l->values()[i & __pvec_mask] = std::forward<U>(x);
+                }
+                catch (...) {
+                    release(l, 0);
+                    throw;
+                }
+                return l;
+            }
+            inner* ret = editable(static_cast<inner*>(n), edit);
+            const size_t sub = (i >> level) & __pvec_mask;
+            node* nc;
+            try {
+                nc = set_in(level - __pvec_bits, ret->child[sub], i, std::forward<U>(x), edit);
+            }
+            catch (...) {
+                release(ret, level);
+                throw;
+            }
+            release(ret->child[sub], level - __pvec_bits);
+            ret->child[sub] = nc;
+            return ret;
+        }
+
+        template <class U>
+        void push_back_edit(U&& x, uint64_t edit) {
+            if (!tail) {
+                leaf* l = new_leaf(edit);
+                try {
+                    tinySTL::construct(l->values(), std::forward<U>(x));
+                }
+                catch (...) {
+                    release(l, 0);
+                    throw;
+                }
+                l->count = 1;
+                tail = l;
+                cnt = 1;
+                return;
+            }
+            if (cnt - tail_offset() < size_t(__pvec_width)) {
+                if (edit != 0 && tail->edit == edit) {
+                    ::new (static_cast<void*>(tail->values() + tail->count)) T(std::forward<U>(x));
+                    ++tail->count;
+                    ++cnt;
+                    return;
+                }
+                leaf* l = editable(tail, edit);
+                try {
+                    ::new (static_cast<void*>(l->values() + l->count)) T(std::forward<U>(x));
+                }
+                catch (...) {
+                    release(l, 0);
+                    throw;
+                }
+                ++l->count;
+                release(tail, 0);
+                tail = l;
+                ++cnt;
+                return;
+            }
+            // The tail is full: it moves into the tree and x starts a new one.
+            leaf* l = new_leaf(edit);
+            inner* new_root;
+            unsigned new_shift = shift;
+            try {
+                ::new (static_cast<void*>(l->values())) T(std::forward<U>(x));
+                l->count = 1;
+                if (!root) {
+                    new_root = new_inner(edit);
+                    acquire(tail);
+                    new_root->child[0] = tail;
+                }
+                else if ((cnt >> __pvec_bits) > (size_t(1) << shift)) {
+                    new_root = new_inner(edit);
+                    try {
+                        new_root->child[1] = new_path(shift, tail, edit);
+                    }
+                    catch (...) {
+                        release(new_root, shift + __pvec_bits);
+                        throw;
+                    }
+                    acquire(root);
+                    new_root->child[0] = root;
+                    new_shift += __pvec_bits;
+                }
+                else {
+                    new_root = push_tail(shift, root, tail, edit);
+                }
+            }
+            catch (...) {
+                release(l, 0);
+                throw;
+            }
+            if (root) {
+                release(root, shift);
+            }
+            root = new_root;
+            shift = new_shift;
+            release(tail, 0);
+            tail = l;
+            ++cnt;
+        }
+
+        template <class U>
+        void set_edit(size_t i, U&& x, uint64_t edit) {
+            const bool in_tail = i >= tail_offset();
+            node* n = in_tail ? static_cast<node*>(tail) : root;
+            unsigned level = in_tail ? 0 : shift;
+            inner* parent = nullptr;
+            size_t sub = 0;
+            // Walk down the nodes this transient owns without touching their
+            // counts; only the rest of the path goes through set_in.
+            while (edit != 0 && n->edit == edit) {
+                if (level == 0) {
+                    static_cast<leaf*>(n)->values()[i & __pvec_mask] = std::forward<U>(x);
+                    return;
+                }
+                parent = static_cast<inner*>(n);
+                sub = (i >> level) & __pvec_mask;
+                n = parent->child[sub];
+                level -= __pvec_bits;
+            }
+            node* nc = set_in(level, n, i, std::forward<U>(x), edit);
+            release(n, level);
+            if (parent) {
+                parent->child[sub] = nc;
+            }
+            else if (in_tail) {
+                tail = static_cast<leaf*>(nc);
+            }
+            else {
+                root = static_cast<inner*>(nc);
+            }
+        }
+
+        void pop_back_edit(uint64_t edit) {
+            if (cnt == 1) {
+                release(tail, 0);
+                tail = nullptr;
+                cnt = 0;
+                return;
+            }
+            if (cnt - tail_offset() > 1) {
+                leaf* l = editable(tail, edit);
+                --l->count;
+                tinySTL::destroy(l->values() + l->count);
+                release(tail, 0);
+                tail = l;
+                --cnt;
+                return;
+            }
+            // The tail empties: the last leaf of the tree becomes the tail.
+            leaf* new_tail = leaf_for(cnt - 2);
+            acquire(new_tail);
+            inner* new_root;
+            try {
+                new_root = pop_tail(shift, root, edit);
+            }
+            catch (...) {
+                release(new_tail, 0);
+                throw;
+            }
+            unsigned new_shift = shift;
+            if (!new_root) {
+                new_shift = __pvec_bits;
+            }
+            else if (shift > __pvec_bits && !new_root->child[1]) {
+                inner* only = static_cast<inner*>(new_root->child[0]);
+                acquire(only);
+                release(new_root, shift);
+                new_root = only;
+                new_shift -= __pvec_bits;
+            }
+            release(root, shift);
+            root = new_root;
+            shift = new_shift;
+            release(tail, 0);
+            tail = new_tail;
+            --cnt;
+        }
+
+        void share(const __pvec_base& x) {
+            cnt = x.cnt;
+            shift = x.shift;
+            root = x.root;
+            tail = x.tail;
+            if (root) {
+                acquire(root);
+            }
+            if (tail) {
+                acquire(tail);
+            }
+        }
+
+        void reset() {
+            if (root) {
+                release(root, shift);
+            }
+            if (tail) {
+                release(tail, 0);
+            }
+            cnt = 0;
+            shift = __pvec_bits;
+            root = nullptr;
+            tail = nullptr;
+        }
+
+        void steal(__pvec_base& x) {
+            cnt = x.cnt;
+            shift = x.shift;
+            root = x.root;
+            tail = x.tail;
+            x.cnt = 0;
+            x.shift = __pvec_bits;
+            x.root = nullptr;
+            x.tail = nullptr;
+        }
+
+        void swap_base(__pvec_base& x) {
+            tinySTL::swap(cnt, x.cnt);
+            tinySTL::swap(shift, x.shift);
+            tinySTL::swap(root, x.root);
+            tinySTL::swap(tail, x.tail);
+        }
+
+        __pvec_base() : cnt(0), shift(__pvec_bits), root(nullptr), tail(nullptr) {}
+        ~__pvec_base() { reset(); }
+
+        __pvec_base(const __pvec_base&) = delete;
+        __pvec_base& operator=(const __pvec_base&) = delete;
+
+    public:
+        // Walks the elements, looking up a leaf only every 32 of them.
+        class const_iterator {
+        public:
+            typedef random_access_iterator_tag  iterator_category;
+            typedef T                           value_type;
+            typedef ptrdiff_t                   difference_type;
+            typedef const T*                    pointer;
+            typedef const T&                    reference;
+
+        private:
+            const __pvec_base* v;
+            size_t i;
+            mutable const T* block;
+            mutable size_t block_start;
+
+            const T* element() const {
+                if (!block || i - block_start >= size_t(__pvec_width)) {
+                    block_start = i & ~size_t(__pvec_mask);
+                    block = v->leaf_for(i)->values();
+                }
+                return block + (i - block_start);
+            }
+
+        public:
+            const_iterator() : v(nullptr), i(0), block(nullptr), block_start(0) {}
+            const_iterator(const __pvec_base* vec, size_t index) : v(vec), i(index), block(nullptr), block_start(0) {}
+
+            reference operator*() const { return *element(); }
+            pointer operator->() const { return element(); }
+            reference operator[](difference_type n) const { return *(*this + n); }
+
+            const_iterator& operator++() { ++i; return *this; }
+            const_iterator operator++(int) { const_iterator tmp = *this; ++i; return tmp; }
+            const_iterator& operator--() { --i; return *this; }
+            const_iterator operator--(int) { const_iterator tmp = *this; --i; return tmp; }
+            const_iterator& operator+=(difference_type n) { i += size_t(n); return *this; }
+            const_iterator& operator-=(difference_type n) { i -= size_t(n); return *this; }
+            const_iterator operator+(difference_type n) const { const_iterator tmp = *this; return tmp += n; }
+            const_iterator operator-(difference_type n) const { const_iterator tmp = *this; return tmp -= n; }
+            difference_type operator-(const const_iterator& x) const { return difference_type(i) - difference_type(x.i); }
+
+            bool operator==(const const_iterator& x) const { return i == x.i; }
+            bool operator!=(const const_iterator& x) const { return i != x.i; }
+            bool operator<(const const_iterator& x) const { return i < x.i; }
+            bool operator>(const const_iterator& x) const { return x.i < i; }
+            bool operator<=(const const_iterator& x) const { return !(x.i < i); }
+            bool operator>=(const const_iterator& x) const { return !(i < x.i); }
+        };
+
+        typedef const_iterator iterator;
+
+        size_t size() const { return cnt; }
+        bool empty() const { return cnt == 0; }
+        const T& operator[](size_t n) const { return leaf_for(n)->values()[n & __pvec_mask]; }
+        const T& front() const { return (*this)[0]; }
+        const T& back() const { return tail->values()[tail->count - 1]; }
+
+        const T& at(size_t n) const {
+            if (n >= cnt) {
+                throw std::out_of_range("persistent_vector::at");
+            }
+            return (*this)[n];
+        }
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, cnt); }
+    };
+
+    template <class T>
+    class transient_vector;
+
+    // An immutable vector whose updates return a new vector sharing every
+    // node the update didn't touch: push_back, set and pop_back copy
+    // O(log32 n) nodes, and copying a vector, to take or publish a snapshot,
+    // is two atomic increments. The nodes are never changed once shared, so
+    // readers on any thread can use their copy without locking; only the
+    // handoff of the vector object itself needs synchronizing, as for any
+    // other value. For many edits in a row, use transient().
+    template <class T>
+    class persistent_vector : public __pvec_base<T> {
+        friend class transient_vector<T>;
+
+    public:
+        typedef T                                               value_type;
+        typedef size_t                                          size_type;
+        typedef ptrdiff_t                                       difference_type;
+        typedef const T&                                        reference;
+        typedef const T&                                        const_reference;
+        typedef typename __pvec_base<T>::const_iterator         const_iterator;
+        typedef const_iterator                                  iterator;
+
+        persistent_vector() {}
+        persistent_vector(const persistent_vector& x) { this->share(x); }
+        persistent_vector(persistent_vector&& x) noexcept { this->steal(x); }
+
+        template <class InputIterator>
+        persistent_vector(InputIterator first, InputIterator last) {
+            transient_vector<T> t;
+            for (; first != last; ++first) {
+                t.push_back(*first);
+            }
+            *this = t.persistent();
+        }
+
+        persistent_vector& operator=(const persistent_vector& x) {
+            if (this != &x) {
+                persistent_vector tmp(x);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        persistent_vector& operator=(persistent_vector&& x) noexcept {
+            if (this != &x) {
+                this->reset();
+                this->steal(x);
+            }
+            return *this;
+        }
+
+        persistent_vector push_back(const T& x) const {
+            persistent_vector r(*this);
+            r.push_back_edit(x, 0);
+            return r;
+        }
+
+        persistent_vector push_back(T&& x) const {
+            persistent_vector r(*this);
+            r.push_back_edit(std::move(x), 0);
+            return r;
+        }
+
+        persistent_vector set(size_type n, const T& x) const {
+            persistent_vector r(*this);
+            r.set_edit(n, x, 0);
+            return r;
+        }
+
+        persistent_vector set(size_type n, T&& x) const {
+            persistent_vector r(*this);
+            r.set_edit(n, std::move(x), 0);
+            return r;
+        }
+
+        persistent_vector pop_back() const {
+            persistent_vector r(*this);
+            r.pop_back_edit(0);
+            return r;
+        }
+
+        transient_vector<T> transient() const { return transient_vector<T>(*this); }
+
+        void swap(persistent_vector& x) { this->swap_base(x); }
+    };
+
+    // A mutable builder over the same trie for bulk edits. It starts out
+    // sharing everything with the vector it came from, copies a node the
+    // first time it changes it, and from then on changes that node in place,
+    // so a run of appends costs about as much as appending to a vector.
+    // persistent() hands the result out in O(1) and freezes what was built;
+    // the transient stays usable and copies again where it edits next.
+    // A transient itself is not thread-safe and can't be copied.
+    template <class T>
+    class transient_vector : public __pvec_base<T> {
+    private:
+        uint64_t edit;
+
+    public:
+        typedef T                                               value_type;
+        typedef size_t                                          size_type;
+        typedef ptrdiff_t                                       difference_type;
+        typedef const T&                                        reference;
+        typedef const T&                                        const_reference;
+        typedef typename __pvec_base<T>::const_iterator         const_iterator;
+        typedef const_iterator                                  iterator;
+
+        transient_vector() : edit(tinySTL::__pvec_next_edit()) {}
+        explicit transient_vector(const persistent_vector<T>& x) : edit(tinySTL::__pvec_next_edit()) { this->share(x); }
+        transient_vector(transient_vector&& x) noexcept : edit(x.edit) { this->steal(x); x.edit = tinySTL::__pvec_next_edit(); }
+
+        transient_vector& operator=(transient_vector&& x) noexcept {
+            if (this != &x) {
+                this->reset();
+                this->steal(x);
+                edit = x.edit;
+                x.edit = tinySTL::__pvec_next_edit();
+            }
+            return *this;
+        }
+
+        void push_back(const T& x) { this->push_back_edit(x, edit); }
+        void push_back(T&& x) { this->push_back_edit(std::move(x), edit); }
+        void set(size_type n, const T& x) { this->set_edit(n, x, edit); }
+        void set(size_type n, T&& x) { this->set_edit(n, std::move(x), edit); }
+        void pop_back() { this->pop_back_edit(edit); }
+
+        persistent_vector<T> persistent() {
+            persistent_vector<T> r;
+            r.share(*this);
+            edit = tinySTL::__pvec_next_edit();
+            return r;
+        }
+    };
+}
+
+#endif // _TINY_PERSISTENT_VECTOR_H_
@@ -0,0 +1,97 @@
+#ifndef _TINY_QUEUE_H_
+#define _TINY_QUEUE_H_
+
+#include <cstddef>
+#include <utility>
+#include "algorithm.h"
+#include "functional.h"
+#include "heap.h"
+#include "vector.h"
+
+namespace tinySTL {
+    // Max-heap adaptor. Arity is the heap's fan-out: 4 halves the depth of a
+    // binary heap and keeps the children of a node together in memory.
+    template <class T, class Container = vector<T>, class Compare = less<typename Container::value_type>,
+              size_t Arity = 4>
+    class priority_queue {
+    public:
+        typedef typename Container::value_type      value_type;
+        typedef typename Container::size_type       size_type;
+        typedef typename Container::reference       reference;
+        typedef typename Container::const_reference const_reference;
+        typedef Container                           container_type;
+        typedef Compare                             value_compare;
+
+    protected:
+        Container c;
+        Compare comp;
+
+    public:
+        priority_queue() : c(), comp() {}
+        explicit priority_queue(const Compare& x) : c(), comp(x) {}
+
+        priority_queue(const Compare& x, const Container& s) : c(s), comp(x) {
+            tinySTL::make_heap<Arity>(c.begin(), c.end(), comp);
+        }
+
+        priority_queue(const Compare& x, Container&& s) : c(std::move(s)), comp(x) {
+            tinySTL::make_heap<Arity>(c.begin(), c.end(), comp);
+        }
+
+        template <class InputIterator>
+        priority_queue(InputIterator first, InputIterator last, const Compare& x = Compare()) : c(), comp(x) {
+            push_range(first, last);
+        }
+
+        bool empty() const { return c.size() == 0; }
+        size_type size() const { return c.size(); }
+        const_reference top() const { return *c.begin(); }
+
+        void push(const value_type& x) {
+            c.push_back(x);
+            tinySTL::push_heap<Arity>(c.begin(), c.end(), comp);
+        }
+
+        void push(value_type&& x) {
+            c.push_back(std::move(x));
+            tinySTL::push_heap<Arity>(c.begin(), c.end(), comp);
+        }
+
+        template <class... Args>
+        void emplace(Args&&... args) {
+            c.emplace_back(std::forward<Args>(args)...);
+            tinySTL::push_heap<Arity>(c.begin(), c.end(), comp);
+        }
+
+        // Appends the range, then either sifts each new element up or, when the
+        // batch is at least as large as the existing heap, rebuilds it in O(n).
+        template <class InputIterator>
+        void push_range(InputIterator first, InputIterator last) {
+            const size_type old_size = c.size();
+            for (; first != last; ++first) {
+                c.push_back(*first);
+            }
+            const size_type new_size = c.size();
+            if (new_size - old_size >= old_size) {
+                tinySTL::make_heap<Arity>(c.begin(), c.end(), comp);
+            }
+            else {
+                for (size_type i = old_size + 1; i <= new_size; ++i) {
+                    tinySTL::push_heap<Arity>(c.begin(), c.begin() + i, comp);
+                }
+            }
+        }
+
+        void pop() {
+            tinySTL::pop_heap<Arity>(c.begin(), c.end(), comp);
+            c.pop_back();
+        }
+
+        void swap(priority_queue& x) {
+            tinySTL::swap(c, x.c);
+            tinySTL::swap(comp, x.comp);
+        }
+    };
+}
+
+#endif // _TINY_QUEUE_H_
@@ -0,0 +1,282 @@
+#ifndef _TINY_RADIX_SORT_H_
+#define _TINY_RADIX_SORT_H_
+
+#include <climits>
+#include <cstring>
+#include <type_traits>
+#include "iterator.h"
+#include "algorithm.h"
+#include "vector.h"
+
+namespace tinySTL {
+    enum {
+        __radix_bits = 8,
+        __radix_buckets = 1 << __radix_bits,
+        __radix_msd_cutoff = 64,
+        __radix_lsd_cutoff_per_pass = 128
+    };
+
+    // Ranges longer than this are sorted in place (MSD) rather than through a
+    // scratch buffer of the same size.
+    const size_t __radix_inplace_threshold = size_t(1) << 27;
+
+    template <size_t Size> struct __radix_unsigned;
+    template <> struct __radix_unsigned<1> { typedef unsigned char      type; };
+    template <> struct __radix_unsigned<2> { typedef unsigned short     type; };
+    template <> struct __radix_unsigned<4> { typedef unsigned int       type; };
+    template <> struct __radix_unsigned<8> { typedef unsigned long long type; };
+
+    // Maps a key to an unsigned integer whose natural order matches the key's order.
+    template <class Key, bool IsFloat = std::is_floating_point<Key>::value, bool IsSigned = std::is_signed<Key>::value>
+    struct __radix_key_traits {
+        typedef typename __radix_unsigned<sizeof(Key)>::type unsigned_type;
+        static unsigned_type encode(Key k) { return unsigned_type(k); }
+    };
+
+    template <class Key>
+    struct __radix_key_traits<Key, false, true> {
+        typedef typename __radix_unsigned<sizeof(Key)>::type unsigned_type;
+        static unsigned_type encode(Key k) {
+            return unsigned_type(k) ^ (unsigned_type(1) << (sizeof(Key) * CHAR_BIT - 1));
+        }
+    };
+
+    template <class Key>
+    struct __radix_key_traits<Key, true, true> {
+        typedef typename __radix_unsigned<sizeof(Key)>::type unsigned_type;
+        static unsigned_type encode(Key k) {
+            unsigned_type bits;
+            memcpy(&bits, &k, sizeof(Key));
+            const unsigned_type sign = unsigned_type(1) << (sizeof(Key) * CHAR_BIT - 1);
+            return (bits & sign) ? unsigned_type(~bits) : unsigned_type(bits | sign);
+        }
+    };
+
+    struct __radix_identity {
+        template <class T>
+        const T& operator()(const T& x) const { return x; }
+    };
+
+    template <class T, class KeyFunction>
+    struct __radix_encoder {
+        typedef typename std::decay<decltype(std::declval<KeyFunction&>()(std::declval<const T&>()))>::type key_type;
+        typedef __radix_key_traits<key_type>                                                                traits;
+        typedef typename traits::unsigned_type                                                               unsigned_type;
+
+        KeyFunction key;
+
+        unsigned_type operator()(const T& x) const { return traits::encode(key(x)); }
+    };
+
+    template <class Encoder>
+    struct __radix_less {
+        Encoder encode;
+
+        template <class T>
+        bool operator()(const T& a, const T& b) const { return encode(a) < encode(b); }
+    };
+
+    // Short ranges don't amortize one histogram per digit; sort them by comparison.
+    template <class Encoder>
+    inline bool __radix_use_comparison(size_t n) {
+        return n < __radix_lsd_cutoff_per_pass * sizeof(typename Encoder::unsigned_type);
+    }
+
+    // n elements of scratch that the caller overwrites before reading. Trivially
+    // copyable ones are left unconstructed; zeroing them first would cost a
+    // pass over memory.
+    template <class T>
+    inline vector<T> __radix_scratch(size_t n, std::true_type) {
+        vector<T> v;
+        v.resize_default_init(n);
+        return v;
+    }
+
+    template <class T>
+    inline vector<T> __radix_scratch(size_t n, std::false_type) {
+        return vector<T>(n);
+    }
+
+    template <class T>
+    inline vector<T> __radix_scratch(size_t n) {
+        return tinySTL::__radix_scratch<T>(n, std::is_trivially_copyable<T>());
+    }
+
+    template <class T, class Encoder>
+    void __radix_sort_lsd(T* data, T* buffer, size_t n, Encoder encode) {
+        typedef typename Encoder::unsigned_type U;
+        const int passes = int(sizeof(U));
+        size_t counts[sizeof(U)][__radix_buckets];
+        memset(counts, 0, sizeof(counts));
+        for (size_t i = 0; i < n; ++i) {
+            const U k = encode(data[i]);
+            for (int p = 0; p < passes; ++p) {
+                ++counts[p][(k >> (p * __radix_bits)) & (__radix_buckets - 1)];
+            }
+        }
+
+        T* src = data;
+        T* dst = buffer;
+        for (int p = 0; p < passes; ++p) {
+            size_t* count = counts[p];
+            const int shift = p * __radix_bits;
+            if (count[(encode(src[0]) >> shift) & (__radix_buckets - 1)] == n) {
+                continue;
+            }
+            size_t offset[__radix_buckets];
+            size_t sum = 0;
+            for (int b = 0; b < __radix_buckets; ++b) {
+                offset[b] = sum;
+                sum += count[b];
+            }
+            for (size_t i = 0; i < n; ++i) {
+                const size_t digit = (encode(src[i]) >> shift) & (__radix_buckets - 1);
+                dst[offset[digit]++] = tinySTL::move(src[i]);
+            }
+            T* tmp = src;
+            src = dst;
+            dst = tmp;
+        }
+        if (src != data) {
+            for (size_t i = 0; i < n; ++i) {
+                data[i] = tinySTL::move(src[i]);
+            }
+        }
+    }
+
+    // In-place MSD (American flag) radix sort on the digit at `shift`.
+    template <class RandomAccessIterator, class Encoder>
+    void __radix_sort_msd(RandomAccessIterator first, RandomAccessIterator last, Encoder encode, int shift) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type      T;
+        typedef typename iterator_traits<RandomAccessIterator>::difference_type Distance;
+
+        while (true) {
+            const Distance n = last - first;
+            if (n < __radix_msd_cutoff) {
+                __radix_less<Encoder> comp = { encode };
+                tinySTL::__insertion_sort(first, last, comp);
+                return;
+            }
+
+            size_t count[__radix_buckets];
+            memset(count, 0, sizeof(count));
+            for (RandomAccessIterator it = first; it != last; ++it) {
+                ++count[(encode(*it) >> shift) & (__radix_buckets - 1)];
+            }
+
+            if (count[(encode(*first) >> shift) & (__radix_buckets - 1)] != size_t(n)) {
+                Distance head[__radix_buckets];
+                Distance tail[__radix_buckets];
+                Distance sum = 0;
+                for (int b = 0; b < __radix_buckets; ++b) {
+                    head[b] = sum;
+                    sum += Distance(count[b]);
+                    tail[b] = sum;
+                }
+                for (int b = 0; b < __radix_buckets; ++b) {
+                    while (head[b] < tail[b]) {
+                        T value = tinySTL::move(*(first + head[b]));
+                        size_t digit = (encode(value) >> shift) & (__radix_buckets - 1);
+                        while (digit != size_t(b)) {
+                            tinySTL::swap(value, *(first + head[digit]++));
+                            digit = (encode(value) >> shift) & (__radix_buckets - 1);
+                        }
+                        *(first + head[b]++) = tinySTL::move(value);
+                    }
+                }
+                if (shift == 0) {
+                    return;
+                }
+                Distance lo = 0;
+                for (int b = 0; b < __radix_buckets; ++b) {
+                    const Distance hi = lo + Distance(count[b]);
+                    if (hi - lo > 1) {
+                        tinySTL::__radix_sort_msd(first + lo, first + hi, encode, shift - __radix_bits);
+                    }
+                    lo = hi;
+                }
+                return;
+            }
+
+            // Every element shares this digit; move on to the next one without recursing.
+            if (shift == 0) {
+                return;
+            }
+            shift -= __radix_bits;
+        }
+    }
+
+    template <class RandomAccessIterator, class KeyFunction>
+    void radix_sort_inplace(RandomAccessIterator first, RandomAccessIterator last, KeyFunction key) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type  T;
+        typedef __radix_encoder<T, KeyFunction>                             encoder;
+        if (last - first < 2) {
+            return;
+        }
+        const encoder encode = { key };
+        tinySTL::__radix_sort_msd(first, last, encode,
+                                  int(sizeof(typename encoder::unsigned_type) * CHAR_BIT - __radix_bits));
+    }
+
+    template <class RandomAccessIterator>
+    inline void radix_sort_inplace(RandomAccessIterator first, RandomAccessIterator last) {
+        tinySTL::radix_sort_inplace(first, last, __radix_identity());
+    }
+
+    // Sorts by key(x), an integral or floating-point value. Like sort, the
+    // relative order of equal keys is not preserved.
+    template <class T, class KeyFunction>
+    void radix_sort(T* first, T* last, KeyFunction key) {
+        const size_t n = size_t(last - first);
+        if (n < 2) {
+            return;
+        }
+        if (n > __radix_inplace_threshold) {
+            tinySTL::radix_sort_inplace(first, last, key);
+            return;
+        }
+        typedef __radix_encoder<T, KeyFunction> encoder;
+        const encoder encode = { key };
+        if (tinySTL::__radix_use_comparison<encoder>(n)) {
+            const __radix_less<encoder> comp = { encode };
+            tinySTL::sort(first, last, comp);
+            return;
+        }
+        vector<T> buffer = tinySTL::__radix_scratch<T>(n);
+        tinySTL::__radix_sort_lsd(first, buffer.begin(), n, encode);
+    }
+
+    // Non-pointer ranges (e.g. deque) are gathered into contiguous storage,
+    // sorted there and copied back block by block.
+    template <class RandomAccessIterator, class KeyFunction>
+    void radix_sort(RandomAccessIterator first, RandomAccessIterator last, KeyFunction key) {
+        typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+        const size_t n = size_t(last - first);
+        if (n < 2) {
+            return;
+        }
+        if (n > __radix_inplace_threshold) {
+            tinySTL::radix_sort_inplace(first, last, key);
+            return;
+        }
+        typedef __radix_encoder<T, KeyFunction> encoder;
+        const encoder encode = { key };
+        if (tinySTL::__radix_use_comparison<encoder>(n)) {
+            const __radix_less<encoder> comp = { encode };
+            tinySTL::sort(first, last, comp);
+            return;
+        }
+        vector<T> data = tinySTL::__radix_scratch<T>(n);
+        vector<T> buffer = tinySTL::__radix_scratch<T>(n);
+        tinySTL::copy(first, last, data.begin());
+        tinySTL::__radix_sort_lsd(data.begin(), buffer.begin(), n, encode);
+        tinySTL::copy(data.begin(), data.end(), first);
+    }
+
+    template <class RandomAccessIterator>
+    inline void radix_sort(RandomAccessIterator first, RandomAccessIterator last) {
+        tinySTL::radix_sort(first, last, __radix_identity());
+    }
+}
+
+#endif // _TINY_RADIX_SORT_H_
@@ -0,0 +1,419 @@
+#ifndef _TINY_SERIALIZE_H_
+#define _TINY_SERIALIZE_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "algorithm.h"
+#include "deque.h"
+#include "vector.h"
+
+namespace tinySTL {
+    // Binary checkpoints of vector and deque contents. A file is a 64-byte
+    // header followed by the elements exactly as they sit in memory, so
+    // saving is a gathered write straight from the container's storage and
+    // loading is one read into storage sized up front, or no copy at all
+    // through mapped_array. Only trivially copyable elements qualify, and a
+    // file is only read back on a machine with the same byte order and
+    // element layout; the header records both and loading checks them.
+    // File access goes through POSIX descriptors.
+
+    struct __serial_header {
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint64_t element_size;
+        uint64_t element_align;
+        uint64_t count;
+        uint64_t header_size;
+        uint64_t reserved[2];
+    };
+
+    enum {
+        __serial_version = 1,
+        __serial_byte_order = 0x01020304,
+        // Elements start at this offset, which keeps them aligned in a
+        // mapping for any alignment up to a cache line.
+        __serial_header_size = 64,
+        __serial_iov_max = 1024,
+        // Linux transfers at most this much per read or write call.
+        __serial_max_io = 0x7ffff000
+    };
+
+    static_assert(sizeof(__serial_header) == __serial_header_size, "serialized header layout");
+
+    inline void __serial_throw(int error, const char* what) {
+        throw std::system_error(error, std::generic_category(), what);
+    }
+
+    inline void __serial_bad_file(const char* what) {
+        throw std::runtime_error(what);
+    }
+
+    template <class T>
+    inline __serial_header __serial_make_header(size_t count) {
+        __serial_header h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, "tinySTL", 8);
+        h.version = __serial_version;
+        h.byte_order = __serial_byte_order;
+        h.element_size = sizeof(T);
+        h.element_align = alignof(T);
+        h.count = count;
+        h.header_size = __serial_header_size;
+        return h;
+    }
+
+    // Checks that a header describes an array of T and returns its length.
+    template <class T>
+    size_t __serial_check_header(const __serial_header& h, uint64_t file_size) {
+        if (std::memcmp(h.magic, "tinySTL", 8) != 0 || h.header_size != __serial_header_size) {
+            tinySTL::__serial_bad_file("serialize: not a tinySTL checkpoint");
+        }
+        if (h.version != __serial_version) {
+            tinySTL::__serial_bad_file("serialize: unsupported checkpoint version");
+        }
+        if (h.byte_order != __serial_byte_order) {
+            tinySTL::__serial_bad_file("serialize: checkpoint has the other byte order");
+        }
+        if (h.element_size != sizeof(T) || h.element_align != alignof(T)) {
+            tinySTL::__serial_bad_file("serialize: element size or alignment mismatch");
+        }
+        if (h.count > (file_size - __serial_header_size) / sizeof(T)) {
+            tinySTL::__serial_bad_file("serialize: checkpoint is truncated");
+        }
+        return size_t(h.count);
+    }
+
+    // Writes or reads every byte described by iov, resuming after short
+    // transfers. The array is consumed in the process.
+    inline void __serial_transfer(int fd, struct iovec* iov, size_t count, bool writing) {
+        for (;;) {
+            while (count > 0 && iov->iov_len == 0) {
+                ++iov;
+                --count;
+            }
+            if (count == 0) {
+                return;
+            }
+            // Keep each call under the kernel's per-call limit.
+            size_t n = 0;
+            size_t bytes = 0;
+            while (n < count && n < size_t(__serial_iov_max)
+                   && bytes + iov[n].iov_len <= size_t(__serial_max_io)) {
+                bytes += iov[n].iov_len;
+                ++n;
+            }
+            if (n == 0) {
+                n = 1;
+            }
+            const ssize_t done = writing ? ::writev(fd, iov, int(n)) : ::readv(fd, iov, int(n));
+            if (done < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                tinySTL::__serial_throw(errno, writing ? "serialize: write" : "serialize: read");
+            }
+            if (done == 0 && !writing) {
+                tinySTL::__serial_bad_file("serialize: checkpoint is truncated");
+            }
+            size_t left = size_t(done);
+            while (count > 0 && left >= iov->iov_len) {
+                left -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+            if (left > 0) {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+                iov->iov_len -= left;
+            }
+        }
+    }
+
+    inline void __serial_transfer_bytes(int fd, void* data, size_t bytes, bool writing) {
+        struct iovec iov = { data, bytes };
+        tinySTL::__serial_transfer(fd, &iov, 1, writing);
+    }
+
+    // Reads and checks the header at the descriptor's current offset. For a
+    // regular file the length is checked up front; for a pipe a short
+    // stream shows up as a failed read.
+    template <class T>
+    __serial_header __serial_read_header(int fd) {
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            tinySTL::__serial_throw(errno, "serialize: stat");
+        }
+        const off_t offset = S_ISREG(st.st_mode) ? ::lseek(fd, 0, SEEK_CUR) : off_t(-1);
+        __serial_header h;
+        tinySTL::__serial_transfer_bytes(fd, &h, sizeof(h), false);
+        const uint64_t available = offset >= 0 && st.st_size >= offset ? uint64_t(st.st_size - offset) : ~uint64_t(0);
+        tinySTL::__serial_check_header<T>(h, available);
+#ifdef POSIX_FADV_SEQUENTIAL
+        if (offset >= 0) {
+            ::posix_fadvise(fd, offset, 0, POSIX_FADV_SEQUENTIAL);
+        }
+#endif
+        return h;
+    }
+
+    // Owns a descriptor for the path-based overloads.
+    class __serial_file {
+    private:
+        int fd;
+
+    public:
+        __serial_file(const char* path, int flags) : fd(::open(path, flags | O_CLOEXEC, 0644)) {
+            if (fd < 0) {
+                tinySTL::__serial_throw(errno, "serialize: cannot open file");
+            }
+        }
+
+        ~__serial_file() {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+
+        __serial_file(const __serial_file&) = delete;
+        __serial_file& operator=(const __serial_file&) = delete;
+
+        int get() const { return fd; }
+
+        // Reports a failed close, which is where some file systems report write errors.
+        void close() {
+            const int f = fd;
+            fd = -1;
+            if (::close(f) != 0) {
+                tinySTL::__serial_throw(errno, "serialize: close");
+            }
+        }
+    };
+
+    // Writes the header and the elements at the descriptor's current offset,
+    // in one writev call where the kernel allows.
+    template <class T, class Alloc>
+    void serialize(int fd, const vector<T, Alloc>& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "serialize needs trivially copyable elements");
+        __serial_header h = tinySTL::__serial_make_header<T>(v.size());
+        struct iovec iov[2] = {
+            { &h, sizeof(h) },
+            { const_cast<T*>(v.begin()), v.size() * sizeof(T) }
+        };
+        tinySTL::__serial_transfer(fd, iov, 2, true);
+    }
+
+    // Gathers the deque's blocks into writev calls of up to IOV_MAX buffers.
+    template <class T, class Alloc, size_t BufSize>
+    void serialize(int fd, const deque<T, Alloc, BufSize>& d) {
+        static_assert(std::is_trivially_copyable<T>::value, "serialize needs trivially copyable elements");
+        __serial_header h = tinySTL::__serial_make_header<T>(d.size());
+        vector<struct iovec> iov;
+        struct iovec head = { &h, sizeof(h) };
+        iov.push_back(head);
+        struct gather {
+            vector<struct iovec>& iov;
+            void operator()(const T* first, const T* last) {
+                if (first != last) {
+                    struct iovec block = { const_cast<T*>(first), size_t(last - first) * sizeof(T) };
+                    iov.push_back(block);
+                }
+            }
+        };
+        tinySTL::__for_each_segment(d.begin(), d.end(), gather{iov});
+        tinySTL::__serial_transfer(fd, iov.begin(), iov.size(), true);
+    }
+
+    // Replaces v's contents with the checkpoint at the descriptor's current
+    // offset: one allocation of the exact size, then reads straight into it.
+    // v is left empty if the read fails, as its elements were never set.
+    template <class T, class Alloc>
+    void deserialize(int fd, vector<T, Alloc>& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "serialize needs trivially copyable elements");
+        const __serial_header h = tinySTL::__serial_read_header<T>(fd);
+        v.clear();
+        v.resize_default_init(size_t(h.count));
+        try {
+            tinySTL::__serial_transfer_bytes(fd, v.begin(), v.size() * sizeof(T), false);
+        }
+        catch (...) {
+            v.clear();
+            throw;
+        }
+    }
+
+    // Sizes the deque first, then scatters the elements into its blocks.
+    // Like the vector overload, leaves d empty if the read fails.
+    template <class T, class Alloc, size_t BufSize>
+    void deserialize(int fd, deque<T, Alloc, BufSize>& d) {
+        static_assert(std::is_trivially_copyable<T>::value, "serialize needs trivially copyable elements");
+        const __serial_header h = tinySTL::__serial_read_header<T>(fd);
+        d.clear();
+        d.resize_default_init(size_t(h.count));
+        struct scatter {
+            vector<struct iovec>& iov;
+            void operator()(T* first, T* last) {
+                if (first != last) {
+                    struct iovec block = { first, size_t(last - first) * sizeof(T) };
+                    iov.push_back(block);
+                }
+            }
+        };
+        try {
+            vector<struct iovec> iov;
+            tinySTL::__for_each_segment(d.begin(), d.end(), scatter{iov});
+            tinySTL::__serial_transfer(fd, iov.begin(), iov.size(), false);
+        }
+        catch (...) {
+            d.clear();
+            throw;
+        }
+    }
+
+    // Writes a checkpoint to path, replacing any file there.
+    template <class Container>
+    void serialize(const char* path, const Container& c) {
+        __serial_file f(path, O_WRONLY | O_CREAT | O_TRUNC);
+        tinySTL::serialize(f.get(), c);
+        f.close();
+    }
+
+    template <class Container>
+    void deserialize(const char* path, Container& c) {
+        __serial_file f(path, O_RDONLY);
+        tinySTL::deserialize(f.get(), c);
+    }
+
+    // A read-only array over a checkpoint file mapped into memory. Opening
+    // it copies nothing: pages are read in from the page cache or the disk
+    // as they are first touched, and are shared with every other process
+    // mapping the same file. The file must not be truncated while mapped.
+    template <class T>
+    class mapped_array {
+    public:
+        typedef T                   value_type;
+        typedef const T*            pointer;
+        typedef const T*            const_pointer;
+        typedef const T&            reference;
+        typedef const T&            const_reference;
+        typedef const T*            iterator;
+        typedef const T*            const_iterator;
+        typedef size_t              size_type;
+        typedef ptrdiff_t           difference_type;
+
+        static_assert(std::is_trivially_copyable<T>::value, "serialize needs trivially copyable elements");
+        static_assert(alignof(T) <= __serial_header_size, "mapped elements would be misaligned");
+
+    protected:
+        void* base;
+        size_t mapped_bytes;
+        const T* elements;
+        size_t count;
+
+        void unmap() {
+            if (base) {
+                ::munmap(base, mapped_bytes);
+            }
+            base = nullptr;
+            mapped_bytes = 0;
+            elements = nullptr;
+            count = 0;
+        }
+
+    public:
+        mapped_array() : base(nullptr), mapped_bytes(0), elements(nullptr), count(0) {}
+
+        // With populate, the whole file is read in up front, which suits a
+        // caller that will touch all of it anyway.
+        explicit mapped_array(const char* path, bool populate = false)
+            : base(nullptr), mapped_bytes(0), elements(nullptr), count(0) {
+            open(path, populate);
+        }
+
+        ~mapped_array() { unmap(); }
+
+        mapped_array(const mapped_array&) = delete;
+        mapped_array& operator=(const mapped_array&) = delete;
+
+        mapped_array(mapped_array&& x) noexcept
+            : base(x.base), mapped_bytes(x.mapped_bytes), elements(x.elements), count(x.count) {
+            x.base = nullptr;
+            x.mapped_bytes = 0;
+            x.elements = nullptr;
+            x.count = 0;
+        }
+
+        mapped_array& operator=(mapped_array&& x) noexcept {
+            if (this != &x) {
+                unmap();
+                swap(x);
+            }
+            return *this;
+        }
+
+        void open(const char* path, bool populate = false) {
+            unmap();
+            __serial_file f(path, O_RDONLY);
+            struct stat st;
+            if (::fstat(f.get(), &st) != 0) {
+                tinySTL::__serial_throw(errno, "serialize: stat");
+            }
+            if (uint64_t(st.st_size) < uint64_t(__serial_header_size)) {
+                tinySTL::__serial_bad_file("serialize: not a tinySTL checkpoint");
+            }
+            int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+            if (populate) {
+                flags |= MAP_POPULATE;
+            }
+#endif
+            void* p = ::mmap(nullptr, size_t(st.st_size), PROT_READ, flags, f.get(), 0);
+            if (p == MAP_FAILED) {
+                tinySTL::__serial_throw(errno, "serialize: mmap");
+            }
+            base = p;
+            mapped_bytes = size_t(st.st_size);
+            __serial_header h;
+            std::memcpy(&h, p, sizeof(h));
+            try {
+                count = tinySTL::__serial_check_header<T>(h, uint64_t(st.st_size));
+            }
+            catch (...) {
+                unmap();
+                throw;
+            }
+            elements = reinterpret_cast<const T*>(static_cast<const char*>(p) + __serial_header_size);
+        }
+
+        void close() { unmap(); }
+
+        bool is_open() const { return base != nullptr; }
+        const_iterator begin() const { return elements; }
+        const_iterator end() const { return elements + count; }
+        const_pointer data() const { return elements; }
+        size_type size() const { return count; }
+        bool empty() const { return count == 0; }
+        const_reference operator[](size_type n) const { return elements[n]; }
+        const_reference front() const { return elements[0]; }
+        const_reference back() const { return elements[count - 1]; }
+
+        void swap(mapped_array& x) {
+            tinySTL::swap(base, x.base);
+            tinySTL::swap(mapped_bytes, x.mapped_bytes);
+            tinySTL::swap(elements, x.elements);
+            tinySTL::swap(count, x.count);
+        }
+    };
+}
+
+#endif // _TINY_SERIALIZE_H_
@@ -0,0 +1,349 @@
+#ifndef _TINY_SIMD_H_
+#define _TINY_SIMD_H_
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define _TINY_SIMD_X86 1
+#define _TINY_SIMD_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace tinySTL {
+    // Lane types the kernels below accept: every arithmetic type that fits a
+    // vector lane. min/max and sums are restricted to integers, whose results
+    // don't depend on evaluation order.
+    template <class T>
+    struct __simd_eligible : std::integral_constant<bool,
+        std::is_arithmetic<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= 8> {};
+
+    template <class T>
+    struct __simd_integral_eligible : std::integral_constant<bool,
+        __simd_eligible<T>::value && std::is_integral<T>::value> {};
+
+    template <class T>
+    const T* __scalar_find(const T* first, const T* last, T value) {
+        while (first != last && !(*first == value)) {
+            ++first;
+        }
+        return first;
+    }
+
+    template <class T>
+    size_t __scalar_count(const T* first, const T* last, T value) {
+        size_t n = 0;
+        for (; first != last; ++first) {
+            n += *first == value;
+        }
+        return n;
+    }
+
+    template <class T>
+    size_t __scalar_mismatch(const T* first1, size_t n, const T* first2) {
+        size_t i = 0;
+        while (i < n && first1[i] == first2[i]) {
+            ++i;
+        }
+        return i;
+    }
+
+    template <class T>
+    const T* __scalar_min_element(const T* first, const T* last) {
+        const T* result = first;
+        while (++first != last) {
+            if (*first < *result) {
+                result = first;
+            }
+        }
+        return result;
+    }
+
+    template <class T>
+    const T* __scalar_max_element(const T* first, const T* last) {
+        const T* result = first;
+        while (++first != last) {
+            if (*result < *first) {
+                result = first;
+            }
+        }
+        return result;
+    }
+
+    template <class T>
+    T __scalar_accumulate(const T* first, const T* last, T init) {
+        typedef typename std::make_unsigned<T>::type U;
+        U total = U(init);
+        for (; first != last; ++first) {
+            total = U(total + U(*first));
+        }
+        return T(total);
+    }
+
+#ifdef _TINY_SIMD_X86
+    enum __simd_level { __simd_none, __simd_sse42, __simd_avx2 };
+
+    inline int __simd_detect() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return __simd_avx2;
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return __simd_sse42;
+        }
+        return __simd_none;
+    }
+
+    inline int __simd_level_supported() {
+        static const int level = __simd_detect();
+        return level;
+    }
+
+    // The kernels are written once against GCC vector extensions and always
+    // inlined into the target("avx2") / target("sse4.2") entry points below,
+    // so each entry point gets its own instruction selection.
+    template <class T, size_t Bytes>
+    struct __simd_vector {
+        typedef T                  type __attribute__((vector_size(Bytes)));
+        typedef unsigned long long mask __attribute__((vector_size(Bytes)));
+        enum { lanes = Bytes / sizeof(T), words = Bytes / sizeof(unsigned long long) };
+    };
+
+    template <size_t Bytes, class T>
+    _TINY_SIMD_INLINE const T* __simd_find_kernel(const T* first, const T* last, T value) {
+        typedef __simd_vector<T, Bytes>  simd;
+        typedef typename simd::type      vec;
+        typedef typename simd::mask      mask;
+        const vec needle = vec() + value;
+        for (; size_t(last - first) >= size_t(simd::lanes); first += simd::lanes) {
+            vec v;
+            memcpy(&v, first, Bytes);
+            const mask m = (mask)(v == needle);
+            unsigned long long any = 0;
+            for (int w = 0; w < simd::words; ++w) {
+                any |= m[w];
+            }
+            if (any) {
+                break;
+            }
+        }
+        return tinySTL::__scalar_find(first, last, value);
+    }
+
+    template <size_t Bytes, class T>
+    _TINY_SIMD_INLINE size_t __simd_count_kernel(const T* first, const T* last, T value) {
+        typedef __simd_vector<T, Bytes>                                   simd;
+        typedef typename simd::type                                       vec;
+        typedef decltype(vec() == vec())                                  lane_count;
+        // Lane counters are as wide as T, so drain them before they can overflow.
+        const size_t flush = sizeof(T) == 1 ? 0x7f : sizeof(T) == 2 ? 0x7fff : 0x7fffffff;
+        const vec needle = vec() + value;
+        size_t n = 0;
+        while (size_t(last - first) >= size_t(simd::lanes)) {
+            lane_count counts = lane_count();
+            for (size_t k = 0; k < flush && size_t(last - first) >= size_t(simd::lanes); ++k) {
+                vec v;
+                memcpy(&v, first, Bytes);
+                counts -= v == needle;
+                first += simd::lanes;
+            }
+            for (int i = 0; i < simd::lanes; ++i) {
+                n += size_t(counts[i]);
+            }
+        }
+        return n + tinySTL::__scalar_count(first, last, value);
+    }
+
+    template <size_t Bytes, class T>
+    _TINY_SIMD_INLINE size_t __simd_mismatch_kernel(const T* first1, size_t n, const T* first2) {
+        typedef __simd_vector<T, Bytes>  simd;
+        typedef typename simd::type      vec;
+        typedef typename simd::mask      mask;
+        size_t i = 0;
+        for (; n - i >= size_t(simd::lanes); i += simd::lanes) {
+            vec a, b;
+            memcpy(&a, first1 + i, Bytes);
+            memcpy(&b, first2 + i, Bytes);
+            const mask m = (mask)(a != b);
+            unsigned long long any = 0;
+            for (int w = 0; w < simd::words; ++w) {
+                any |= m[w];
+            }
+            if (any) {
+                break;
+            }
+        }
+        return i + tinySTL::__scalar_mismatch(first1 + i, n - i, first2 + i);
+    }
+
+    // Finds the extreme value lane-wise, then returns its first occurrence.
+    template <size_t Bytes, bool Max, class T>
+    _TINY_SIMD_INLINE const T* __simd_extreme_kernel(const T* first, const T* last) {
+        typedef __simd_vector<T, Bytes>  simd;
+        typedef typename simd::type      vec;
+        const T* p = first;
+        vec best = vec() + *first;
+        for (; size_t(last - p) >= size_t(simd::lanes); p += simd::lanes) {
+            vec v;
+            memcpy(&v, p, Bytes);
+            best = (Max ? best < v : v < best) ? v : best;
+        }
+        T value = best[0];
+        for (int i = 1; i < simd::lanes; ++i) {
+            if (Max ? value < best[i] : best[i] < value) {
+                value = best[i];
+            }
+        }
+        for (; p != last; ++p) {
+            if (Max ? value < *p : *p < value) {
+                value = *p;
+            }
+        }
+        return tinySTL::__simd_find_kernel<Bytes>(first, last, value);
+    }
+
+    // Lanes add in the unsigned counterpart of T so overflow wraps instead of being undefined.
+    template <size_t Bytes, class T>
+    _TINY_SIMD_INLINE T __simd_accumulate_kernel(const T* first, const T* last, T init) {
+        typedef typename std::make_unsigned<T>::type  U;
+        typedef __simd_vector<U, Bytes>               simd;
+        typedef typename simd::type                   vec;
+        vec sum = vec();
+        for (; size_t(last - first) >= size_t(simd::lanes); first += simd::lanes) {
+            vec v;
+            memcpy(&v, first, Bytes);
+            sum += v;
+        }
+        U total = U(init);
+        for (int i = 0; i < simd::lanes; ++i) {
+            total = U(total + sum[i]);
+        }
+        return tinySTL::__scalar_accumulate(first, last, T(total));
+    }
+
+    template <class T> __attribute__((target("avx2")))
+    const T* __simd_find_avx2(const T* first, const T* last, T value) {
+        return tinySTL::__simd_find_kernel<32>(first, last, value);
+    }
+
+    template <class T> __attribute__((target("sse4.2")))
+    const T* __simd_find_sse42(const T* first, const T* last, T value) {
+        return tinySTL::__simd_find_kernel<16>(first, last, value);
+    }
+
+    template <class T> __attribute__((target("avx2")))
+    size_t __simd_count_avx2(const T* first, const T* last, T value) {
+        return tinySTL::__simd_count_kernel<32>(first, last, value);
+    }
+
+    template <class T> __attribute__((target("sse4.2")))
+    size_t __simd_count_sse42(const T* first, const T* last, T value) {
+        return tinySTL::__simd_count_kernel<16>(first, last, value);
+    }
+
+    template <class T> __attribute__((target("avx2")))
+    size_t __simd_mismatch_avx2(const T* first1, size_t n, const T* first2) {
+        return tinySTL::__simd_mismatch_kernel<32>(first1, n, first2);
+    }
+
+    template <class T> __attribute__((target("sse4.2")))
+    size_t __simd_mismatch_sse42(const T* first1, size_t n, const T* first2) {
+        return tinySTL::__simd_mismatch_kernel<16>(first1, n, first2);
+    }
+
+    template <bool Max, class T> __attribute__((target("avx2")))
+    const T* __simd_extreme_avx2(const T* first, const T* last) {
+        return tinySTL::__simd_extreme_kernel<32, Max>(first, last);
+    }
+
+    template <bool Max, class T> __attribute__((target("sse4.2")))
+    const T* __simd_extreme_sse42(const T* first, const T* last) {
+        return tinySTL::__simd_extreme_kernel<16, Max>(first, last);
+    }
+
+    template <class T> __attribute__((target("avx2")))
+    T __simd_accumulate_avx2(const T* first, const T* last, T init) {
+        return tinySTL::__simd_accumulate_kernel<32>(first, last, init);
+    }
+
+    template <class T> __attribute__((target("sse4.2")))
+    T __simd_accumulate_sse42(const T* first, const T* last, T init) {
+        return tinySTL::__simd_accumulate_kernel<16>(first, last, init);
+    }
+#endif
+
+    template <class T>
+    const T* __simd_find(const T* first, const T* last, T value) {
+#ifdef _TINY_SIMD_X86
+        switch (tinySTL::__simd_level_supported()) {
+        case __simd_avx2:  return tinySTL::__simd_find_avx2(first, last, value);
+        case __simd_sse42: return tinySTL::__simd_find_sse42(first, last, value);
+        }
+#endif
+        return tinySTL::__scalar_find(first, last, value);
+    }
+
+    template <class T>
+    size_t __simd_count(const T* first, const T* last, T value) {
+#ifdef _TINY_SIMD_X86
+        switch (tinySTL::__simd_level_supported()) {
+        case __simd_avx2:  return tinySTL::__simd_count_avx2(first, last, value);
+        case __simd_sse42: return tinySTL::__simd_count_sse42(first, last, value);
+        }
+#endif
+        return tinySTL::__scalar_count(first, last, value);
+    }
+
+    // Index of the first position where the two ranges of length n differ, or n.
+    template <class T>
+    size_t __simd_mismatch(const T* first1, size_t n, const T* first2) {
+#ifdef _TINY_SIMD_X86
+        switch (tinySTL::__simd_level_supported()) {
+        case __simd_avx2:  return tinySTL::__simd_mismatch_avx2(first1, n, first2);
+        case __simd_sse42: return tinySTL::__simd_mismatch_sse42(first1, n, first2);
+        }
+#endif
+        return tinySTL::__scalar_mismatch(first1, n, first2);
+    }
+
+    template <class T>
+    const T* __simd_min_element(const T* first, const T* last) {
+        if (first == last) {
+            return last;
+        }
+#ifdef _TINY_SIMD_X86
+        switch (tinySTL::__simd_level_supported()) {
+        case __simd_avx2:  return tinySTL::__simd_extreme_avx2<false>(first, last);
+        case __simd_sse42: return tinySTL::__simd_extreme_sse42<false>(first, last);
+        }
+#endif
+        return tinySTL::__scalar_min_element(first, last);
+    }
+
+    template <class T>
+    const T* __simd_max_element(const T* first, const T* last) {
+        if (first == last) {
+            return last;
+        }
+#ifdef _TINY_SIMD_X86
+        switch (tinySTL::__simd_level_supported()) {
+        case __simd_avx2:  return tinySTL::__simd_extreme_avx2<true>(first, last);
+        case __simd_sse42: return tinySTL::__simd_extreme_sse42<true>(first, last);
+        }
+#endif
+        return tinySTL::__scalar_max_element(first, last);
+    }
+
+    template <class T>
+    T __simd_accumulate(const T* first, const T* last, T init) {
+#ifdef _TINY_SIMD_X86
+        switch (tinySTL::__simd_level_supported()) {
+        case __simd_avx2:  return tinySTL::__simd_accumulate_avx2(first, last, init);
+        case __simd_sse42: return tinySTL::__simd_accumulate_sse42(first, last, init);
+        }
+#endif
+        return tinySTL::__scalar_accumulate(first, last, init);
+    }
+}
+
+#endif // _TINY_SIMD_H_
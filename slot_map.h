@@ -0,0 +1,208 @@
+#ifndef _TINY_SLOT_MAP_H_
+#define _TINY_SLOT_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include "algorithm.h"
+#include "vector.h"
+
+namespace tinySTL {
+    // Names an element of a slot_map. The generation changes each time the
+    // slot is freed, so a handle to an erased element stays detectably
+    // stale after the slot is reused. A default handle is never valid.
+    struct slot_map_handle {
+        uint32_t index;
+        uint32_t generation;
+
+        slot_map_handle() : index(0), generation(0) {}
+        slot_map_handle(uint32_t i, uint32_t g) : index(i), generation(g) {}
+
+        bool operator==(const slot_map_handle& x) const { return index == x.index && generation == x.generation; }
+        bool operator!=(const slot_map_handle& x) const { return !(*this == x); }
+    };
+
+    // Values packed in a vector, addressed through handles that survive
+    // other elements' erasure. Each handle picks a slot, and the slot holds
+    // the value's current position. Erasing moves the last value into the
+    // hole and points its slot there, so insert, erase and lookup are O(1),
+    // and iteration walks a plain array in no particular order. Freed slots
+    // go on a free list for reuse.
+    template <class T>
+    class slot_map {
+    public:
+        typedef T                   value_type;
+        typedef T*                  pointer;
+        typedef const T*            const_pointer;
+        typedef T&                  reference;
+        typedef const T&            const_reference;
+        typedef T*                  iterator;
+        typedef const T*            const_iterator;
+        typedef size_t              size_type;
+        typedef ptrdiff_t           difference_type;
+        typedef slot_map_handle     handle;
+
+    private:
+        // While live, index is the value's position; while free, the next
+        // free slot.
+        struct slot {
+            uint32_t index;
+            uint32_t generation;
+        };
+
+        enum : uint32_t { npos = 0xffffffffu };
+
+        vector<T> values;
+        vector<uint32_t> owners;        // owners[i] is the slot of values[i]
+        vector<slot> slots;
+        uint32_t free_head;
+
+        static uint32_t next_generation(uint32_t g) { return g + 1 == 0 ? 1 : g + 1; }
+
+        const slot* live_slot(handle h) const {
+            if (h.index >= slots.size()) {
+                return nullptr;
+            }
+            const slot& s = slots[h.index];
+            return s.generation == h.generation ? &s : nullptr;
+        }
+
+        void erase_at(size_type i) {
+            const uint32_t s = owners[i];
+            const size_type last = values.size() - 1;
+            if (i != last) {
+                values[i] = std::move(values[last]);
+                owners[i] = owners[last];
+                slots[owners[i]].index = uint32_t(i);
+            }
+            values.pop_back();
+            owners.pop_back();
+            slots[s].generation = next_generation(slots[s].generation);
+            slots[s].index = free_head;
+            free_head = s;
+        }
+
+    public:
+        slot_map() : free_head(npos) {}
+
+        iterator begin() { return values.begin(); }
+        iterator end() { return values.end(); }
+        const_iterator begin() const { return values.begin(); }
+        const_iterator end() const { return values.end(); }
+        size_type size() const { return values.size(); }
+        bool empty() const { return values.empty(); }
+        size_type capacity() const { return values.capacity(); }
+        size_type max_size() const { return size_type(npos) - 1; }
+
+        void reserve(size_type n) {
+            values.reserve(n);
+            owners.reserve(n);
+            slots.reserve(n);
+        }
+
+        template <class... Args>
+        handle emplace(Args&&... args) {
+            if (values.size() >= max_size()) {
+                throw std::length_error("slot_map::emplace");
+            }
+            if (free_head == npos) {
+                slot fresh = { npos, 1 };
+                slots.push_back(fresh);
+                free_head = uint32_t(slots.size() - 1);
+            }
+            const uint32_t s = free_head;
+            owners.push_back(s);
+            try {
+                values.emplace_back(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                owners.pop_back();
+                throw;
+            }
+            free_head = slots[s].index;
+            slots[s].index = uint32_t(values.size() - 1);
+            return handle(s, slots[s].generation);
+        }
+
+        handle insert(const value_type& x) { return emplace(x); }
+        handle insert(value_type&& x) { return emplace(std::move(x)); }
+
+        bool contains(handle h) const { return live_slot(h) != nullptr; }
+
+        // Null if h is stale.
+        pointer find(handle h) {
+            const slot* s = live_slot(h);
+            return s ? values.begin() + s->index : nullptr;
+        }
+
+        const_pointer find(handle h) const {
+            const slot* s = live_slot(h);
+            return s ? values.begin() + s->index : nullptr;
+        }
+
+        reference operator[](handle h) { return values[slots[h.index].index]; }
+        const_reference operator[](handle h) const { return values[slots[h.index].index]; }
+
+        reference at(handle h) {
+            pointer p = find(h);
+            if (!p) {
+                throw std::out_of_range("slot_map::at");
+            }
+            return *p;
+        }
+
+        const_reference at(handle h) const {
+            const_pointer p = find(h);
+            if (!p) {
+                throw std::out_of_range("slot_map::at");
+            }
+            return *p;
+        }
+
+        // The handle of the element at position.
+        handle handle_of(const_iterator position) const {
+            const uint32_t s = owners[size_type(position - values.begin())];
+            return handle(s, slots[s].generation);
+        }
+
+        // Returns false if h is stale.
+        bool erase(handle h) {
+            const slot* s = live_slot(h);
+            if (!s) {
+                return false;
+            }
+            erase_at(s->index);
+            return true;
+        }
+
+        // The last element moves into position, which is returned; so erasing
+        // while iterating only advances when nothing was erased.
+        iterator erase(const_iterator position) {
+            const size_type i = size_type(position - values.begin());
+            erase_at(i);
+            return values.begin() + i;
+        }
+
+        // Every outstanding handle goes stale.
+        void clear() {
+            for (size_type i = 0; i < owners.size(); ++i) {
+                slot& s = slots[owners[i]];
+                s.generation = next_generation(s.generation);
+                s.index = free_head;
+                free_head = owners[i];
+            }
+            values.clear();
+            owners.clear();
+        }
+
+        void swap(slot_map& x) {
+            tinySTL::swap(values, x.values);
+            tinySTL::swap(owners, x.owners);
+            tinySTL::swap(slots, x.slots);
+            tinySTL::swap(free_head, x.free_head);
+        }
+    };
+}
+
+#endif // _TINY_SLOT_MAP_H_
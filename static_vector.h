@@ -0,0 +1,298 @@
+#ifndef _TINY_STATIC_VECTOR_H_
+#define _TINY_STATIC_VECTOR_H_
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "algorithm.h"
+
+namespace tinySTL {
+    // The narrowest unsigned type that can count to N.
+    template <size_t N>
+    struct __static_vector_length {
+        typedef typename std::conditional<N <= 0xffu, unsigned char,
+                typename std::conditional<N <= 0xffffu, unsigned short,
+                typename std::conditional<N <= 0xffffffffu, unsigned int, size_t>::type>::type>::type type;
+    };
+
+    inline void __static_vector_overflow() {
+        throw std::length_error("static_vector: capacity exceeded");
+    }
+
+    // Storage and lifetime for static_vector. For trivial T the elements are
+    // a plain array: C++17 constant evaluation can't leave storage
+    // uninitialized, so the array is value-initialized up front, and in
+    // exchange every operation, and the container itself, is constexpr.
+    template <class T, size_t N, bool = std::is_trivial<T>::value>
+    class __static_vector_base {
+    protected:
+        typedef typename __static_vector_length<N>::type length_type;
+
+        T elems[N ? N : 1];
+        length_type length;
+
+        constexpr __static_vector_base() : elems(), length(0) {}
+
+        constexpr T* ptr() { return elems; }
+        constexpr const T* ptr() const { return elems; }
+
+        template <class... Args>
+        constexpr void construct(size_t i, Args&&... args) { elems[i] = T(std::forward<Args>(args)...); }
+        constexpr void destroy(size_t) {}
+    };
+
+    // Other types live in raw aligned bytes and are built with placement new.
+    template <class T, size_t N>
+    class __static_vector_base<T, N, false> {
+    protected:
+        typedef typename __static_vector_length<N>::type length_type;
+
+        alignas(T) unsigned char buf[sizeof(T) * (N ? N : 1)];
+        length_type length;
+
+        T* ptr() { return reinterpret_cast<T*>(buf); }
+        const T* ptr() const { return reinterpret_cast<const T*>(buf); }
+
+        template <class... Args>
+        void construct(size_t i, Args&&... args) {
+            ::new (static_cast<void*>(ptr() + i)) T(std::forward<Args>(args)...);
+        }
+        void destroy(size_t i) { ptr()[i].~T(); }
+
+        void destroy_from(size_t n) {
+            while (length > n) {
+                destroy(--length);
+            }
+        }
+
+        // Copies or moves an element of x, depending on how x was passed.
+        static const T& element(const __static_vector_base& x, size_t i) { return x.ptr()[i]; }
+        static T&& element(__static_vector_base&& x, size_t i) { return std::move(x.ptr()[i]); }
+
+        template <class Base>
+        void construct_from(Base&& x) {
+            try {
+                for (; length < x.length; ++length) {
+                    construct(length, element(std::forward<Base>(x), length));
+                }
+            }
+            catch (...) {
+                destroy_from(0);
+                throw;
+            }
+        }
+
+        template <class Base>
+        void assign_from(Base&& x) {
+            const size_t common = length < x.length ? length : x.length;
+            for (size_t i = 0; i < common; ++i) {
+                ptr()[i] = element(std::forward<Base>(x), i);
+            }
+            destroy_from(x.length);
+            for (; length < x.length; ++length) {
+                construct(length, element(std::forward<Base>(x), length));
+            }
+        }
+
+        __static_vector_base() : length(0) {}
+        __static_vector_base(const __static_vector_base& x) : length(0) { construct_from(x); }
+        __static_vector_base(__static_vector_base&& x) noexcept(std::is_nothrow_move_constructible<T>::value)
+            : length(0) { construct_from(std::move(x)); }
+        ~__static_vector_base() { destroy_from(0); }
+
+        __static_vector_base& operator=(const __static_vector_base& x) {
+            if (this != &x) {
+                assign_from(x);
+            }
+            return *this;
+        }
+
+        __static_vector_base& operator=(__static_vector_base&& x) noexcept(std::is_nothrow_move_assignable<T>::value
+                                                                          && std::is_nothrow_move_constructible<T>::value) {
+            if (this != &x) {
+                assign_from(std::move(x));
+            }
+            return *this;
+        }
+    };
+
+    // A vector with room for N elements inside the object: it never
+    // allocates, and going past N throws std::length_error (or, for
+    // try_push_back, returns false). The size is stored in the narrowest
+    // integer that can count to N, so static_vector<char, 15> is 16 bytes.
+    template <class T, size_t N>
+    class static_vector : public __static_vector_base<T, N> {
+    public:
+        typedef T                   value_type;
+        typedef value_type*         pointer;
+        typedef value_type*         iterator;
+        typedef value_type&         reference;
+        typedef size_t              size_type;
+        typedef ptrdiff_t           difference_type;
+        typedef const value_type*   const_pointer;
+        typedef const value_type&   const_reference;
+        typedef const value_type*   const_iterator;
+
+    public:
+        constexpr iterator begin() { return this->ptr(); }
+        constexpr const_iterator begin() const { return this->ptr(); }
+        constexpr iterator end() { return this->ptr() + this->length; }
+        constexpr const_iterator end() const { return this->ptr() + this->length; }
+        constexpr pointer data() { return this->ptr(); }
+        constexpr const_pointer data() const { return this->ptr(); }
+        constexpr size_type size() const { return this->length; }
+        static constexpr size_type capacity() { return N; }
+        static constexpr size_type max_size() { return N; }
+        constexpr bool empty() const { return this->length == 0; }
+        constexpr bool full() const { return this->length == N; }
+        constexpr reference operator[](size_type n) { return this->ptr()[n]; }
+        constexpr const_reference operator[](size_type n) const { return this->ptr()[n]; }
+        constexpr reference front() { return this->ptr()[0]; }
+        constexpr const_reference front() const { return this->ptr()[0]; }
+        constexpr reference back() { return this->ptr()[this->length - 1]; }
+        constexpr const_reference back() const { return this->ptr()[this->length - 1]; }
+
+        constexpr static_vector() {}
+        constexpr static_vector(size_type n, const value_type& value) { resize(n, value); }
+        constexpr explicit static_vector(size_type n) { resize(n); }
+        constexpr static_vector(std::initializer_list<value_type> values) {
+            if (values.size() > N) {
+                __static_vector_overflow();
+            }
+            for (const value_type* p = values.begin(); p != values.end(); ++p) {
+                this->construct(this->length, *p);
+                ++this->length;
+            }
+        }
+
+        constexpr void push_back(const value_type& x) { emplace_back(x); }
+        constexpr void push_back(value_type&& x) { emplace_back(std::move(x)); }
+
+        template <class... Args>
+        constexpr reference emplace_back(Args&&... args) {
+            if (full()) {
+                __static_vector_overflow();
+            }
+            this->construct(this->length, std::forward<Args>(args)...);
+            return this->ptr()[this->length++];
+        }
+
+        // The non-throwing form for callers that treat a full vector as bad input.
+        constexpr bool try_push_back(const value_type& x) {
+            if (full()) {
+                return false;
+            }
+            this->construct(this->length, x);
+            ++this->length;
+            return true;
+        }
+
+        constexpr bool try_push_back(value_type&& x) {
+            if (full()) {
+                return false;
+            }
+            this->construct(this->length, std::move(x));
+            ++this->length;
+            return true;
+        }
+
+        template <class... Args>
+        constexpr iterator emplace(const_iterator position, Args&&... args) {
+            const size_type index = size_type(position - begin());
+            if (full()) {
+                __static_vector_overflow();
+            }
+            if (index == this->length) {
+                emplace_back(std::forward<Args>(args)...);
+                return begin() + index;
+            }
+            // Build the value first: args may refer to an element that is about to move.
+            value_type x(std::forward<Args>(args)...);
+            pointer p = this->ptr();
+            this->construct(this->length, std::move(p[this->length - 1]));
+            ++this->length;
+            for (size_type i = this->length - 2; i > index; --i) {
+                p[i] = std::move(p[i - 1]);
+            }
+            p[index] = std::move(x);
+            return begin() + index;
+        }
+
+        constexpr iterator insert(const_iterator position, const value_type& x) { return emplace(position, x); }
+        constexpr iterator insert(const_iterator position, value_type&& x) { return emplace(position, std::move(x)); }
+
+        constexpr void pop_back() {
+            --this->length;
+            this->destroy(this->length);
+        }
+
+        constexpr iterator erase(const_iterator position) { return erase(position, position + 1); }
+
+        constexpr iterator erase(const_iterator first, const_iterator last) {
+            const size_type from = size_type(first - begin());
+            const size_type to = size_type(last - begin());
+            if (from != to) {
+                pointer p = this->ptr();
+                size_type i = from;
+                for (size_type j = to; j < this->length; ++i, ++j) {
+                    p[i] = std::move(p[j]);
+                }
+                while (this->length > i) {
+                    pop_back();
+                }
+            }
+            return begin() + from;
+        }
+
+        constexpr void resize(size_type new_size, const value_type& x) {
+            if (new_size > N) {
+                __static_vector_overflow();
+            }
+            while (this->length > new_size) {
+                pop_back();
+            }
+            for (; this->length < new_size; ++this->length) {
+                this->construct(this->length, x);
+            }
+        }
+
+        constexpr void resize(size_type new_size) {
+            if (new_size > N) {
+                __static_vector_overflow();
+            }
+            while (this->length > new_size) {
+                pop_back();
+            }
+            for (; this->length < new_size; ++this->length) {
+                this->construct(this->length);
+            }
+        }
+
+        constexpr void clear() {
+            while (this->length > 0) {
+                pop_back();
+            }
+        }
+
+        void swap(static_vector& x) {
+            static_vector& shorter = size() < x.size() ? *this : x;
+            static_vector& longer = size() < x.size() ? x : *this;
+            const size_type common = shorter.size();
+            for (size_type i = 0; i < common; ++i) {
+                tinySTL::swap(shorter[i], longer[i]);
+            }
+            for (size_type i = common; i < longer.size(); ++i) {
+                shorter.construct(i, std::move(longer[i]));
+                ++shorter.length;
+            }
+            while (longer.size() > common) {
+                longer.pop_back();
+            }
+        }
+    };
+}
+
+#endif // _TINY_STATIC_VECTOR_H_
@@ -0,0 +1,316 @@
+#ifndef _TINY_STRING_VIEW_H_
+#define _TINY_STRING_VIEW_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include "functional.h"
+#include "simd.h"
+
+namespace tinySTL {
+    template <class CharT>
+    inline size_t __char_length(const CharT* s) {
+        const CharT* p = s;
+        while (*p != CharT()) {
+            ++p;
+        }
+        return size_t(p - s);
+    }
+
+    inline size_t __char_length(const char* s) { return std::strlen(s); }
+
+    // Characters order by their unsigned value, as std::char_traits does.
+    template <class CharT>
+    inline bool __char_less(CharT a, CharT b) {
+        typedef typename std::make_unsigned<CharT>::type U;
+        return U(a) < U(b);
+    }
+
+    // Character search and comparison go through the simd.h kernels. For
+    // char, libc's memchr and memcmp are vectorized the same way, with
+    // runtime dispatch, and are inlined or unrolled better for short
+    // strings, so they are used instead.
+    template <class CharT>
+    inline const CharT* __char_find(const CharT* first, const CharT* last, CharT c) {
+        return tinySTL::__simd_find(first, last, c);
+    }
+
+    inline const char* __char_find(const char* first, const char* last, char c) {
+        const void* p = first == last ? nullptr : std::memchr(first, c, size_t(last - first));
+        return p ? static_cast<const char*>(p) : last;
+    }
+
+    template <class CharT>
+    inline bool __char_equal(const CharT* a, const CharT* b, size_t n) {
+        return n == 0 || tinySTL::__simd_mismatch(a, n, b) == n;
+    }
+
+    inline bool __char_equal(const char* a, const char* b, size_t n) {
+        return n == 0 || std::memcmp(a, b, n) == 0;
+    }
+
+    template <class CharT>
+    inline int __char_compare(const CharT* a, size_t n, const CharT* b, size_t m) {
+        const size_t len = n < m ? n : m;
+        const size_t i = len ? tinySTL::__simd_mismatch(a, len, b) : 0;
+        if (i < len) {
+            return tinySTL::__char_less(a[i], b[i]) ? -1 : 1;
+        }
+        return n < m ? -1 : (m < n ? 1 : 0);
+    }
+
+    // memcmp compares as unsigned char, which is the order __char_less gives.
+    inline int __char_compare(const char* a, size_t n, const char* b, size_t m) {
+        const int r = n < m ? (n ? std::memcmp(a, b, n) : 0) : (m ? std::memcmp(a, b, m) : 0);
+        if (r != 0) {
+            return r < 0 ? -1 : 1;
+        }
+        return n < m ? -1 : (m < n ? 1 : 0);
+    }
+
+    // Scans for the needle's first character and checks each hit against the
+    // rest. Returns the offset into s, or n.
+    template <class CharT>
+    size_t __char_search(const CharT* s, size_t n, const CharT* p, size_t m, size_t pos) {
+        if (m == 0) {
+            return pos <= n ? pos : n;
+        }
+        if (pos >= n || n - pos < m) {
+            return n;
+        }
+        const CharT* const last = s + (n - m + 1);
+        for (const CharT* cur = s + pos; ; ++cur) {
+            cur = tinySTL::__char_find(cur, last, p[0]);
+            if (cur == last) {
+                return n;
+            }
+            if (tinySTL::__char_equal(cur + 1, p + 1, m - 1)) {
+                return size_t(cur - s);
+            }
+        }
+    }
+
+    inline uint64_t __hash_read64(const unsigned char* p) {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    inline uint64_t __hash_read32(const unsigned char* p) {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    }
+
+    // The 128-bit product of a and b, folded to 64 bits.
+    inline uint64_t __hash_mum(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+        const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+        return uint64_t(r) ^ uint64_t(r >> 64);
+#else
+        const uint64_t lo = a * b;
+        const uint64_t hi = (a >> 32) * (b >> 32) + (((a >> 32) * (b & 0xffffffffu)) >> 32)
+                          + (((a & 0xffffffffu) * (b >> 32)) >> 32);
+        return lo ^ hi;
+#endif
+    }
+
+    // A multiply-fold hash in the manner of wyhash: 16 bytes per multiply in
+    // the loop, and short keys, which are most map keys, take a single
+    // multiply after reading their ends with possibly overlapping loads.
+    inline size_t __hash_bytes(const void* data, size_t n) {
+        const uint64_t k0 = 0xa0761d6478bd642full;
+        const uint64_t k1 = 0xe7037ed1a0b428dbull;
+        const uint64_t k2 = 0x8ebc6af09c88c6e3ull;
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        uint64_t seed = k0 ^ uint64_t(n);
+        size_t left = n;
+        for (; left > 16; p += 16, left -= 16) {
+            seed = tinySTL::__hash_mum(tinySTL::__hash_read64(p) ^ k1, tinySTL::__hash_read64(p + 8) ^ seed);
+        }
+        uint64_t a = 0;
+        uint64_t b = 0;
+        if (left > 8) {
+            a = tinySTL::__hash_read64(p);
+            b = tinySTL::__hash_read64(p + left - 8);
+        }
+        else if (left >= 4) {
+            a = tinySTL::__hash_read32(p);
+            b = tinySTL::__hash_read32(p + left - 4);
+        }
+        else if (left > 0) {
+            a = (uint64_t(p[0]) << 16) | (uint64_t(p[left >> 1]) << 8) | p[left - 1];
+        }
+        return size_t(tinySTL::__hash_mum(k1 ^ uint64_t(n), tinySTL::__hash_mum(a ^ k1, b ^ seed) ^ k2));
+    }
+
+    // A non-owning view of a character sequence. It is two words, cheap to
+    // pass by value, and does not keep what it views alive.
+    template <class CharT>
+    class basic_string_view {
+    public:
+        typedef CharT               value_type;
+        typedef const CharT*        pointer;
+        typedef const CharT*        const_pointer;
+        typedef const CharT&        reference;
+        typedef const CharT&        const_reference;
+        typedef const CharT*        iterator;
+        typedef const CharT*        const_iterator;
+        typedef size_t              size_type;
+        typedef ptrdiff_t           difference_type;
+
+        static constexpr size_type npos = size_type(-1);
+
+    protected:
+        const CharT* str;
+        size_type len;
+
+    public:
+        constexpr basic_string_view() : str(nullptr), len(0) {}
+        constexpr basic_string_view(const CharT* s, size_type n) : str(s), len(n) {}
+        basic_string_view(const CharT* s) : str(s), len(tinySTL::__char_length(s)) {}
+
+        constexpr const_iterator begin() const { return str; }
+        constexpr const_iterator end() const { return str + len; }
+        constexpr const_pointer data() const { return str; }
+        constexpr size_type size() const { return len; }
+        constexpr size_type length() const { return len; }
+        constexpr bool empty() const { return len == 0; }
+        constexpr const_reference operator[](size_type n) const { return str[n]; }
+        constexpr const_reference front() const { return str[0]; }
+        constexpr const_reference back() const { return str[len - 1]; }
+
+        const_reference at(size_type n) const {
+            if (n >= len) {
+                throw std::out_of_range("basic_string_view::at");
+            }
+            return str[n];
+        }
+
+        void remove_prefix(size_type n) { str += n; len -= n; }
+        void remove_suffix(size_type n) { len -= n; }
+
+        basic_string_view substr(size_type pos, size_type n = npos) const {
+            if (pos > len) {
+                throw std::out_of_range("basic_string_view::substr");
+            }
+            return basic_string_view(str + pos, n < len - pos ? n : len - pos);
+        }
+
+        int compare(basic_string_view x) const { return tinySTL::__char_compare(str, len, x.str, x.len); }
+
+        bool starts_with(basic_string_view x) const {
+            return x.len <= len && tinySTL::__char_equal(str, x.str, x.len);
+        }
+
+        bool ends_with(basic_string_view x) const {
+            return x.len <= len && tinySTL::__char_equal(str + len - x.len, x.str, x.len);
+        }
+
+        size_type find(CharT c, size_type pos = 0) const {
+            if (pos >= len) {
+                return npos;
+            }
+            const CharT* p = tinySTL::__char_find(str + pos, str + len, c);
+            return p == str + len ? npos : size_type(p - str);
+        }
+
+        size_type find(basic_string_view x, size_type pos = 0) const {
+            const size_type i = tinySTL::__char_search(str, len, x.str, x.len, pos);
+            return i == len && !(x.len == 0 && pos == len) ? npos : i;
+        }
+
+        size_type rfind(CharT c, size_type pos = npos) const {
+            for (size_type i = (pos < len ? pos + 1 : len); i-- > 0; ) {
+                if (str[i] == c) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+
+        bool contains(basic_string_view x) const { return find(x) != npos; }
+        bool contains(CharT c) const { return find(c) != npos; }
+    };
+
+    template <class CharT>
+    constexpr typename basic_string_view<CharT>::size_type basic_string_view<CharT>::npos;
+
+    typedef basic_string_view<char> string_view;
+
+    template <class CharT>
+    class basic_string;
+
+    // The character type of the string types; the comparison operators below
+    // apply when either side is one, and compare through views.
+    template <class T>
+    struct __string_char { typedef void type; };
+
+    template <class CharT>
+    struct __string_char<basic_string_view<CharT>> { typedef CharT type; };
+
+    template <class CharT>
+    struct __string_char<basic_string<CharT>> { typedef CharT type; };
+
+    template <class A, class B, class CharT>
+    struct __string_comparable_with : std::integral_constant<bool,
+        std::is_convertible<const A&, basic_string_view<CharT>>::value
+        && std::is_convertible<const B&, basic_string_view<CharT>>::value> {
+        typedef basic_string_view<CharT> view;
+    };
+
+    template <class A, class B>
+    struct __string_comparable_with<A, B, void> : std::false_type {};
+
+    template <class A, class B>
+    struct __string_comparable : __string_comparable_with<A, B,
+        typename std::conditional<std::is_void<typename __string_char<A>::type>::value,
+                                  typename __string_char<B>::type,
+                                  typename __string_char<A>::type>::type> {};
+
+    template <class A, class B>
+    inline typename std::enable_if<__string_comparable<A, B>::value, bool>::type
+    operator==(const A& a, const B& b) {
+        typedef typename __string_comparable<A, B>::view view;
+        const view x(a);
+        const view y(b);
+        return x.size() == y.size() && tinySTL::__char_equal(x.data(), y.data(), x.size());
+    }
+
+    template <class A, class B>
+    inline typename std::enable_if<__string_comparable<A, B>::value, bool>::type
+    operator!=(const A& a, const B& b) { return !(a == b); }
+
+    template <class A, class B>
+    inline typename std::enable_if<__string_comparable<A, B>::value, bool>::type
+    operator<(const A& a, const B& b) {
+        typedef typename __string_comparable<A, B>::view view;
+        return view(a).compare(view(b)) < 0;
+    }
+
+    template <class A, class B>
+    inline typename std::enable_if<__string_comparable<A, B>::value, bool>::type
+    operator>(const A& a, const B& b) { return b < a; }
+
+    template <class A, class B>
+    inline typename std::enable_if<__string_comparable<A, B>::value, bool>::type
+    operator<=(const A& a, const B& b) { return !(b < a); }
+
+    template <class A, class B>
+    inline typename std::enable_if<__string_comparable<A, B>::value, bool>::type
+    operator>=(const A& a, const B& b) { return !(a < b); }
+
+    template <class CharT>
+    struct hash<basic_string_view<CharT>> {
+        typedef basic_string_view<CharT>    argument_type;
+        typedef size_t                      result_type;
+
+        size_t operator()(basic_string_view<CharT> x) const {
+            return tinySTL::__hash_bytes(x.data(), x.size() * sizeof(CharT));
+        }
+    };
+}
+
+#endif // _TINY_STRING_VIEW_H_
@@ -0,0 +1,89 @@
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "../concurrent_unordered_map.h"
+#include "../execution.h"
+#include "../vector.h"
+
+namespace {
+    int failures = 0;
+
+    void check(bool ok, const char* what, uint64_t key) {
+        if (!ok && failures++ < 10) {
+            std::fprintf(stderr, "FAIL: %s (key %llu)\n", what, (unsigned long long)key);
+        }
+    }
+
+    // Each thread owns the keys congruent to it modulo threads, so the
+    // final contents are known. Every key is inserted, every third one
+    // erased and put back with a new value, and every fifth erased for
+    // good, while all threads also look up each other's keys. The map
+    // starts at the minimum size, so the writers race through every resize.
+    void run(unsigned threads, uint64_t keys) {
+        tinySTL::concurrent_unordered_map<uint64_t, uint64_t> m;
+        std::atomic<bool> go(false);
+        tinySTL::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.push_back(std::thread([&m, &go, t, threads, keys]() {
+                while (!go.load()) {
+                    std::this_thread::yield();
+                }
+                uint64_t seen = 0;
+                for (uint64_t k = t; k < keys; k += threads) {
+                    m.insert(std::make_pair(k, k));
+                    if (k % 3 == 0) {
+                        m.erase(k);
+                        m.insert_or_assign(k, k + 1);
+                    }
+                    if (k % 5 == 0) {
+                        m.erase(k);
+                    }
+                    uint64_t v;
+                    seen += m.find((k * 7919) % keys, v);
+                }
+                (void)seen;
+            }));
+        }
+        go.store(true);
+        for (size_t i = 0; i < workers.size(); ++i) {
+            workers[i].join();
+        }
+
+        uint64_t expected = 0;
+        for (uint64_t k = 0; k < keys; ++k) {
+            uint64_t v = 0;
+            const bool found = m.find(k, v);
+            if (k % 5 == 0) {
+                check(!found, "erased key found", k);
+                continue;
+            }
+            ++expected;
+            check(found, "key missing", k);
+            check(!found || v == (k % 3 == 0 ? k + 1 : k), "wrong value", k);
+        }
+        check(m.size() == expected, "size", m.size());
+        uint64_t visited = 0;
+        m.for_each([&visited](const std::pair<const uint64_t, uint64_t>&) { ++visited; });
+        check(visited == expected, "for_each count", visited);
+    }
+}
+
+// Usage: concurrent_unordered_map_stress [rounds] [keys]
+// Runs more writer threads than there are hardware threads, so writers are
+// preempted in the middle of moving entries between tables.
+int main(int argc, char** argv) {
+    const int rounds = argc > 1 ? std::atoi(argv[1]) : 20;
+    const uint64_t keys = argc > 2 ? std::strtoull(argv[2], 0, 10) : 20000;
+    const unsigned threads = 4 * tinySTL::hardware_concurrency() < 8 ? 8 : 4 * tinySTL::hardware_concurrency();
+    for (int r = 0; r < rounds; ++r) {
+        run(threads, keys);
+    }
+    if (failures) {
+        std::fprintf(stderr, "%d failures\n", failures);
+        return 1;
+    }
+    std::printf("ok: %d rounds, %u threads, %llu keys\n", rounds, threads, (unsigned long long)keys);
+    return 0;
+}
@@ -0,0 +1,83 @@
+#ifndef _TINY_TOP_K_H_
+#define _TINY_TOP_K_H_
+
+#include <cstddef>
+#include <utility>
+#include "algorithm.h"
+#include "functional.h"
+#include "heap.h"
+#include "vector.h"
+
+namespace tinySTL {
+    // Streaming selection of the k values that come first in Compare order:
+    // the default keeps the k smallest, greater<T> the k largest. The values
+    // are held in a heap of at most k elements whose top is the worst one
+    // kept, so a value that doesn't make the cut costs one comparison and is
+    // never copied. Memory stays O(k) however long the input is.
+    template <class T, class Compare = less<T>, size_t Arity = 4>
+    class top_k {
+    public:
+        typedef T                                   value_type;
+        typedef Compare                             value_compare;
+        typedef typename vector<T>::size_type       size_type;
+        typedef typename vector<T>::const_iterator  const_iterator;
+
+    protected:
+        vector<T> c;
+        size_type limit;
+        Compare comp;
+
+        template <class U>
+        void push_value(U&& x) {
+            if (c.size() < limit) {
+                c.push_back(std::forward<U>(x));
+                tinySTL::push_heap<Arity>(c.begin(), c.end(), comp);
+            }
+            else if (limit != 0 && comp(x, c.front())) {
+                tinySTL::__sift_down<Arity>(c.begin(), ptrdiff_t(0), ptrdiff_t(c.size()), T(std::forward<U>(x)), comp);
+            }
+        }
+
+    public:
+        explicit top_k(size_type k, const Compare& x = Compare()) : c(), limit(k), comp(x) { c.reserve(k); }
+
+        size_type k() const { return limit; }
+        size_type size() const { return c.size(); }
+        bool empty() const { return c.empty(); }
+        bool full() const { return c.size() == limit; }
+
+        // The worst value kept: once full(), a value has to order before this
+        // to get in. Requires !empty().
+        const value_type& threshold() const { return *c.begin(); }
+
+        void push(const value_type& x) { push_value(x); }
+        void push(value_type&& x) { push_value(std::move(x)); }
+
+        template <class InputIterator>
+        void push(InputIterator first, InputIterator last) {
+            for (; first != last; ++first) {
+                push_value(*first);
+            }
+        }
+
+        // The kept values in heap order.
+        const_iterator begin() const { return c.begin(); }
+        const_iterator end() const { return c.end(); }
+
+        // The kept values in Compare order; the accumulator is left empty.
+        vector<T> extract_sorted() {
+            tinySTL::sort_heap<Arity>(c.begin(), c.end(), comp);
+            return vector<T>(std::move(c));
+        }
+
+        void clear() { c.clear(); }
+
+        void swap(top_k& x) {
+            tinySTL::swap(c, x.c);
+            tinySTL::swap(limit, x.limit);
+            tinySTL::swap(comp, x.comp);
+        }
+    };
+}
+
+#endif // _TINY_TOP_K_H_
@@ -0,0 +1,139 @@
+#ifndef _TINY_UNORDERED_MAP_H_
+#define _TINY_UNORDERED_MAP_H_
+
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "functional.h"
+#include "hashtable.h"
+
+namespace tinySTL {
+    // Entries live directly in the table's slot array, so inserting never
+    // allocates a node; iterators and references are invalidated by growth.
+    template <class Key, class T, class Hash = hash<Key>, class KeyEqual = equal_to<Key>>
+    class unordered_map {
+    public:
+        typedef Key                             key_type;
+        typedef T                               mapped_type;
+        typedef std::pair<const Key, T>         value_type;
+        typedef Hash                            hasher;
+        typedef KeyEqual                        key_equal;
+
+    private:
+        typedef __hashtable<value_type, Key, select1st<value_type>, Hash, KeyEqual> rep_type;
+        rep_type t;
+
+        template <class K>
+        struct transparent : std::enable_if<__hash_is_transparent<Hash, KeyEqual>::value, K> {};
+
+    public:
+        typedef typename rep_type::size_type        size_type;
+        typedef typename rep_type::difference_type  difference_type;
+        typedef typename rep_type::iterator         iterator;
+        typedef typename rep_type::const_iterator   const_iterator;
+
+        unordered_map() : t() {}
+
+        explicit unordered_map(size_type n, const Hash& hf = Hash(), const KeyEqual& eq = KeyEqual())
+            : t(n, hf, eq) {}
+
+        template <class InputIterator>
+        unordered_map(InputIterator first, InputIterator last, size_type n = 0,
+                      const Hash& hf = Hash(), const KeyEqual& eq = KeyEqual())
+            : t(n, hf, eq) {
+            insert(first, last);
+        }
+
+        iterator begin() const { return t.begin(); }
+        iterator end() const { return t.end(); }
+        size_type size() const { return t.size(); }
+        bool empty() const { return t.empty(); }
+        size_type bucket_count() const { return t.bucket_count(); }
+        float load_factor() const { return t.load_factor(); }
+        float max_load_factor() const { return t.max_load_factor(); }
+        hasher hash_function() const { return t.hash_function(); }
+        key_equal key_eq() const { return t.key_eq(); }
+
+        void reserve(size_type n) { t.reserve(n); }
+        void rehash(size_type n) { t.rehash(n); }
+        void clear() { t.clear(); }
+
+        iterator find(const key_type& k) const { return t.find(k); }
+        size_type count(const key_type& k) const { return t.count_of(k); }
+        bool contains(const key_type& k) const { return t.count_of(k) != 0; }
+
+        std::pair<iterator, iterator> equal_range(const key_type& k) const {
+            return t.equal_range(k);
+        }
+
+        template <class K, class = typename transparent<K>::type>
+        iterator find(const K& k) const { return t.find(k); }
+
+        template <class K, class = typename transparent<K>::type>
+        size_type count(const K& k) const { return t.count_of(k); }
+
+        template <class K, class = typename transparent<K>::type>
+        bool contains(const K& k) const { return t.count_of(k) != 0; }
+
+        template <class K, class = typename transparent<K>::type>
+        std::pair<iterator, iterator> equal_range(const K& k) const { return t.equal_range(k); }
+
+        T& at(const key_type& k) {
+            iterator it = t.find(k);
+            if (it == t.end()) {
+                throw std::out_of_range("unordered_map::at");
+            }
+            return it->second;
+        }
+
+        const T& at(const key_type& k) const {
+            const_iterator it = t.find(k);
+            if (it == t.end()) {
+                throw std::out_of_range("unordered_map::at");
+            }
+            return it->second;
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(const key_type& k, Args&&... args) {
+            return t.emplace_key(k, std::piecewise_construct, std::forward_as_tuple(k),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        // k is only moved from once the lookup has missed.
+        template <class... Args>
+        std::pair<iterator, bool> try_emplace(key_type&& k, Args&&... args) {
+            return t.emplace_key(k, std::piecewise_construct, std::forward_as_tuple(std::move(k)),
+                                 std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+
+        T& operator[](const key_type& k) { return try_emplace(k).first->second; }
+        T& operator[](key_type&& k) { return try_emplace(std::move(k)).first->second; }
+
+        std::pair<iterator, bool> insert(const value_type& x) { return t.emplace_key(x.first, x); }
+        std::pair<iterator, bool> insert(value_type&& x) { return t.emplace_key(x.first, std::move(x)); }
+
+        template <class InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            for (; first != last; ++first) {
+                t.emplace_key((*first).first, *first);
+            }
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args&&... args) {
+            return t.emplace(std::forward<Args>(args)...);
+        }
+
+        iterator erase(const_iterator position) { return t.erase(position); }
+        size_type erase(const key_type& k) { return t.erase_key(k); }
+
+        template <class K, class = typename transparent<K>::type>
+        size_type erase(const K& k) { return t.erase_key(k); }
+
+        void swap(unordered_map& x) { t.swap(x.t); }
+    };
+}
+
+#endif // _TINY_UNORDERED_MAP_H_
@@ -0,0 +1,100 @@
+#ifndef _TINY_UNORDERED_SET_H_
+#define _TINY_UNORDERED_SET_H_
+
+#include <type_traits>
+#include <utility>
+#include "functional.h"
+#include "hashtable.h"
+
+namespace tinySTL {
+    template <class Value, class Hash = hash<Value>, class KeyEqual = equal_to<Value>>
+    class unordered_set {
+    private:
+        typedef __hashtable<Value, Value, identity<Value>, Hash, KeyEqual> rep_type;
+        rep_type t;
+
+        template <class K>
+        struct transparent : std::enable_if<__hash_is_transparent<Hash, KeyEqual>::value, K> {};
+
+    public:
+        typedef Value                               key_type;
+        typedef Value                               value_type;
+        typedef Hash                                hasher;
+        typedef KeyEqual                            key_equal;
+        typedef typename rep_type::size_type        size_type;
+        typedef typename rep_type::difference_type  difference_type;
+        typedef typename rep_type::const_iterator   iterator;
+        typedef typename rep_type::const_iterator   const_iterator;
+
+        unordered_set() : t() {}
+
+        explicit unordered_set(size_type n, const Hash& hf = Hash(), const KeyEqual& eq = KeyEqual())
+            : t(n, hf, eq) {}
+
+        template <class InputIterator>
+        unordered_set(InputIterator first, InputIterator last, size_type n = 0,
+                      const Hash& hf = Hash(), const KeyEqual& eq = KeyEqual())
+            : t(n, hf, eq) {
+            insert(first, last);
+        }
+
+        iterator begin() const { return t.begin(); }
+        iterator end() const { return t.end(); }
+        size_type size() const { return t.size(); }
+        bool empty() const { return t.empty(); }
+        size_type bucket_count() const { return t.bucket_count(); }
+        float load_factor() const { return t.load_factor(); }
+        float max_load_factor() const { return t.max_load_factor(); }
+        hasher hash_function() const { return t.hash_function(); }
+        key_equal key_eq() const { return t.key_eq(); }
+
+        void reserve(size_type n) { t.reserve(n); }
+        void rehash(size_type n) { t.rehash(n); }
+        void clear() { t.clear(); }
+
+        iterator find(const key_type& k) const { return t.find(k); }
+        size_type count(const key_type& k) const { return t.count_of(k); }
+        bool contains(const key_type& k) const { return t.count_of(k) != 0; }
+
+        std::pair<iterator, iterator> equal_range(const key_type& k) const {
+            return t.equal_range(k);
+        }
+
+        template <class K, class = typename transparent<K>::type>
+        iterator find(const K& k) const { return t.find(k); }
+
+        template <class K, class = typename transparent<K>::type>
+        size_type count(const K& k) const { return t.count_of(k); }
+
+        template <class K, class = typename transparent<K>::type>
+        bool contains(const K& k) const { return t.count_of(k) != 0; }
+
+        template <class K, class = typename transparent<K>::type>
+        std::pair<iterator, iterator> equal_range(const K& k) const { return t.equal_range(k); }
+
+        std::pair<iterator, bool> insert(const value_type& x) { return t.emplace_key(x, x); }
+        std::pair<iterator, bool> insert(value_type&& x) { return t.emplace_key(x, std::move(x)); }
+
+        template <class InputIterator>
+        void insert(InputIterator first, InputIterator last) {
+            for (; first != last; ++first) {
+                t.emplace_key(*first, *first);
+            }
+        }
+
+        template <class... Args>
+        std::pair<iterator, bool> emplace(Args&&... args) {
+            return t.emplace(std::forward<Args>(args)...);
+        }
+
+        iterator erase(const_iterator position) { return t.erase(position); }
+        size_type erase(const key_type& k) { return t.erase_key(k); }
+
+        template <class K, class = typename transparent<K>::type>
+        size_type erase(const K& k) { return t.erase_key(k); }
+
+        void swap(unordered_set& x) { t.swap(x.t); }
+    };
+}
+
+#endif // _TINY_UNORDERED_SET_H_
@@ -1,6 +1,8 @@
 #ifndef _TINY_VECTOR_H_
 #define _TINY_VECTOR_H_
 
+#include <new>
+#include <utility>
 #include "allocator.h"
 #include "iterator.h"
 #include "algorithm.h"
@@ -42,10 +44,12 @@ namespace tinySTL {
         iterator end() const { return finish; }
         size_type size() const { return size_type(finish - start); }
         size_type capacity() const { return size_type(end_of_storage - start); }
-        bool empty() { return start == finish; }
+        bool empty() const { return start == finish; }
         reference operator[](size_type n) { return *(start + n); }
+        const_reference operator[](size_type n) const { return *(start + n); }
         reference front() { return *start; }
         reference back() { return *(finish - 1); }
+        const_reference back() const { return *(finish - 1); }
 
         vector() { start = finish = end_of_storage = nullptr; }
         vector(size_type n, const value_type& value) { fill_initialize(n, value); }
@@ -54,10 +58,20 @@ namespace tinySTL {
         explicit vector(size_type n) { fill_initialize(n, value_type()); }
         ~vector() { data_allocator::destroy(start, finish); deallocate(); }
 
-        void push_back(const value_type& x);
+        void push_back(const value_type& x) { emplace_back(x); }
+        void push_back(value_type&& x) { emplace_back(std::move(x)); }
+        template <class... Args>
+        void emplace_back(Args&&... args);
+        template <class... Args>
+        iterator emplace(iterator position, Args&&... args);
+        iterator insert(iterator position, const value_type& x) { return emplace(position, x); }
+        iterator insert(iterator position, value_type&& x) { return emplace(position, std::move(x)); }
         void pop_back();
         void erase(iterator position);
+        iterator erase(iterator first, iterator last);
+        void reserve(size_type n);
         void resize(size_type new_size, const value_type& x);
+        void resize_default_init(size_type new_size);
         void clear();
 
         vector& operator=(const vector& x);
@@ -86,7 +100,7 @@ namespace tinySTL {
     typename vector<T, Alloc>::iterator vector<T, Alloc>::allocate_and_fill(size_type n, const value_type& value)
     {
         iterator result = data_allocator::allocate(n);
-        uninitialized_fill_n(result, n, value);
+        tinySTL::uninitialized_fill_n(result, n, value);
         return result;
     }
 
@@ -94,7 +108,7 @@ namespace tinySTL {
     typename vector<T, Alloc>::iterator vector<T, Alloc>::allocate_and_copy(size_type n, const_iterator first, const_iterator last)
     {
         iterator result = data_allocator::allocate(n);
-        uninitialized_copy(first, last, result);
+        tinySTL::uninitialized_copy(first, last, result);
         return result;
     }
 
@@ -107,10 +121,11 @@ namespace tinySTL {
     }
 
     template <class T, class Alloc>
-    void vector<T, Alloc>::push_back(const value_type& x)
+    template <class... Args>
+    void vector<T, Alloc>::emplace_back(Args&&... args)
     {
         if (finish != end_of_storage) {
-            data_allocator::construct(finish, x);
+            ::new (static_cast<void*>(finish)) value_type(std::forward<Args>(args)...);
             ++finish;
         }
         else {
@@ -119,20 +134,79 @@ namespace tinySTL {
             iterator new_start = data_allocator::allocate(new_size);
             iterator new_finish = new_start;
             try {
-                new_finish = uninitialized_copy(start, finish, new_start);
-                data_allocator::construct(new_finish, x);
+                ::new (static_cast<void*>(new_start + old_size)) value_type(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                data_allocator::deallocate(new_start, new_size);
+                throw;
+            }
+            try {
+                new_finish = tinySTL::__uninitialized_relocate(start, finish, new_start);
                 ++new_finish;
             }
             catch (...) {
+                data_allocator::destroy(new_start + old_size);
                 data_allocator::deallocate(new_start, new_size);
                 throw;
             }
-            data_allocator::destroy(start, finish);
+            tinySTL::__destroy_relocated(start, finish);
+            deallocate();
+            start = new_start;
+            finish = new_finish;
+            end_of_storage = start + new_size;
+        }
+    }
+
+    template <class T, class Alloc>
+    template <class... Args>
+    typename vector<T, Alloc>::iterator vector<T, Alloc>::emplace(iterator position, Args&&... args)
+    {
+        const size_type index = size_type(position - start);
+        if (position == finish) {
+            emplace_back(std::forward<Args>(args)...);
+        }
+        else if (finish != end_of_storage) {
+            // Build the value first: args may refer to an element that is about to move.
+            value_type x(std::forward<Args>(args)...);
+            tinySTL::construct(finish, std::move(*(finish - 1)));
+            ++finish;
+            tinySTL::move_backward(position, finish - 2, finish - 1);
+            *position = std::move(x);
+        }
+        else {
+            const size_type old_size = size();
+            const size_type new_size = 2 * old_size;
+            iterator new_start = data_allocator::allocate(new_size);
+            iterator new_finish = new_start;
+            try {
+                ::new (static_cast<void*>(new_start + index)) value_type(std::forward<Args>(args)...);
+            }
+            catch (...) {
+                data_allocator::deallocate(new_start, new_size);
+                throw;
+            }
+            try {
+                new_finish = tinySTL::__uninitialized_relocate(start, position, new_start);
+                ++new_finish;
+                new_finish = tinySTL::__uninitialized_relocate(position, finish, new_finish);
+            }
+            catch (...) {
+                if (new_finish == new_start) {
+                    data_allocator::destroy(new_start + index);
+                }
+                else {
+                    data_allocator::destroy(new_start, new_start + index + 1);
+                }
+                data_allocator::deallocate(new_start, new_size);
+                throw;
+            }
+            tinySTL::__destroy_relocated(start, finish);
             deallocate();
             start = new_start;
             finish = new_finish;
             end_of_storage = start + new_size;
         }
+        return start + index;
     }
 
     template <class T, class Alloc>
@@ -146,12 +220,44 @@ namespace tinySTL {
     void vector<T, Alloc>::erase(iterator position)
     {
         if (position + 1 != finish) {
-            copy(position + 1, finish, position);
+            tinySTL::move(position + 1, finish, position);
         }
         data_allocator::destroy(finish - 1);
         --finish;
     }
 
+    template <class T, class Alloc>
+    typename vector<T, Alloc>::iterator vector<T, Alloc>::erase(iterator first, iterator last)
+    {
+        if (first != last) {
+            iterator new_finish = tinySTL::move(last, finish, first);
+            data_allocator::destroy(new_finish, finish);
+            finish = new_finish;
+        }
+        return first;
+    }
+
+    template <class T, class Alloc>
+    void vector<T, Alloc>::reserve(size_type n)
+    {
+        if (n > capacity()) {
+            iterator new_start = data_allocator::allocate(n);
+            iterator new_finish = new_start;
+            try {
+                new_finish = tinySTL::__uninitialized_relocate(start, finish, new_start);
+            }
+            catch (...) {
+                data_allocator::deallocate(new_start, n);
+                throw;
+            }
+            tinySTL::__destroy_relocated(start, finish);
+            deallocate();
+            start = new_start;
+            finish = new_finish;
+            end_of_storage = start + n;
+        }
+    }
+
     template <class T, class Alloc>
     void vector<T, Alloc>::resize(size_type new_size, const value_type& x)
     {
@@ -165,7 +271,7 @@ namespace tinySTL {
                 iterator new_start = data_allocator::allocate(new_capacity);
                 iterator new_finish = new_start;
                 try {
-                    new_finish = uninitialized_copy(start, start + new_size, new_start);
+                    new_finish = tinySTL::uninitialized_copy(start, start + new_size, new_start);
                 }
                 catch (...) {
                     data_allocator::deallocate(new_start, new_capacity);
@@ -178,11 +284,22 @@ namespace tinySTL {
                 end_of_storage = start + new_capacity;
             }
             else {
-                uninitialized_fill_n(finish, new_size - size(), x);
+                tinySTL::uninitialized_fill_n(finish, new_size - size(), x);
             }
         }
     }
 
+    // Sets the size without constructing new elements, for trivially copyable
+    // T that the caller fills in right after, as a read() would. Growth
+    // allocates exactly new_size.
+    template <class T, class Alloc>
+    void vector<T, Alloc>::resize_default_init(size_type new_size)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "resize_default_init leaves elements unconstructed");
+        reserve(new_size);
+        finish = start + new_size;
+    }
+
     template <class T, class Alloc>
     void vector<T, Alloc>::clear()
     {
@@ -204,8 +321,8 @@ namespace tinySTL {
                 data_allocator::destroy(i, finish);
             }
             else {
-                copy(x.start, x.start + size(), start);
-                uninitialized_copy(x.start + size(), x.finish, finish);
+                tinySTL::copy(x.start, x.start + size(), start);
+                tinySTL::uninitialized_copy(x.start + size(), x.finish, finish);
             }
             finish = start + x_size;
         }